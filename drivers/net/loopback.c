@@ -104,6 +104,92 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	k_timepoint_t due;
+};
+
+static struct loopback_delayed_pkt
+	loopback_delay_queue[CONFIG_NET_LOOPBACK_SIMULATE_DELAY_QUEUE_SIZE];
+static uint16_t loopback_delay_head;
+static uint16_t loopback_delay_count;
+static uint32_t loopback_delay_ms;
+static struct k_spinlock loopback_delay_lock;
+
+static void loopback_delay_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_work_handler);
+
+int loopback_set_delay(uint32_t delay_ms)
+{
+	loopback_delay_ms = delay_ms;
+	return 0;
+}
+
+/* Deliver the packets whose delay has elapsed, in the order they were sent */
+static void loopback_delay_work_handler(struct k_work *work)
+{
+	struct net_pkt *pkt;
+	k_spinlock_key_t key;
+	k_timeout_t next;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delay_count == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			return;
+		}
+
+		if (!sys_timepoint_expired(loopback_delay_queue[loopback_delay_head].due)) {
+			next = sys_timepoint_timeout(loopback_delay_queue[loopback_delay_head].due);
+			k_spin_unlock(&loopback_delay_lock, key);
+			k_work_reschedule(&loopback_delay_work, next);
+			return;
+		}
+
+		pkt = loopback_delay_queue[loopback_delay_head].pkt;
+		loopback_delay_head = (loopback_delay_head + 1) %
+				      ARRAY_SIZE(loopback_delay_queue);
+		loopback_delay_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+/* Hold back the packet, drop it if too many packets are in flight */
+static void loopback_delay_pkt(struct net_pkt *pkt)
+{
+	k_spinlock_key_t key = k_spin_lock(&loopback_delay_lock);
+	uint16_t tail;
+
+	if (loopback_delay_count == ARRAY_SIZE(loopback_delay_queue)) {
+		k_spin_unlock(&loopback_delay_lock, key);
+		LOG_DBG("Delay queue full, dropping %p", pkt);
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	tail = (loopback_delay_head + loopback_delay_count) %
+	       ARRAY_SIZE(loopback_delay_queue);
+	loopback_delay_queue[tail].pkt = pkt;
+	loopback_delay_queue[tail].due = sys_timepoint_calc(K_MSEC(loopback_delay_ms));
+	loopback_delay_count++;
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	/* Does nothing if the delivery of an earlier packet is scheduled */
+	k_work_schedule(&loopback_delay_work, K_MSEC(loopback_delay_ms));
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -160,6 +246,14 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		}
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	if (loopback_delay_ms > 0) {
+		loopback_delay_pkt(cloned);
+		res = 0;
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
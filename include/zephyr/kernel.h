@@ -23,6 +23,7 @@
 #include <zephyr/sys/mem_stats.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <zephyr/sys/mpsc_lockfree.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -73,6 +74,7 @@ struct k_thread;
 struct k_mutex;
 struct k_sem;
 struct k_msgq;
+struct k_vmsgq;
 struct k_mbox;
 struct k_pipe;
 struct k_queue;
@@ -1785,6 +1787,11 @@ struct k_timer {
 	/* timer period */
 	k_timeout_t period;
 
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* ticks by which expiry may be deferred */
+	k_ticks_t slack;
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 	/* timer status */
 	uint32_t status;
 
@@ -2101,6 +2108,26 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
 	return timer->user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set how late a timer may expire.
+ *
+ * This routine lets the expirations of @a timer be deferred by less than
+ * @a slack, so that they can be grouped with those of other timers and
+ * delayable work items tolerating the same slack onto a single system
+ * timer wakeup.  Each expiration is moved to the next multiple of
+ * @a slack since boot.  A periodic timer whose period is not a multiple of
+ * @a slack drifts by up to @a slack each period.
+ *
+ * The slack applies from the next time the timer is started.  A slack of
+ * @ref K_NO_WAIT, the default, disables deferral.
+ *
+ * @param timer Address of timer.
+ * @param slack Maximum deferral, must be relative and not @ref K_FOREVER.
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /** @} */
 
 /**
@@ -3095,6 +3122,103 @@ struct k_fifo {
 	STRUCT_SECTION_ITERABLE(k_fifo, name) = \
 		Z_FIFO_INITIALIZER(name)
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_fifo_mpsc {
+	struct mpsc q;
+	atomic_t count;
+	struct k_spinlock lock;
+	_wait_q_t wait_q;
+};
+
+#define Z_FIFO_MPSC_INITIALIZER(obj) \
+	{ \
+	.q = MPSC_INIT(obj.q), \
+	.count = ATOMIC_INIT(0), \
+	.lock = {}, \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Initialize a lock-free multi-producer, single-consumer FIFO.
+ *
+ * A k_fifo_mpsc is a reduced k_fifo for the common case of many
+ * producers (typically ISRs) feeding one consumer thread.  Producers
+ * never take a spinlock or enter the scheduler except when the FIFO
+ * goes from empty to non-empty, which is the only time the consumer
+ * can be waiting.  Only one thread may ever call k_fifo_mpsc_get() on
+ * a given FIFO, and it cannot be used with k_poll() or from user mode.
+ *
+ * @param fifo Address of the FIFO.
+ */
+void k_fifo_mpsc_init(struct k_fifo_mpsc *fifo);
+
+/**
+ * @brief Add an element to a multi-producer, single-consumer FIFO.
+ *
+ * As with k_fifo_put(), the first word of the data item is reserved
+ * for the kernel's use.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param fifo Address of the FIFO.
+ * @param data Address of the data item.
+ */
+void k_fifo_mpsc_put(struct k_fifo_mpsc *fifo, void *data);
+
+/**
+ * @brief Get an element from a multi-producer, single-consumer FIFO.
+ *
+ * Must only be called from the FIFO's single consumer.
+ *
+ * @note @p timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param fifo Address of the FIFO.
+ * @param timeout Waiting period to obtain a data item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Address of the data item if successful; NULL if returned
+ * without waiting, or waiting period timed out.
+ */
+void *k_fifo_mpsc_get(struct k_fifo_mpsc *fifo, k_timeout_t timeout);
+
+/**
+ * @brief Query a multi-producer, single-consumer FIFO for data.
+ *
+ * The answer may already be stale when this function returns.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param fifo Address of the FIFO.
+ *
+ * @return true if the FIFO is empty, false otherwise.
+ */
+static inline bool k_fifo_mpsc_is_empty(struct k_fifo_mpsc *fifo)
+{
+	return atomic_get(&fifo->count) <= 0;
+}
+
+/**
+ * @brief Statically define and initialize a multi-producer,
+ * single-consumer FIFO.
+ *
+ * The FIFO can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_fifo_mpsc <name>; @endcode
+ *
+ * @param name Name of the FIFO.
+ */
+#define K_FIFO_MPSC_DEFINE(name) \
+	struct k_fifo_mpsc name = Z_FIFO_MPSC_INITIALIZER(name)
+
 /** @} */
 
 struct k_lifo {
@@ -3382,6 +3506,16 @@ extern struct k_work_q k_sys_work_q;
  * @{
  */
 
+/**
+ * @brief Mutex contention statistics
+ */
+struct k_mutex_stats {
+	/** Number of contended locks obtained by spinning, without pending */
+	uint32_t spin_acquired;
+	/** Number of locks for which the caller had to pend */
+	uint32_t blocked;
+};
+
 /**
  * Mutex Structure
  * @ingroup mutex_apis
@@ -3403,6 +3537,11 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	/** Contention statistics */
+	struct k_mutex_stats stats;
+#endif
 };
 
 /**
@@ -3579,6 +3718,162 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @}
  */
 
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Reader-writer lock contention statistics
+ */
+struct k_rwlock_stats {
+	/** Number of read locks for which the caller had to pend */
+	uint32_t read_blocked;
+	/** Number of write locks for which the caller had to pend */
+	uint32_t write_blocked;
+};
+
+/**
+ * @brief Reader-writer lock structure
+ *
+ * This structure is used to represent a reader-writer lock.
+ * All the members are internal and should not be accessed directly.
+ */
+struct k_rwlock {
+	/**
+	 * @cond INTERNAL_HIDDEN
+	 */
+
+	/* Reader count, plus flags for a writer holding the lock and for
+	 * writers waiting for it
+	 */
+	atomic_t state;
+	struct k_thread *writer;
+	struct k_spinlock lock;
+	_wait_q_t read_wait_q;
+	_wait_q_t write_wait_q;
+
+#ifdef CONFIG_OBJ_CORE_RWLOCK
+	struct k_obj_core  obj_core;
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_RWLOCK
+	struct k_rwlock_stats stats;
+#endif
+	/** @endcond */
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_RWLOCK_INITIALIZER(obj)                                              \
+	{                                                                      \
+		.state = ATOMIC_INIT(0),                                       \
+		.writer = NULL,                                                \
+		.read_wait_q = Z_WAIT_Q_INIT(&(obj).read_wait_q),              \
+		.write_wait_q = Z_WAIT_Q_INIT(&(obj).write_wait_q),            \
+	}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * This routine initializes a reader-writer lock, prior to its first use.
+ *
+ * Upon completion, the lock is not held by any reader or writer.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock initialized.
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * Any number of threads may hold the lock for reading at the same time.
+ * The caller waits while a writer holds the lock or while a writer is
+ * waiting for it, so that a steady stream of readers cannot starve
+ * writers. When the lock is free or only held by readers, the reader
+ * count is updated with a single atomic operation.
+ *
+ * Read locks do not nest with write locks held by the same thread, and
+ * no priority inheritance is performed.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Reader-writer lock locked for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a read lock on a reader-writer lock.
+ *
+ * When the last reader releases the lock, the first waiting writer, if
+ * any, is given the lock.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Read lock released.
+ * @retval -EINVAL The lock was not held for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * The caller waits until no other thread holds the lock. Waiting writers
+ * are given the lock before any waiting reader.
+ *
+ * Write locks are not recursive and no priority inheritance is performed.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to lock the reader-writer lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Reader-writer lock locked for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a write lock on a reader-writer lock.
+ *
+ * The lock is given to the first waiting writer if there is one, and to
+ * all waiting readers otherwise.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Write lock released.
+ * @retval -EPERM The current thread does not hold the lock for writing.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The reader-writer lock can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name)                                                  \
+	STRUCT_SECTION_ITERABLE(k_rwlock, name) =                              \
+		Z_RWLOCK_INITIALIZER(name)
+/**
+ * @}
+ */
+
 /**
  * @defgroup semaphore_apis Semaphore APIs
  * @ingroup kernel_apis
@@ -3685,6 +3980,21 @@ __syscall int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
  */
 __syscall void k_sem_give(struct k_sem *sem);
 
+/**
+ * @brief Give a semaphore several times.
+ *
+ * This routine is equivalent to calling k_sem_give() @a count times, but
+ * all threads it wakes up are readied in a single pass and the scheduler
+ * is invoked at most once. Any gives not consumed by waiting threads are
+ * added to the count of @a sem, up to its maximum permitted count.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param sem Address of the semaphore.
+ * @param count Number of times to give the semaphore.
+ */
+__syscall void k_sem_give_many(struct k_sem *sem, unsigned int count);
+
 /**
  * @brief Resets a semaphore's count to zero.
  *
@@ -4063,6 +4373,45 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *cfg);
 
+/** @brief Initialize a work queue animated by several threads.
+ *
+ * This configures @p num_threads work queue threads and starts them running.
+ * Each thread takes the oldest pending item that is not already running and
+ * processes it, so items submitted to the queue may run concurrently and
+ * complete in any order.  A given work item still never runs on two threads
+ * at once, and flushing, cancelling and draining behave as with a single
+ * thread.  The function should not be re-invoked on a queue.
+ *
+ * The thread embedded in @p queue is not used, and k_work_queue_thread_get()
+ * returns the first thread of @p threads.  Work timeout monitoring is not
+ * supported and @c work_timeout_ms is ignored.
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param threads array of @p num_threads thread structures.
+ *
+ * @param stacks array of @p num_threads stacks, defined with
+ *        K_THREAD_STACK_ARRAY_DEFINE() and @p stack_size.
+ *
+ * @param num_threads number of work queue threads.
+ *
+ * @param stack_size size of each stack, as given to
+ *        K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param prio initial priority of the threads
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_start_workers(struct k_work_q *queue,
+				struct k_thread *threads,
+				k_thread_stack_t *stacks, size_t num_threads,
+				size_t stack_size, int prio,
+				const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -4147,6 +4496,27 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout);
 void k_work_init_delayable(struct k_work_delayable *dwork,
 			   k_work_handler_t handler);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/** @brief Set how late a delayable work item may be submitted.
+ *
+ * This lets the submission of a scheduled work item be deferred by less
+ * than @p slack, so that it can be grouped with other delayable work items
+ * and timers tolerating the same slack onto a single system timer wakeup.
+ * The deadline is moved to the next multiple of @p slack since boot.
+ *
+ * The slack applies from the next time the work item is scheduled.  A
+ * slack of @ref K_NO_WAIT, the default, disables deferral.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param slack maximum deferral, must be relative and not @ref K_FOREVER.
+ */
+void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+				k_timeout_t slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /**
  * @brief Get the parent delayable work structure from a work pointer.
  *
@@ -4524,6 +4894,11 @@ struct k_work_delayable {
 
 	/* The queue to which the work should be submitted. */
 	struct k_work_q *queue;
+
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks by which the submission may be deferred. */
+	k_ticks_t slack;
+#endif /* CONFIG_TIMEOUT_SLACK */
 };
 
 #define Z_WORK_DELAYABLE_INITIALIZER(work_handler) { \
@@ -4567,6 +4942,9 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	struct k_work *target;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4646,6 +5024,14 @@ struct k_work_queue_config {
 	 * an error will be logged if CONFIG_LOG is enabled.
 	 */
 	uint32_t work_timeout_ms;
+
+	/** Control whether each worker thread is pinned to a CPU.
+	 *
+	 * Only used by k_work_queue_start_workers() when
+	 * CONFIG_SCHED_CPU_MASK is enabled.  If set, worker thread @c i
+	 * only runs on CPU @c i modulo the number of CPUs.
+	 */
+	bool pin_workers;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -4679,6 +5065,22 @@ struct k_work_q {
 	struct k_work *work;
 	k_timeout_t work_timeout;
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	/* Threads that animate the work if k_work_queue_start_workers() is
+	 * used, null otherwise.  thread_id is the first of them.
+	 */
+	struct k_thread *workers;
+
+	/* Number of threads in workers. */
+	uint16_t num_workers;
+
+	/* Number of threads in workers that have not exited. */
+	uint16_t num_threads;
+
+	/* Number of threads in workers running a work item. */
+	uint16_t num_busy;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -5363,6 +5765,234 @@ static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 
 /** @} */
 
+/**
+ * @defgroup vmsgq_apis Variable-Size Message Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Variable-size message queue structure
+ *
+ * Messages are stored back to back in a ring buffer of 32-bit words, each
+ * one preceded by a header word holding its length and state.
+ * All the members are internal and should not be accessed directly.
+ */
+struct k_vmsgq {
+	/** Producers waiting for free space */
+	_wait_q_t put_wait_q;
+	/** Consumers waiting for a message */
+	_wait_q_t get_wait_q;
+	/** Lock */
+	struct k_spinlock lock;
+	/** Message buffer */
+	uint32_t *buffer;
+	/** Size of the message buffer, in words */
+	uint32_t size;
+	/** Index of the next word to allocate */
+	uint32_t wr_idx;
+	/** Index of the oldest word not freed yet */
+	uint32_t rd_idx;
+	/** Index of the next message to claim */
+	uint32_t claim_idx;
+	/** Number of words between rd_idx and wr_idx */
+	uint32_t used;
+	/** Number of words between claim_idx and wr_idx */
+	uint32_t unclaimed;
+
+#ifdef CONFIG_OBJ_CORE_VMSGQ
+	struct k_obj_core  obj_core;
+#endif
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_VMSGQ_INITIALIZER(obj, vmsgq_buffer, vmsgq_words)	\
+	{							\
+	.put_wait_q = Z_WAIT_Q_INIT(&obj.put_wait_q),		\
+	.get_wait_q = Z_WAIT_Q_INIT(&obj.get_wait_q),		\
+	.buffer = vmsgq_buffer,					\
+	.size = vmsgq_words,					\
+	.wr_idx = 0,						\
+	.rd_idx = 0,						\
+	.claim_idx = 0,						\
+	.used = 0,						\
+	.unclaimed = 0,						\
+	}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a variable-size message queue.
+ *
+ * Each message takes up its length rounded up to a multiple of 4 bytes,
+ * plus 4 bytes of header, in the queue's buffer.
+ *
+ * The message queue can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_vmsgq <name>; @endcode
+ *
+ * @param q_name Name of the message queue.
+ * @param q_buffer_size Size of the message queue's buffer (in bytes).
+ */
+#define K_VMSGQ_DEFINE(q_name, q_buffer_size)				\
+	static uint32_t __noinit						\
+		_k_vmsgq_buf_##q_name[DIV_ROUND_UP(q_buffer_size, 4)];		\
+	STRUCT_SECTION_ITERABLE(k_vmsgq, q_name) =				\
+		Z_VMSGQ_INITIALIZER(q_name, _k_vmsgq_buf_##q_name,		\
+				    DIV_ROUND_UP(q_buffer_size, 4))
+
+/**
+ * @brief Initialize a variable-size message queue.
+ *
+ * This routine initializes a variable-size message queue object, prior to
+ * its first use.
+ *
+ * The message headers are kept in the buffer, so a user mode caller must
+ * not write to it once the queue is in use. A header overwritten anyway
+ * makes the reception of that message fail with -EIO.
+ *
+ * @param vmsgq Address of the message queue.
+ * @param buffer Address of the message queue's buffer, 4-byte aligned.
+ * @param buffer_size Size of the message queue's buffer (in bytes).
+ */
+__syscall void k_vmsgq_init(struct k_vmsgq *vmsgq, void *buffer, size_t buffer_size);
+
+/**
+ * @brief Allocate a message in a variable-size message queue.
+ *
+ * This routine reserves space for a message of @a len bytes in the queue's
+ * buffer, where the caller writes it in place before making it available
+ * to consumers with k_vmsgq_commit(). Messages are received in the order
+ * they were allocated, so an allocated message holds back the messages
+ * allocated after it until it is committed. The message is 4-byte aligned.
+ *
+ * @note This routine is not available to user mode threads, which use
+ * k_vmsgq_put() instead.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param vmsgq Address of the message queue.
+ * @param len Length of the message (in bytes).
+ * @param msg Set to the address of the allocated message.
+ * @param timeout Waiting period to wait for free space, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message allocated.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EMSGSIZE Message larger than the queue's buffer.
+ */
+int k_vmsgq_alloc(struct k_vmsgq *vmsgq, size_t len, void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Make an allocated message available to consumers.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param vmsgq Address of the message queue.
+ * @param msg Address of a message returned by k_vmsgq_alloc().
+ */
+void k_vmsgq_commit(struct k_vmsgq *vmsgq, void *msg);
+
+/**
+ * @brief Claim the oldest message of a variable-size message queue.
+ *
+ * This routine returns the address of the oldest committed message, which
+ * the caller reads in place before releasing it with k_vmsgq_free().
+ * Several messages can be claimed at a time and freed in any order.
+ *
+ * @note This routine is not available to user mode threads, which use
+ * k_vmsgq_get() instead.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param vmsgq Address of the message queue.
+ * @param msg Set to the address of the claimed message.
+ * @param len Set to the length of the claimed message (in bytes).
+ * @param timeout Waiting period to wait for a message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EIO The header of the oldest message is corrupted.
+ */
+int k_vmsgq_claim(struct k_vmsgq *vmsgq, void **msg, size_t *len, k_timeout_t timeout);
+
+/**
+ * @brief Release a claimed message.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param vmsgq Address of the message queue.
+ * @param msg Address of a message returned by k_vmsgq_claim().
+ */
+void k_vmsgq_free(struct k_vmsgq *vmsgq, void *msg);
+
+/**
+ * @brief Send a message to a variable-size message queue.
+ *
+ * This routine copies @a len bytes from @a data into a new message.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param vmsgq Address of the message queue.
+ * @param data Address of the message's data.
+ * @param len Length of the message (in bytes).
+ * @param timeout Waiting period to wait for free space, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message sent.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EMSGSIZE Message larger than the queue's buffer.
+ */
+__syscall int k_vmsgq_put(struct k_vmsgq *vmsgq, const void *data, size_t len,
+			  k_timeout_t timeout);
+
+/**
+ * @brief Receive a message from a variable-size message queue.
+ *
+ * This routine copies the oldest committed message to @a data and removes
+ * it from the queue. A message longer than @a size is left in the queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param vmsgq Address of the message queue.
+ * @param data Address of the area to hold the message.
+ * @param size Size of the area to hold the message (in bytes).
+ * @param timeout Waiting period to wait for a message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Length of the message received (in bytes) on success.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EMSGSIZE The oldest message is longer than @a size.
+ * @retval -EIO The header of the oldest message is corrupted.
+ */
+__syscall int k_vmsgq_get(struct k_vmsgq *vmsgq, void *data, size_t size,
+			  k_timeout_t timeout);
+
+/**
+ * @brief Get the amount of free space in a variable-size message queue.
+ *
+ * @param vmsgq Address of the message queue.
+ *
+ * @return Number of free bytes, including message headers.
+ */
+__syscall uint32_t k_vmsgq_free_space_get(struct k_vmsgq *vmsgq);
+
+static inline uint32_t z_impl_k_vmsgq_free_space_get(struct k_vmsgq *vmsgq)
+{
+	return (vmsgq->size - vmsgq->used) * sizeof(uint32_t);
+}
+
+/** @} */
+
 /**
  * @defgroup mailbox_apis Mailbox APIs
  * @ingroup kernel_apis
@@ -5607,6 +6237,7 @@ struct k_pipe {
  * @retval -EAGAIN if no data could be written before the timeout expired
  * @retval -ECANCELED if the write was interrupted by k_pipe_reset(..)
  * @retval -EPIPE if the pipe was closed
+ * @retval -EBUSY if a write claim is outstanding on the pipe, see k_pipe_write_claim()
  */
 __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
 			   k_timeout_t timeout);
@@ -5625,6 +6256,7 @@ __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
  * @retval -EAGAIN if no data could be read before the timeout expired
  * @retval -ECANCELED if the read was interrupted by k_pipe_reset(..)
  * @retval -EPIPE if the pipe was closed
+ * @retval -EBUSY if a read claim is outstanding on the pipe, see k_pipe_read_claim()
  */
 __syscall int k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len,
 			  k_timeout_t timeout);
@@ -5649,6 +6281,131 @@ __syscall void k_pipe_reset(struct k_pipe *pipe);
  * @param pipe Address of the pipe.
  */
 __syscall void k_pipe_close(struct k_pipe *pipe);
+
+/**
+ * @brief Segment of data for k_pipe_writev()
+ */
+struct k_pipe_iovec {
+	/** Address of the segment's data */
+	const uint8_t *data;
+	/** Size of the segment (in bytes) */
+	size_t len;
+};
+
+/**
+ * @brief Write data gathered from several buffers to a pipe
+ *
+ * This routine behaves like k_pipe_write() with the concatenation of the
+ * @a iovcnt segments described by @a iov as data, without an intermediate
+ * copy. The segments are written in order and are not interleaved with
+ * data from other writers, as long as the whole data fits in the pipe's
+ * ring buffer or pending readers.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to write.
+ * @param iovcnt Number of segments in @a iov.
+ * @param timeout Waiting period to wait for the data to be written.
+ *
+ * @retval number of bytes written on success
+ * @retval -EAGAIN if no data could be written before the timeout expired
+ * @retval -ECANCELED if the write was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ * @retval -EBUSY if a write claim is outstanding on the pipe
+ */
+int k_pipe_writev(struct k_pipe *pipe, const struct k_pipe_iovec *iov, size_t iovcnt,
+		  k_timeout_t timeout);
+
+/**
+ * @brief Claim space in a pipe's ring buffer for writing in place
+ *
+ * This routine waits until the pipe's ring buffer has free space, then
+ * reserves up to @a len contiguous bytes of it and sets @a data to their
+ * address. The caller fills them and makes them available to readers with
+ * k_pipe_write_finish(). Less than @a len bytes may be claimed if the ring
+ * buffer does not have enough free space or wraps around.
+ *
+ * Only one write claim can be outstanding on a pipe at a time, and
+ * k_pipe_write() and k_pipe_writev() fail with -EBUSY until it is finished.
+ * k_pipe_reset() discards an outstanding claim.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed space.
+ * @param len Requested number of bytes to claim.
+ * @param timeout Waiting period to wait for free space.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EAGAIN if no space became available before the timeout expired
+ * @retval -ECANCELED if the wait was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ * @retval -EBUSY if a write claim is already outstanding on the pipe
+ */
+int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Finish writing in place to a pipe
+ *
+ * This routine makes the first @a len bytes claimed by k_pipe_write_claim()
+ * available to readers and releases the rest of the claim.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes written to the claimed space.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a len exceeds the claimed size
+ */
+int k_pipe_write_finish(struct k_pipe *pipe, size_t len);
+
+/**
+ * @brief Claim data in a pipe's ring buffer for reading in place
+ *
+ * This routine waits until the pipe's ring buffer holds data, then
+ * reserves up to @a len contiguous bytes of it and sets @a data to their
+ * address. The caller consumes them and releases them with
+ * k_pipe_read_finish(). Less than @a len bytes may be claimed if the ring
+ * buffer does not hold enough data or wraps around.
+ *
+ * Data is only claimed from the pipe's ring buffer, so a pipe without ring
+ * buffer can never be read this way. Only one read claim can be outstanding
+ * on a pipe at a time, and k_pipe_read() fails with -EBUSY until it is
+ * finished. k_pipe_reset() discards an outstanding claim.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param len Requested number of bytes to claim.
+ * @param timeout Waiting period to wait for data.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EAGAIN if no data became available before the timeout expired
+ * @retval -ECANCELED if the wait was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed and is empty
+ * @retval -EBUSY if a read claim is already outstanding on the pipe
+ */
+int k_pipe_read_claim(struct k_pipe *pipe, const uint8_t **data, size_t len,
+		      k_timeout_t timeout);
+
+/**
+ * @brief Finish reading in place from a pipe
+ *
+ * This routine frees the first @a len bytes claimed by k_pipe_read_claim()
+ * and leaves the rest in the pipe, to be read again.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes consumed from the claimed data.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a len exceeds the claimed size
+ */
+int k_pipe_read_finish(struct k_pipe *pipe, size_t len);
 /** @} */
 
 /**
@@ -5663,6 +6420,19 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+/* Each CPU's cache gets its own d-cache line, so that CPUs working on
+ * their own cache don't keep stealing the line from each other.  The
+ * k_mem_slab linker section is aligned to match.
+ */
+struct k_mem_slab_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+	bool bypass;
+} __aligned(CONFIG_MEM_SLAB_PER_CPU_CACHE_ALIGN);
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5670,6 +6440,10 @@ struct k_mem_slab {
 	char *free_list;
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	struct k_mem_slab_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5867,6 +6641,14 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab);
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5881,7 +6663,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	return z_mem_slab_num_used_get(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5920,7 +6706,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -52,6 +52,11 @@ struct k_mem_paging_stats_t {
 #endif /* !CONFIG_DEMAND_PAGING_ALLOW_IRQ */
 	} pagefaults;
 
+	struct {
+		/** Number of pages read ahead of page faults */
+		unsigned long			pages;
+	} prefetch;
+
 	struct {
 		/** Number of clean pages selected for eviction */
 		unsigned long			clean;
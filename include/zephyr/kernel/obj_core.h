@@ -51,6 +51,8 @@
 #define K_OBJ_TYPE_MUTEX_ID      K_OBJ_TYPE_ID_GEN("MUTX")
 /** Pipe object type */
 #define K_OBJ_TYPE_PIPE_ID       K_OBJ_TYPE_ID_GEN("PIPE")
+/** Reader-writer lock object type */
+#define K_OBJ_TYPE_RWLOCK_ID     K_OBJ_TYPE_ID_GEN("RWLK")
 /** Semaphore object type */
 #define K_OBJ_TYPE_SEM_ID        K_OBJ_TYPE_ID_GEN("SEM4")
 /** Stack object type */
@@ -59,6 +61,8 @@
 #define K_OBJ_TYPE_THREAD_ID     K_OBJ_TYPE_ID_GEN("THRD")
 /** Timer object type */
 #define K_OBJ_TYPE_TIMER_ID      K_OBJ_TYPE_ID_GEN("TIMR")
+/** Variable-size message queue object type */
+#define K_OBJ_TYPE_VMSGQ_ID      K_OBJ_TYPE_ID_GEN("VMSQ")
 
 struct k_obj_type;
 struct k_obj_core;
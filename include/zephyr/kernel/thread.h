@@ -93,7 +93,8 @@ struct _thread_base {
 	int prio_deadline;
 #endif /* CONFIG_SCHED_DEADLINE */
 
-#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
+#if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE) || \
+	(defined(CONFIG_SCHED_BITMAP) && defined(CONFIG_SCHED_DEADLINE))
 	uint32_t order_key;
 #endif
 
@@ -107,6 +108,11 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	/* Order in which the thread was added to a run queue */
+	uint32_t runq_seq;
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 #endif /* CONFIG_SMP */
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -127,6 +127,22 @@ struct _priq_mq {
 #endif
 };
 
+/* Bitmap-indexed multi-queue.  Like _priq_mq, but a summary word
+ * records which words of the bitmask are non-zero so the best
+ * priority is always found with two bit scans.  With deadline
+ * scheduling each priority level is a red/black tree ordered by
+ * deadline (then FIFO) instead of a plain list.
+ */
+struct _priq_bm {
+#ifdef CONFIG_SCHED_DEADLINE
+	struct _priq_rb queues[K_NUM_THREAD_PRIO];
+#else
+	sys_dlist_t queues[K_NUM_THREAD_PRIO];
+#endif
+	unsigned long summary;
+	unsigned long bitmask[PRIQ_BITMAP_SIZE];
+};
+
 struct _ready_q {
 #ifndef CONFIG_SMP
 	/* always contains next thread to run: cannot be NULL */
@@ -139,6 +155,8 @@ struct _ready_q {
 	struct _priq_rb runq;
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
+#elif defined(CONFIG_SCHED_BITMAP)
+	struct _priq_bm runq;
 #endif
 };
 
@@ -157,7 +175,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -216,7 +234,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_PER_CPU_RUNQ
 	struct _ready_q ready_q;
 #endif
 
@@ -308,6 +326,10 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* CPU whose timeout queue holds this timeout */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
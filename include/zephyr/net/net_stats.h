@@ -172,6 +172,18 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of TCP retransmission timer expirations. */
+	net_stats_t rto_expired;
+
+	/** Number of old duplicate TCP segments dropped by the PAWS check. */
+	net_stats_t paws_drop;
+
+	/** Latest smoothed round-trip time of a TCP connection, in ms. */
+	net_stats_t srtt;
+
+	/** Latest retransmission timeout of a TCP connection, in ms. */
+	net_stats_t rto;
 };
 
 /**
@@ -1213,7 +1225,35 @@ NET_MGMT_DEFINE_REQUEST_HANDLER(NET_REQUEST_STATS_RESET_WIFI);
 		"packet_count",						\
 		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
 		NET_STATS_GET_VAR(dev_id, sfx, tcp_connrst),		\
-		&(iface)->stats.tcp.connrst)
+		&(iface)->stats.tcp.connrst);				\
+	NET_STATS_PROMETHEUS_COUNTER_DEFINE(				\
+		"TCP retransmission timeouts",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_rto_expired),	\
+		"error_count",					\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_rto_expired),	\
+		&(iface)->stats.tcp.rto_expired);			\
+	NET_STATS_PROMETHEUS_COUNTER_DEFINE(				\
+		"TCP segments dropped by PAWS",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_paws_drop),	\
+		"packet_count",						\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_paws_drop),		\
+		&(iface)->stats.tcp.paws_drop);				\
+	NET_STATS_PROMETHEUS_GAUGE_DEFINE(				\
+		"TCP smoothed round-trip time",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_srtt),		\
+		"time",						\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_srtt),		\
+		&(iface)->stats.tcp.srtt);				\
+	NET_STATS_PROMETHEUS_GAUGE_DEFINE(				\
+		"TCP retransmission timeout",				\
+		NET_STATS_GET_INSTANCE(dev_id, sfx, tcp_rto),		\
+		"time",						\
+		NET_STATS_GET_COLLECTOR_NAME(dev_id, sfx),		\
+		NET_STATS_GET_VAR(dev_id, sfx, tcp_rto),		\
+		&(iface)->stats.tcp.rto)
 #else
 #define NET_STATS_PROMETHEUS_TCP(iface, dev_id, sfx)
 #endif
@@ -943,6 +943,8 @@ int zsock_getnameinfo(const struct net_sockaddr *addr, net_socklen_t addrlen,
 #define ZSOCK_TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define ZSOCK_TCP_KEEPCNT 4
+/** Congestion control algorithm of the connection (string) */
+#define ZSOCK_TCP_CONGESTION 5
 
 /** @} */
 
@@ -61,6 +61,8 @@ struct zperf_upload_params {
 	struct {
 		uint8_t tos;
 		int tcp_nodelay;
+		/* TCP congestion control algorithm, empty for the default */
+		char tcp_congestion[16];
 		int priority;
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		int thread_priority;
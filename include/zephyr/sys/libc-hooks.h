@@ -98,6 +98,51 @@ extern struct k_mem_partition z_libc_partition;
 #endif
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC
+#include <zephyr/sys/mem_stats.h>
+
+/**
+ * @brief Get the runtime statistics of the common C library malloc heap
+ *
+ * Only available with CONFIG_SYS_HEAP_RUNTIME_STATS. Blocks held by the
+ * per-CPU malloc caches are reported as free. The maximum allocated byte
+ * count includes them.
+ *
+ * @param stats Pointer to memory into which to copy the statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL @a stats is NULL
+ */
+int malloc_runtime_stats_get(struct sys_memory_stats *stats);
+
+/** Activity of one size class of the per-CPU malloc caches */
+struct malloc_class_stats {
+	/** Largest request served by the class */
+	size_t block_size;
+	/** Free blocks of the class currently held by all CPU caches */
+	size_t cached_blocks;
+	/** Allocations served from a CPU cache */
+	size_t hits;
+	/** Allocations that had to go to the heap */
+	size_t misses;
+};
+
+/**
+ * @brief Get the statistics of one size class of the per-CPU malloc caches
+ *
+ * Only available with CONFIG_COMMON_LIBC_MALLOC_CACHE. Size classes are
+ * numbered from 0, for the smallest blocks.
+ *
+ * @param size_class Size class to query
+ * @param stats Pointer to memory into which to copy the statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL @a stats is NULL or @a size_class does not exist
+ */
+int malloc_runtime_class_stats_get(unsigned int size_class,
+				   struct malloc_class_stats *stats);
+#endif /* CONFIG_COMMON_LIBC_MALLOC */
+
 #include <zephyr/syscalls/libc-hooks.h>
 
 /* C library memory partitions */
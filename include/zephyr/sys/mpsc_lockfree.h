@@ -10,8 +10,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <zephyr/toolchain.h>
 #include <zephyr/sys/atomic.h>
-#include <zephyr/kernel.h>
+#include <zephyr/arch/cpu.h>
 
 #ifdef __cplusplus
 extern "C" {
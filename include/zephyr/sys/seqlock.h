@@ -0,0 +1,166 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SEQLOCK_H_
+#define ZEPHYR_INCLUDE_SYS_SEQLOCK_H_
+
+#include <stdbool.h>
+#include <zephyr/toolchain.h>
+#include <zephyr/arch/cpu.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sequence Lock (seqlock) API
+ * @defgroup seqlock_apis Sequence Lock API
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @file seqlock.h
+ *
+ * @brief A sequence counter protecting a few words of read-mostly data.
+ *
+ * Writers bump the sequence counter to an odd value before updating the
+ * data and back to an even value afterwards. Readers sample the counter,
+ * copy the data and retry if the counter was odd or has changed meanwhile.
+ * Readers never write to shared memory, so any number of them can run in
+ * parallel on different CPUs without bouncing a lock's cache line around.
+ *
+ * Writers are not serialized by the seqlock itself: they must already be
+ * mutually exclusive, typically by holding the spinlock that protects the
+ * data. Since a reader spins while a write is in progress, a writer must
+ * never be preempted by a reader on the same CPU, i.e. the write section
+ * must run with interrupts locked, which is the case under a spinlock.
+ *
+ * The data copied by a reader may be inconsistent until
+ * sys_seqlock_read_retry() returned false, so it must not be dereferenced
+ * or acted upon before that.
+ *
+ * Typical reader:
+ *
+ * @code{.c}
+ * unsigned int seq;
+ *
+ * do {
+ *         seq = sys_seqlock_read_begin(&sl);
+ *         copy = shared;
+ * } while (sys_seqlock_read_retry(&sl, seq));
+ * @endcode
+ */
+
+/**
+ * @brief Sequence lock
+ */
+struct sys_seqlock {
+	/** Sequence counter, odd while a write is in progress */
+	atomic_t seq;
+};
+
+/**
+ * @brief Statically initialize a sequence lock
+ */
+#define SYS_SEQLOCK_INITIALIZER { .seq = ATOMIC_INIT(0) }
+
+/**
+ * @brief Statically define and initialize a sequence lock
+ *
+ * @param name Name of the sequence lock
+ */
+#define SYS_SEQLOCK_DEFINE(name) struct sys_seqlock name = SYS_SEQLOCK_INITIALIZER
+
+/**
+ * @brief Initialize a sequence lock
+ *
+ * @param sl Sequence lock
+ */
+static inline void sys_seqlock_init(struct sys_seqlock *sl)
+{
+	atomic_set(&sl->seq, 0);
+}
+
+/**
+ * @brief Start reading data protected by a sequence lock
+ *
+ * Waits for any write in progress to complete.
+ *
+ * @param sl Sequence lock
+ *
+ * @return Sequence value to pass to sys_seqlock_read_retry()
+ */
+static inline unsigned int sys_seqlock_read_begin(const struct sys_seqlock *sl)
+{
+	unsigned int seq;
+
+	while (((seq = (unsigned int)atomic_get(&sl->seq)) & 1U) != 0U) {
+		arch_spin_relax();
+	}
+
+	barrier_dmem_fence_full();
+	compiler_barrier();
+
+	return seq;
+}
+
+/**
+ * @brief Check whether data read under a sequence lock must be read again
+ *
+ * @param sl Sequence lock
+ * @param seq Value returned by sys_seqlock_read_begin()
+ *
+ * @retval true A writer modified the data, start over
+ * @retval false The data read since sys_seqlock_read_begin() is consistent
+ */
+static inline bool sys_seqlock_read_retry(const struct sys_seqlock *sl, unsigned int seq)
+{
+	compiler_barrier();
+	barrier_dmem_fence_full();
+
+	return (unsigned int)atomic_get(&sl->seq) != seq;
+}
+
+/**
+ * @brief Start modifying data protected by a sequence lock
+ *
+ * The caller must exclude other writers and interrupts, see above.
+ *
+ * @param sl Sequence lock
+ */
+static inline void sys_seqlock_write_begin(struct sys_seqlock *sl)
+{
+	(void)atomic_inc(&sl->seq);
+
+	barrier_dmem_fence_full();
+	compiler_barrier();
+}
+
+/**
+ * @brief Finish modifying data protected by a sequence lock
+ *
+ * @param sl Sequence lock
+ */
+static inline void sys_seqlock_write_end(struct sys_seqlock *sl)
+{
+	compiler_barrier();
+	barrier_dmem_fence_full();
+
+	(void)atomic_inc(&sl->seq);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SEQLOCK_H_ */
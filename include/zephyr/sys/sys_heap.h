@@ -43,8 +43,9 @@ extern "C" {
  * are constant time (though there is a search of the smallest bucket
  * that has a compile-time-configurable upper bound, setting this to
  * extreme values results in an effectively linear search of the
- * list), objectively fast (~hundred instructions) and amenable to
- * locked operation.
+ * list, unless CONFIG_SYS_HEAP_TLSF replaces that search with two
+ * bitmap scans), objectively fast (~hundred instructions) and
+ * amenable to locked operation.
  */
 
 /* Note: the init_mem/bytes fields are for the static initializer to
@@ -65,6 +66,10 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint32_t max_alloc_cycles;
+	uint32_t max_free_cycles;
+	uint64_t accumulated_alloc_cycles;
+	uint64_t accumulated_free_cycles;
 };
 
 /**
@@ -250,7 +255,8 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations and the worst-case and accumulated cycles spent in the
+ * callbacks, are returned via the @a result struct.
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
@@ -758,6 +758,20 @@
  */
 #define sys_port_trace_k_sem_give_exit(sem)
 
+/**
+ * @brief Trace giving a Semaphore several times entry
+ * @param sem Semaphore object
+ * @param count Number of gives
+ */
+#define sys_port_trace_k_sem_give_many_enter(sem, count)
+
+/**
+ * @brief Trace giving a Semaphore several times exit
+ * @param sem Semaphore object
+ * @param count Number of gives
+ */
+#define sys_port_trace_k_sem_give_many_exit(sem, count)
+
 /**
  * @brief Trace taking a Semaphore attempt start
  * @param sem Semaphore object
@@ -1490,6 +1504,109 @@
 
 /** @} */ /* end of subsys_tracing_apis_msgq */
 
+/**
+ * @brief Tracing hooks for variable-size message queue events
+ * @defgroup subsys_tracing_apis_vmsgq Variable-size message queue
+ * @{
+ */
+
+/**
+ * @brief Trace initialization of Variable-size Message Queue
+ * @param vmsgq Variable-size Message Queue object
+ */
+#define sys_port_trace_k_vmsgq_init(vmsgq)
+
+/**
+ * @brief Trace Variable-size Message Queue alloc entry
+ * @param vmsgq Variable-size Message Queue object
+ * @param len Length of the message
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_vmsgq_alloc_enter(vmsgq, len, timeout)
+
+/**
+ * @brief Trace Variable-size Message Queue alloc attempt blocking
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_vmsgq_alloc_blocking(vmsgq, timeout)
+
+/**
+ * @brief Trace Variable-size Message Queue alloc attempt outcome
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_vmsgq_alloc_exit(vmsgq, timeout, ret)
+
+/**
+ * @brief Trace Variable-size Message Queue commit
+ * @param vmsgq Variable-size Message Queue object
+ * @param msg Message
+ */
+#define sys_port_trace_k_vmsgq_commit(vmsgq, msg)
+
+/**
+ * @brief Trace Variable-size Message Queue claim entry
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_vmsgq_claim_enter(vmsgq, timeout)
+
+/**
+ * @brief Trace Variable-size Message Queue claim attempt blocking
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_vmsgq_claim_blocking(vmsgq, timeout)
+
+/**
+ * @brief Trace Variable-size Message Queue claim attempt outcome
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_vmsgq_claim_exit(vmsgq, timeout, ret)
+
+/**
+ * @brief Trace Variable-size Message Queue free
+ * @param vmsgq Variable-size Message Queue object
+ * @param msg Message
+ */
+#define sys_port_trace_k_vmsgq_free(vmsgq, msg)
+
+/**
+ * @brief Trace Variable-size Message Queue put entry
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_vmsgq_put_enter(vmsgq, timeout)
+
+/**
+ * @brief Trace Variable-size Message Queue put attempt outcome
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_vmsgq_put_exit(vmsgq, timeout, ret)
+
+/**
+ * @brief Trace Variable-size Message Queue get entry
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_vmsgq_get_enter(vmsgq, timeout)
+
+/**
+ * @brief Trace Variable-size Message Queue get attempt outcome
+ * @param vmsgq Variable-size Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_vmsgq_get_exit(vmsgq, timeout, ret)
+
+/** @} */ /* end of subsys_tracing_apis_vmsgq */
+
 /**
  * @brief Tracing hooks for mailbox events
  * @defgroup subsys_tracing_apis_mbox Mailbox
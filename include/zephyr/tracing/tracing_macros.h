@@ -143,8 +143,10 @@
 
 #if defined(CONFIG_TRACING_MESSAGE_QUEUE)
 	#define sys_port_trace_type_mask_k_msgq(trace_call) trace_call
+	#define sys_port_trace_type_mask_k_vmsgq(trace_call) trace_call
 #else
 	#define sys_port_trace_type_mask_k_msgq(trace_call)
+	#define sys_port_trace_type_mask_k_vmsgq(trace_call)
 #endif
 
 #if defined(CONFIG_TRACING_MAILBOX)
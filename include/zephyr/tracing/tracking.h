@@ -107,6 +107,9 @@ extern struct k_event *_track_list_k_event;
 #define sys_port_track_k_msgq_peek(msgq, ret)
 #define sys_port_track_k_msgq_init(msgq) \
 	sys_track_k_msgq_init(msgq)
+#define sys_port_track_k_vmsgq_commit(vmsgq, msg)
+#define sys_port_track_k_vmsgq_free(vmsgq, msg)
+#define sys_port_track_k_vmsgq_init(vmsgq)
 #define sys_port_track_k_mbox_init(mbox) \
 	sys_track_k_mbox_init(mbox)
 #define sys_port_track_k_mem_slab_init(slab, rc) \
@@ -162,6 +165,9 @@ void sys_track_socket_init(int sock, int family, int type, int proto);
 #define sys_port_track_k_msgq_purge(msgq)
 #define sys_port_track_k_msgq_peek(msgq, ret)
 #define sys_port_track_k_msgq_init(msgq)
+#define sys_port_track_k_vmsgq_commit(vmsgq, msg)
+#define sys_port_track_k_vmsgq_free(vmsgq, msg)
+#define sys_port_track_k_vmsgq_init(vmsgq)
 #define sys_port_track_k_mbox_init(mbox)
 #define sys_port_track_k_mem_slab_init(slab, rc)
 #define sys_port_track_k_heap_free(h)
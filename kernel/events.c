@@ -179,12 +179,16 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	if (data.head != NULL) {
 		thread = data.head;
 		struct k_thread *next;
-		do {
-			arch_thread_return_value_set(thread, 0);
-			next = thread->next_event_link;
-			z_sched_wake_thread(thread, false);
-			thread = next;
-		} while (thread != NULL);
+
+		/* Ready the whole list under one scheduler lock */
+		K_SPINLOCK(&_sched_spinlock) {
+			do {
+				arch_thread_return_value_set(thread, 0);
+				next = thread->next_event_link;
+				z_sched_wake_thread_locked(thread, false);
+				thread = next;
+			} while (thread != NULL);
+		}
 	}
 
 	/* stash any events not consumed */
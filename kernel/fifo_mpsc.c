@@ -0,0 +1,112 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Lock-free multi-producer, single-consumer FIFO.
+ *
+ * Items are linked with the lock-free queue from sys/mpsc_lockfree.h.
+ * Next to it, @c count tracks the number of items producers have
+ * published minus the number the consumer has taken.  Only the
+ * producer that moves it from 0 to 1 may find the consumer pended, so
+ * it is the only one that takes the spinlock to wake it.
+ *
+ * The consumer re-checks @c count under the spinlock before pending.
+ * A producer increments it before taking the same lock to wake, so
+ * the consumer either sees the new item or is already on the wait
+ * queue when the producer looks there.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <wait_q.h>
+#include <ksched.h>
+#include <kernel_internal.h>
+
+void k_fifo_mpsc_init(struct k_fifo_mpsc *fifo)
+{
+	mpsc_init(&fifo->q);
+	atomic_set(&fifo->count, 0);
+	fifo->lock = (struct k_spinlock) {};
+	z_waitq_init(&fifo->wait_q);
+}
+
+void k_fifo_mpsc_put(struct k_fifo_mpsc *fifo, void *data)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+	atomic_val_t prev;
+	unsigned int irq_key;
+
+	/* Publishing the node and counting it must not be split by an
+	 * interrupt on this CPU, otherwise a consumer that preempts us
+	 * here would see a count that disagrees with the queue until we
+	 * get to run again.
+	 */
+	irq_key = arch_irq_lock();
+	mpsc_push(&fifo->q, (struct mpsc_node *)data);
+	prev = atomic_inc(&fifo->count);
+	arch_irq_unlock(irq_key);
+
+	if (prev != 0) {
+		/* Not the empty to non-empty transition: the consumer
+		 * cannot be waiting for this item.
+		 */
+		return;
+	}
+
+	key = k_spin_lock(&fifo->lock);
+	thread = z_unpend_first_thread(&fifo->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&fifo->lock, key);
+	} else {
+		k_spin_unlock(&fifo->lock, key);
+	}
+}
+
+void *k_fifo_mpsc_get(struct k_fifo_mpsc *fifo, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct mpsc_node *node;
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	while (true) {
+		node = mpsc_pop(&fifo->q);
+		if (node != NULL) {
+			atomic_dec(&fifo->count);
+			return node;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return NULL;
+		}
+
+		key = k_spin_lock(&fifo->lock);
+
+		if (atomic_get(&fifo->count) != 0) {
+			/* A producer on another CPU is between linking
+			 * its node and counting it.  The item shows up
+			 * as soon as it finishes, so just retry.
+			 */
+			k_spin_unlock(&fifo->lock, key);
+			continue;
+		}
+
+		ret = z_pend_curr(&fifo->lock, key, &fifo->wait_q, timeout);
+
+		/* On timeout, look at the queue one last time without
+		 * waiting in case an item raced with the expiry.
+		 */
+		timeout = (ret == 0) ? sys_timepoint_timeout(end) : K_NO_WAIT;
+	}
+}
@@ -13,6 +13,7 @@
 #include <kthread.h>
 #include <zephyr/tracing/tracing.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <priority_q.h>
 
 BUILD_ASSERT(K_LOWEST_APPLICATION_THREAD_PRIO
@@ -215,6 +216,18 @@ static ALWAYS_INLINE struct k_thread *z_unpend_first_thread(_wait_q_t *wait_q)
  */
 bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 
+/**
+ * Check whether a thread is currently running on a CPU.
+ *
+ * Takes no lock and may be called with interrupts enabled. The answer is
+ * only a snapshot and may be stale by the time it is acted upon; it is
+ * meant for heuristics such as adaptive spinning.
+ *
+ * @param thread Thread to check.
+ * @retval true If @a thread is the current thread of the CPU it last ran on
+ */
+bool z_thread_is_running(struct k_thread *thread);
+
 /**
  * Wakes the specified thread.
  *
@@ -227,11 +240,39 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
  */
 void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 
+/**
+ * Wakes the specified thread with _sched_spinlock already held.
+ *
+ * Same as z_sched_wake_thread(), for callers that wake several threads
+ * and want to take _sched_spinlock only once for the whole batch.
+ *
+ * @param thread Given thread to wake up.
+ * @param is_timeout True if called from the timer ISR; false otherwise.
+ */
+void z_sched_wake_thread_locked(struct k_thread *thread, bool is_timeout);
+
+/**
+ * Wake up to @a max threads pending on the provided wait queue
+ *
+ * Like z_sched_wake(), but the threads are woken in priority order
+ * under a single acquisition of _sched_spinlock rather than one per
+ * thread. The scheduler is not invoked; the caller should do a single
+ * z_reschedule() afterwards if any thread was woken.
+ *
+ * @param wait_q Wait queue to wake up threads from
+ * @param max Maximum number of threads to wake up
+ * @param swap_retval Swap return value for woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+unsigned int z_sched_wake_many(_wait_q_t *wait_q, unsigned int max,
+			       int swap_retval, void *swap_data);
+
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience function to invoke z_sched_wake_many() on all threads in the
+ * queue.
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -242,14 +283,8 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
 	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_many(wait_q, UINT_MAX, swap_retval, swap_data) != 0U;
 }
 
 /**
@@ -358,6 +358,15 @@ void k_mem_page_frames_dump(void);
  */
 unsigned long k_mem_num_pagefaults_get(void);
 
+/**
+ * Number of pages read ahead of page faults since system startup
+ *
+ * Pages read ahead are not counted by k_mem_num_pagefaults_get().
+ *
+ * @return Number of pages read ahead
+ */
+unsigned long k_mem_num_prefetched_pages_get(void);
+
 /**
  * Free a page frame physical address by evicting its contents
  *
@@ -18,6 +18,141 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+#define CACHE_SIZE  CONFIG_MEM_SLAB_PER_CPU_CACHE_SIZE
+#define CACHE_BATCH (CACHE_SIZE / 2)
+
+/* Move up to n blocks from one free list to another */
+static uint32_t move_blocks(char **to, char **from, uint32_t n)
+{
+	uint32_t moved = 0U;
+
+	while ((moved < n) && (*from != NULL)) {
+		char *p = *from;
+
+		*from = *(char **)p;
+		*(char **)p = *to;
+		*to = p;
+		moved++;
+	}
+
+	return moved;
+}
+
+/* Returns the number of blocks held by CPU caches. Called with slab->lock held. */
+static uint32_t num_cached(struct k_mem_slab *slab)
+{
+	uint32_t cached = 0U;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(slab->cache); i++) {
+		K_SPINLOCK(&slab->cache[i].lock) {
+			cached += slab->cache[i].count;
+		}
+	}
+
+	return cached;
+}
+
+/*
+ * Returns the blocks of all CPU caches to the slab's free list, when it has
+ * run empty. Frees on every CPU are then routed to the slow path, which
+ * hands them to waiting threads, until the CPU next finds no waiter there.
+ * Called with slab->lock held.
+ */
+static void cache_reclaim_all(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(slab->cache); i++) {
+		struct k_mem_slab_cache *cache = &slab->cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			slab->info.num_used -= move_blocks(&slab->free_list,
+							   &cache->free_list,
+							   cache->count);
+			cache->count = 0U;
+			cache->bypass = true;
+		}
+	}
+}
+
+/*
+ * Balances the current CPU's cache against the slab's free list: fills it
+ * up to half when empty, drains it to half when full, and lets frees use
+ * it again. Called with slab->lock held and no thread waiting on the slab.
+ */
+static void cache_balance(struct k_mem_slab *slab)
+{
+	struct k_mem_slab_cache *cache = &slab->cache[_current_cpu->id];
+
+	K_SPINLOCK(&cache->lock) {
+		uint32_t moved;
+
+		if (cache->count == 0U) {
+			moved = move_blocks(&cache->free_list, &slab->free_list,
+					    CACHE_BATCH);
+			cache->count += moved;
+			slab->info.num_used += moved;
+		} else if (cache->count == CACHE_SIZE) {
+			moved = move_blocks(&slab->free_list, &cache->free_list,
+					    CACHE_BATCH);
+			cache->count -= moved;
+			slab->info.num_used -= moved;
+		} else {
+			/* nothing to move */
+		}
+
+		cache->bypass = false;
+	}
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_cache *cache = &slab->cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool hit = cache->free_list != NULL;
+
+	if (hit) {
+		*mem = cache->free_list;
+		cache->free_list = *(char **)(cache->free_list);
+		cache->count--;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	return hit;
+}
+
+static bool cache_free(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_cache *cache = &slab->cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool hit = !cache->bypass && (cache->count < CACHE_SIZE);
+
+	if (hit) {
+		*(char **)mem = cache->free_list;
+		cache->free_list = (char *)mem;
+		cache->count++;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	return hit;
+}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+/* Returns the number of blocks actually allocated. Called with slab->lock held. */
+static uint32_t num_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	return slab->info.num_used - num_cached(slab);
+#else
+	return slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+}
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -33,6 +168,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+	((struct k_mem_slab_info *)stats)->num_used = num_used(slab);
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -45,12 +181,13 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	struct k_mem_slab *slab;
 	k_spinlock_key_t   key;
 	struct sys_memory_stats *ptr = stats;
+	uint32_t used;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	used = num_used(slab);
+	ptr->free_bytes = (slab->info.num_blocks - used) * slab->info.block_size;
+	ptr->allocated_bytes = used * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -184,6 +321,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	memset(slab->cache, 0, sizeof(slab->cache));
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -221,11 +362,27 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (slab->free_list == NULL) {
+		cache_reclaim_all(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -236,6 +393,11 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			 slab_ptr_is_good(slab, slab->free_list),
 			 "slab corruption detected");
 
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+		/* and some more for the next allocations on this CPU */
+		cache_balance(slab);
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 		slab->info.max_used = max(slab->info.num_used,
 					  slab->info.max_used);
@@ -276,9 +438,18 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	if (cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
 	if (unlikely(slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
@@ -291,6 +462,12 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 			return;
 		}
 	}
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+	/* make room in this CPU's cache for the next frees */
+	cache_balance(slab);
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
+
 	*(char **) mem = slab->free_list;
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
@@ -307,10 +484,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t used = num_used(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - used) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -339,3 +516,16 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 	return 0;
 }
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+#ifdef CONFIG_MEM_SLAB_PER_CPU_CACHE
+uint32_t z_mem_slab_num_used_get(struct k_mem_slab *slab)
+{
+	uint32_t used = 0U;
+
+	K_SPINLOCK(&slab->lock) {
+		used = num_used(slab);
+	}
+
+	return used;
+}
+#endif /* CONFIG_MEM_SLAB_PER_CPU_CACHE */
@@ -1556,6 +1556,18 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_prefetch_inc(struct k_thread *faulting_thread)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.prefetch.pages++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.prefetch.pages++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 					     bool dirty)
 {
@@ -1611,7 +1623,138 @@ static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+#ifdef CONFIG_DEMAND_PAGING_WRITEBACK
+/*
+ * Background eviction, so that page faults find free page frames and do
+ * not have to wait for a dirty data page to be written to the backing store
+ * before the faulting one can be read.
+ *
+ * Page faults wake up the write-back thread when the number of free page
+ * frames drops below the low watermark. It then evicts data pages selected
+ * by the eviction algorithm, one at a time, until the high watermark is
+ * reached.
+ */
+BUILD_ASSERT(CONFIG_DEMAND_PAGING_WRITEBACK_HIGH_WATERMARK >
+	     CONFIG_DEMAND_PAGING_WRITEBACK_LOW_WATERMARK);
+
+static K_SEM_DEFINE(writeback_sem, 0, 1);
+static K_KERNEL_PINNED_STACK_DEFINE(writeback_stack,
+				    CONFIG_DEMAND_PAGING_WRITEBACK_STACK_SIZE);
+__pinned_bss
+static struct k_thread writeback_thread;
+
+/*
+ * Called with z_mm_lock held. Interrupts are locked, so giving the
+ * semaphore makes the write-back thread ready but never reschedules.
+ */
+static inline void writeback_wake_locked(void)
+{
+	if (z_free_page_count < CONFIG_DEMAND_PAGING_WRITEBACK_LOW_WATERMARK) {
+		k_sem_give(&writeback_sem);
+	}
+}
+
+/*
+ * Evict one data page. Returns false once the high watermark is reached or
+ * no data page can be evicted.
+ */
+static bool writeback_evict_one(void)
+{
+	k_spinlock_key_t key;
+	struct k_mem_page_frame *pf;
+	bool dirty = false;
+	uintptr_t location;
+	bool result = false;
+
+	/* Implementation is similar to k_mem_page_frame_evict() except the
+	 * page frame is picked by the eviction algorithm, see comments in
+	 * do_page_fault().
+	 */
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+#ifdef CONFIG_SMP
+	k_mutex_lock(&z_mm_paging_lock, K_FOREVER);
+#else
+	k_sched_lock();
+#endif
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	key = k_spin_lock(&z_mm_lock);
+	if (z_free_page_count >= CONFIG_DEMAND_PAGING_WRITEBACK_HIGH_WATERMARK) {
+		goto out;
+	}
+
+	pf = do_eviction_select(&dirty);
+	if (pf == NULL) {
+		goto out;
+	}
+
+	if (page_frame_prepare_locked(pf, &dirty, false, &location) != 0) {
+		goto out;
+	}
+	paging_stats_eviction_inc(_current, dirty);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_spin_unlock(&z_mm_lock, key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(location);
+	}
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	key = k_spin_lock(&z_mm_lock);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	page_frame_free_locked(pf);
+	result = true;
+out:
+	k_spin_unlock(&z_mm_lock, key);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+#ifdef CONFIG_SMP
+	k_mutex_unlock(&z_mm_paging_lock);
+#else
+	k_sched_unlock();
+#endif
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	return result;
+}
+
+static void writeback_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_sem_take(&writeback_sem, K_FOREVER);
+
+		while (writeback_evict_one()) {
+		}
+	}
+}
+
+static int writeback_init(void)
+{
+	k_thread_create(&writeback_thread, writeback_stack,
+			K_KERNEL_STACK_SIZEOF(writeback_stack),
+			writeback_thread_entry, NULL, NULL, NULL,
+			CONFIG_DEMAND_PAGING_WRITEBACK_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&writeback_thread, "paging_writeback");
+
+	return 0;
+}
+
+SYS_INIT(writeback_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_DEMAND_PAGING_WRITEBACK */
+
+/*
+ * Page in the data page at addr, pinning it if requested.
+ *
+ * When prefetching, the page is read ahead of an actual access: nothing is
+ * done if it is not paged out, and false is returned so that the caller
+ * stops reading ahead.
+ *
+ * If paged_in is not NULL, it is set to whether this call paged the page
+ * in, and a page that was already present is left unpinned.
+ */
+static bool do_page_fault(void *addr, bool pin, bool prefetch, bool *paged_in)
 {
 	struct k_mem_page_frame *pf;
 	k_spinlock_key_t key;
@@ -1627,6 +1770,10 @@ static bool do_page_fault(void *addr, bool pin)
 
 	LOG_DBG("page fault at %p", addr);
 
+	if (paged_in != NULL) {
+		*paged_in = false;
+	}
+
 	/*
 	 * TODO: Add performance accounting:
 	 * - k_mem_paging_eviction_select() metrics
@@ -1685,8 +1832,13 @@ static bool do_page_fault(void *addr, bool pin)
 	}
 	result = true;
 
+	if (prefetch && (status != ARCH_PAGE_LOCATION_PAGED_OUT)) {
+		result = false;
+		goto out;
+	}
+
 	if (status == ARCH_PAGE_LOCATION_PAGED_IN) {
-		if (pin) {
+		if (pin && (paged_in == NULL)) {
 			/* It's a physical memory address */
 			uintptr_t phys = page_in_location;
 
@@ -1709,9 +1861,16 @@ static bool do_page_fault(void *addr, bool pin)
 	__ASSERT(status == ARCH_PAGE_LOCATION_PAGED_OUT,
 		 "unexpected status value %d", status);
 
-	paging_stats_faults_inc(faulting_thread, key.key);
+	if (prefetch) {
+		paging_stats_prefetch_inc(faulting_thread);
+	} else {
+		paging_stats_faults_inc(faulting_thread, key.key);
+	}
 
 	pf = free_page_frame_list_get();
+#ifdef CONFIG_DEMAND_PAGING_WRITEBACK
+	writeback_wake_locked();
+#endif /* CONFIG_DEMAND_PAGING_WRITEBACK */
 	if (pf == NULL) {
 		/* Need to evict a page frame */
 		pf = do_eviction_select(&dirty);
@@ -1752,6 +1911,9 @@ static bool do_page_fault(void *addr, bool pin)
 	if (IS_ENABLED(CONFIG_EVICTION_TRACKING) && (!pin)) {
 		k_mem_paging_eviction_add(pf);
 	}
+	if (paged_in != NULL) {
+		*paged_in = true;
+	}
 out:
 	k_spin_unlock(&z_mm_lock, key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -1769,7 +1931,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false, NULL);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1786,7 +1948,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false, NULL);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1799,9 +1961,51 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+/*
+ * Read ahead the pages following a faulting one, stopping at the first one
+ * which is not paged out.
+ */
+static void do_prefetch(void *addr)
+{
+	uintptr_t virt = POINTER_TO_UINT(addr) & ~(CONFIG_MMU_PAGE_SIZE - 1);
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_PREFETCH_PAGES; i++) {
+		virt += CONFIG_MMU_PAGE_SIZE;
+		if ((virt - POINTER_TO_UINT(K_MEM_VIRT_RAM_START)) >= K_MEM_VIRT_RAM_SIZE) {
+			break;
+		}
+		if (!do_page_fault(UINT_TO_POINTER(virt), false, true, NULL)) {
+			break;
+		}
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
+
+static void do_mem_unpin(void *addr);
+
 bool k_mem_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+	bool paged_in;
+
+	/*
+	 * Only read ahead once the fault is known to be a valid one which
+	 * paged data in. The faulting page stays pinned meanwhile, so that
+	 * evictions made to read ahead cannot select it.
+	 */
+	if (!do_page_fault(addr, true, false, &paged_in)) {
+		return false;
+	}
+	if (paged_in) {
+		do_prefetch(addr);
+		do_mem_unpin(addr);
+	}
+
+	return true;
+#else
+	return do_page_fault(addr, false, false, NULL);
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
 }
 
 static void do_mem_unpin(void *addr)
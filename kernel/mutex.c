@@ -33,6 +33,7 @@
 #include <kthread.h>
 #include <wait_q.h>
 #include <errno.h>
+#include <string.h>
 #include <zephyr/init.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
@@ -50,8 +51,56 @@ static struct k_spinlock lock;
 
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static struct k_obj_type obj_type_mutex;
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int k_mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mutex *mutex;
+	k_spinlock_key_t key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	memcpy(stats, &mutex->stats, sizeof(mutex->stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mutex *mutex;
+	k_spinlock_key_t key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	mutex->stats = (struct k_mutex_stats) {};
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_mutex_stats),
+	.query_size = sizeof(struct k_mutex_stats),
+	.raw   = k_mutex_stats_raw,
+	.query = k_mutex_stats_raw,
+	.reset = k_mutex_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+
+#define MUTEX_STATS_INC(mutex, field) ((mutex)->stats.field++)
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
+#ifndef MUTEX_STATS_INC
+#define MUTEX_STATS_INC(mutex, field) do { } while (false)
+#endif
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
@@ -64,6 +113,11 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif /* CONFIG_OBJ_CORE_MUTEX */
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats = (struct k_mutex_stats) {};
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+				  sizeof(struct k_mutex_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
@@ -102,6 +156,49 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/*
+ * Called with the lock held on a mutex owned by another thread. Busy-wait
+ * for it to be released for as long as its owner is running on another
+ * CPU and the spin budget is not spent. Returns with the lock held, and
+ * true if the mutex is free to be taken.
+ *
+ * The spin polls the mutex without the lock, which is only taken again
+ * once the mutex looks free or the spin is given up, so that spinners
+ * don't keep the owner from unlocking. A pended waiter gets the mutex
+ * handed over directly on unlock, so there is no point spinning behind
+ * one.
+ */
+static bool mutex_spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	volatile struct k_mutex *vmutex = mutex;
+	uint32_t start = k_cycle_get_32();
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+
+	if ((z_waitq_head(&mutex->wait_q) != NULL) ||
+	    !z_thread_is_running(mutex->owner)) {
+		return false;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	while (vmutex->lock_count != 0U) {
+		struct k_thread *owner = vmutex->owner;
+
+		if (((owner != NULL) && !z_thread_is_running(owner)) ||
+		    ((k_cycle_get_32() - start) >= budget)) {
+			break;
+		}
+
+		arch_spin_relax();
+	}
+
+	*key = k_spin_lock(&lock);
+
+	return mutex->lock_count == 0U;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -114,6 +211,14 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+	    mutex_spin_on_owner(mutex, &key)) {
+		MUTEX_STATS_INC(mutex, spin_acquired);
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -153,6 +258,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+	MUTEX_STATS_INC(mutex, blocked);
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
@@ -299,11 +406,18 @@ static int init_mutex_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	/* Initialize and link statically defined mutexes */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+					  sizeof(struct k_mutex_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 	}
 
 	return 0;
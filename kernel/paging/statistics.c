@@ -88,6 +88,18 @@ unsigned long k_mem_num_pagefaults_get(void)
 	return ret;
 }
 
+unsigned long k_mem_num_prefetched_pages_get(void)
+{
+	unsigned long ret;
+	unsigned int key;
+
+	key = irq_lock();
+	ret = paging_stats.prefetch.pages;
+	irq_unlock(key);
+
+	return ret;
+}
+
 void z_impl_k_mem_paging_stats_get(struct k_mem_paging_stats_t *stats)
 {
 	if (stats == NULL) {
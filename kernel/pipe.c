@@ -34,6 +34,17 @@ static inline bool pipe_empty(struct k_pipe *pipe)
 	return ring_buf_is_empty(&pipe->buf);
 }
 
+/* A claim is outstanding while the head of its ring index is ahead of the tail */
+static inline bool write_claimed(struct k_pipe *pipe)
+{
+	return pipe->buf.put.head != pipe->buf.put.tail;
+}
+
+static inline bool read_claimed(struct k_pipe *pipe)
+{
+	return pipe->buf.get.head != pipe->buf.get.tail;
+}
+
 static int wait_for(_wait_q_t *waitq, struct k_pipe *pipe, k_spinlock_key_t *key,
 		    k_timepoint_t time_limit, bool *need_resched)
 {
@@ -144,7 +155,51 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 	return written;
 }
 
-int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_timeout_t timeout)
+/* Position within the data of a k_pipe_write() or k_pipe_writev() call */
+struct pipe_iov_iter {
+	const struct k_pipe_iovec *iov;
+	size_t iovcnt;
+	size_t offset;
+};
+
+static inline bool iov_iter_done(struct pipe_iov_iter *it)
+{
+	while (it->iovcnt != 0 && it->offset == it->iov->len) {
+		it->iov++;
+		it->iovcnt--;
+		it->offset = 0;
+	}
+
+	return it->iovcnt == 0;
+}
+
+static size_t pipe_write_iov(struct k_pipe *pipe, struct pipe_iov_iter *it, bool *need_resched,
+			     bool to_readers)
+{
+	const uint8_t *data;
+	size_t len, copied, written = 0;
+
+	while (!iov_iter_done(it)) {
+		data = &it->iov->data[it->offset];
+		len = it->iov->len - it->offset;
+
+		if (to_readers) {
+			copied = copy_to_pending_readers(pipe, need_resched, data, len);
+		} else {
+			copied = ring_buf_put(&pipe->buf, data, len);
+		}
+
+		it->offset += copied;
+		written += copied;
+		if (copied < len) {
+			break;
+		}
+	}
+
+	return written;
+}
+
+static int pipe_write(struct k_pipe *pipe, struct pipe_iov_iter *it, k_timeout_t timeout)
 {
 	int rc;
 	size_t written = 0;
@@ -152,14 +207,18 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 	bool need_resched = false;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, write, pipe, data, len, timeout);
-
 	if (unlikely(pipe_resetting(pipe))) {
 		rc = -ECANCELED;
 		goto exit;
 	}
 
 	for (;;) {
+		/* A write area may also have been claimed while we were pending */
+		if (unlikely(write_claimed(pipe))) {
+			rc = written ? written : -EBUSY;
+			break;
+		}
+
 		if (unlikely(pipe_closed(pipe))) {
 			rc = -EPIPE;
 			break;
@@ -178,10 +237,8 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 				 */
 				need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
 			} else if (pipe->waiting != 0) {
-				written += copy_to_pending_readers(pipe, &need_resched,
-								   &data[written],
-								   len - written);
-				if (written >= len) {
+				written += pipe_write_iov(pipe, it, &need_resched, true);
+				if (iov_iter_done(it)) {
 					rc = written;
 					break;
 				}
@@ -193,8 +250,8 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
 
-		written += ring_buf_put(&pipe->buf, &data[written], len - written);
-		if (likely(written == len)) {
+		written += pipe_write_iov(pipe, it, &need_resched, false);
+		if (likely(iov_iter_done(it))) {
 			rc = written;
 			break;
 		}
@@ -208,7 +265,6 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 		}
 	}
 exit:
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, write, pipe, rc);
 	if (need_resched) {
 		z_reschedule(&pipe->lock, key);
 	} else {
@@ -217,6 +273,29 @@ exit:
 	return rc;
 }
 
+int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_timeout_t timeout)
+{
+	struct k_pipe_iovec iov = { data, len };
+	struct pipe_iov_iter it = { &iov, 1, 0 };
+	int rc;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, write, pipe, data, len, timeout);
+
+	rc = pipe_write(pipe, &it, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, write, pipe, rc);
+
+	return rc;
+}
+
+int k_pipe_writev(struct k_pipe *pipe, const struct k_pipe_iovec *iov, size_t iovcnt,
+		  k_timeout_t timeout)
+{
+	struct pipe_iov_iter it = { iov, iovcnt, 0 };
+
+	return pipe_write(pipe, &it, timeout);
+}
+
 int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout_t timeout)
 {
 	struct pipe_buf_spec buf = { data, len, 0 };
@@ -233,6 +312,12 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 	}
 
 	for (;;) {
+		/* A read area may also have been claimed while we were pending */
+		if (unlikely(read_claimed(pipe))) {
+			rc = buf.used ? buf.used : -EBUSY;
+			break;
+		}
+
 		if (pipe_full(pipe)) {
 			/* One or more pending writers may exist. */
 			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
@@ -270,6 +355,153 @@ exit:
 	return rc;
 }
 
+int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len, k_timeout_t timeout)
+{
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		/* Checked again after every wait, another thread may claim first */
+		if (unlikely(write_claimed(pipe))) {
+			rc = -EBUSY;
+			break;
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		if (len == 0 || !pipe_full(pipe)) {
+			rc = ring_buf_put_claim(&pipe->buf, data, MIN(len, RING_BUFFER_MAX_SIZE));
+			break;
+		}
+
+		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int k_pipe_write_finish(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	bool need_resched = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	rc = ring_buf_put_finish(&pipe->buf, len);
+	if (rc == 0 && len != 0) {
+		/*
+		 * Pending readers wait for data to show up in the ring
+		 * buffer, or for a writer to copy it to them directly,
+		 * which is not possible here: let them read it.
+		 */
+		if (pipe->waiting != 0) {
+			need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
+		}
+#ifdef CONFIG_POLL
+		need_resched |= z_handle_obj_poll_events(&pipe->poll_events,
+							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int k_pipe_read_claim(struct k_pipe *pipe, const uint8_t **data, size_t len,
+		      k_timeout_t timeout)
+{
+	/*
+	 * Empty direct copy destination: writers copying directly to pending
+	 * readers only wake us up to claim data from the ring buffer.
+	 */
+	uint8_t none;
+	struct pipe_buf_spec buf = { &none, 0, 0 };
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		/* Checked again after every wait, another thread may claim first */
+		if (unlikely(read_claimed(pipe))) {
+			rc = -EBUSY;
+			break;
+		}
+
+		if (len == 0 || !pipe_empty(pipe)) {
+			rc = ring_buf_get_claim(&pipe->buf, (uint8_t **)data,
+						MIN(len, RING_BUFFER_MAX_SIZE));
+			break;
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		_current->base.swap_data = &buf;
+
+		rc = wait_for(&pipe->data, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int k_pipe_read_finish(struct k_pipe *pipe, size_t len)
+{
+	int rc;
+	bool need_resched = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool was_full = pipe_full(pipe);
+
+	rc = ring_buf_get_finish(&pipe->buf, len);
+	if (rc == 0 && len != 0 && was_full) {
+		/* One or more pending writers may exist. */
+		need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
 void z_impl_k_pipe_reset(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, reset, pipe);
@@ -0,0 +1,424 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Reader-writer lock kernel object.
+ *
+ * The whole lock state lives in one atomic word: the number of readers
+ * holding the lock, a bit for a writer holding it and a bit for writers
+ * waiting for it. Readers get in and out with a compare-and-swap on that
+ * word as long as neither bit is set, so concurrent readers on different
+ * CPUs never serialize on the spinlock.
+ *
+ * Every other transition happens with the spinlock held. Waiting writers
+ * are always preferred: the "writers waiting" bit keeps new readers out,
+ * the last reader to leave hands the lock to the first waiting writer,
+ * and a writer releasing the lock hands it to the next writer before
+ * letting any reader in. Threads are woken with the lock already granted
+ * to them.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <string.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/init.h>
+
+#define RWLOCK_WRITER          ((atomic_val_t)BIT(31))
+#define RWLOCK_WRITERS_WAITING ((atomic_val_t)BIT(30))
+#define RWLOCK_READERS_MASK    (RWLOCK_WRITERS_WAITING - 1)
+
+#ifdef CONFIG_OBJ_CORE_RWLOCK
+static struct k_obj_type obj_type_rwlock;
+
+#ifdef CONFIG_OBJ_CORE_STATS_RWLOCK
+static int k_rwlock_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_rwlock *rwlock;
+	k_spinlock_key_t key;
+
+	rwlock = CONTAINER_OF(obj_core, struct k_rwlock, obj_core);
+	key = k_spin_lock(&rwlock->lock);
+	memcpy(stats, &rwlock->stats, sizeof(rwlock->stats));
+	k_spin_unlock(&rwlock->lock, key);
+
+	return 0;
+}
+
+static int k_rwlock_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_rwlock *rwlock;
+	k_spinlock_key_t key;
+
+	rwlock = CONTAINER_OF(obj_core, struct k_rwlock, obj_core);
+	key = k_spin_lock(&rwlock->lock);
+	rwlock->stats = (struct k_rwlock_stats) {};
+	k_spin_unlock(&rwlock->lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc rwlock_stats_desc = {
+	.raw_size = sizeof(struct k_rwlock_stats),
+	.query_size = sizeof(struct k_rwlock_stats),
+	.raw   = k_rwlock_stats_raw,
+	.query = k_rwlock_stats_raw,
+	.reset = k_rwlock_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+
+#define RWLOCK_STATS_INC(rwlock, field) ((rwlock)->stats.field++)
+#endif /* CONFIG_OBJ_CORE_STATS_RWLOCK */
+#endif /* CONFIG_OBJ_CORE_RWLOCK */
+
+#ifndef RWLOCK_STATS_INC
+#define RWLOCK_STATS_INC(rwlock, field) do { } while (false)
+#endif
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	atomic_set(&rwlock->state, 0);
+	rwlock->writer = NULL;
+	rwlock->lock = (struct k_spinlock) {};
+	z_waitq_init(&rwlock->read_wait_q);
+	z_waitq_init(&rwlock->write_wait_q);
+
+	k_object_init(rwlock);
+
+#ifdef CONFIG_OBJ_CORE_RWLOCK
+	k_obj_core_init_and_link(K_OBJ_CORE(rwlock), &obj_type_rwlock);
+#endif /* CONFIG_OBJ_CORE_RWLOCK */
+#ifdef CONFIG_OBJ_CORE_STATS_RWLOCK
+	rwlock->stats = (struct k_rwlock_stats) {};
+	k_obj_core_stats_register(K_OBJ_CORE(rwlock), &rwlock->stats,
+				  sizeof(struct k_rwlock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_RWLOCK */
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_init_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/*
+ * Grant the lock to every waiting reader. Called with the spinlock held
+ * and the writer bit set by the caller, which keeps fast path writers
+ * out until the woken readers have been counted in. Clears the writer
+ * bit.
+ */
+static bool wake_readers(struct k_rwlock *rwlock)
+{
+	unsigned int woken;
+
+	woken = z_sched_wake_many(&rwlock->read_wait_q, UINT_MAX, 0, NULL);
+	atomic_add(&rwlock->state, (atomic_val_t)woken);
+	atomic_and(&rwlock->state, ~RWLOCK_WRITER);
+
+	return woken != 0U;
+}
+
+/*
+ * Let waiting readers in after the last waiting writer has gone, unless a
+ * writer holds the lock, in which case its unlock will do it. Called with
+ * the spinlock held.
+ */
+static bool release_blocked_readers(struct k_rwlock *rwlock)
+{
+	atomic_val_t state;
+
+	atomic_and(&rwlock->state, ~RWLOCK_WRITERS_WAITING);
+
+	do {
+		state = atomic_get(&rwlock->state);
+		if ((state & RWLOCK_WRITER) != 0) {
+			return false;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state | RWLOCK_WRITER));
+
+	return wake_readers(rwlock);
+}
+
+/* Hand the lock over to @a thread, taken from the writer wait queue */
+static void grant_writer(struct k_rwlock *rwlock, struct k_thread *thread)
+{
+	atomic_val_t waiting = (z_waitq_head(&rwlock->write_wait_q) != NULL) ?
+			       RWLOCK_WRITERS_WAITING : 0;
+
+	rwlock->writer = thread;
+	atomic_set(&rwlock->state, RWLOCK_WRITER | waiting);
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+}
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	/* Fast path: no writer holds or waits for the lock */
+	state = atomic_get(&rwlock->state);
+	if (((state & (RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) == 0) &&
+	    atomic_cas(&rwlock->state, state, state + 1)) {
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	while (true) {
+		state = atomic_get(&rwlock->state);
+		if ((state & (RWLOCK_WRITER | RWLOCK_WRITERS_WAITING)) != 0) {
+			break;
+		}
+		if (atomic_cas(&rwlock->state, state, state + 1)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return 0;
+		}
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&rwlock->lock, key);
+		return -EBUSY;
+	}
+
+	RWLOCK_STATS_INC(rwlock, read_blocked);
+
+	/* Whoever wakes us has already counted us in as a reader */
+	return z_pend_curr(&rwlock->lock, key, &rwlock->read_wait_q, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <zephyr/syscalls/k_rwlock_read_lock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+	struct k_thread *thread;
+	bool resched;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	do {
+		state = atomic_get(&rwlock->state);
+		if ((state & RWLOCK_READERS_MASK) == 0) {
+			return -EINVAL;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state - 1));
+
+	if (((state & RWLOCK_READERS_MASK) != 1) ||
+	    ((state & RWLOCK_WRITERS_WAITING) == 0)) {
+		return 0;
+	}
+
+	/* Last reader out with writers waiting: hand the lock over */
+	key = k_spin_lock(&rwlock->lock);
+
+	state = atomic_get(&rwlock->state);
+	if ((state & (RWLOCK_WRITER | RWLOCK_READERS_MASK)) != 0) {
+		/* Another writer got in first, it hands over on unlock */
+		k_spin_unlock(&rwlock->lock, key);
+		return 0;
+	}
+
+	thread = z_unpend_first_thread(&rwlock->write_wait_q);
+	if (thread != NULL) {
+		grant_writer(rwlock, thread);
+		resched = true;
+	} else {
+		/* The waiting writers timed out before we got here */
+		resched = release_blocked_readers(rwlock);
+	}
+
+	if (resched) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	/* Fast path: nobody holds or waits for the lock */
+	if (atomic_cas(&rwlock->state, 0, RWLOCK_WRITER)) {
+		rwlock->writer = _current;
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	while (true) {
+		state = atomic_get(&rwlock->state);
+		if ((state & (RWLOCK_WRITER | RWLOCK_READERS_MASK)) == 0) {
+			if (atomic_cas(&rwlock->state, state,
+				       state | RWLOCK_WRITER)) {
+				rwlock->writer = _current;
+				k_spin_unlock(&rwlock->lock, key);
+				return 0;
+			}
+			continue;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EBUSY;
+		}
+
+		/* Once the bit is set, the last reader to leave comes
+		 * looking for us in the wait queue.
+		 */
+		if (((state & RWLOCK_WRITERS_WAITING) != 0) ||
+		    atomic_cas(&rwlock->state, state,
+			       state | RWLOCK_WRITERS_WAITING)) {
+			break;
+		}
+	}
+
+	RWLOCK_STATS_INC(rwlock, write_blocked);
+
+	ret = z_pend_curr(&rwlock->lock, key, &rwlock->write_wait_q, timeout);
+	if (ret == 0) {
+		/* Handed over by the previous holder */
+		return 0;
+	}
+
+	/* Timed out: if we were the last waiting writer, the readers we
+	 * were keeping out may go ahead.
+	 */
+	key = k_spin_lock(&rwlock->lock);
+
+	if ((z_waitq_head(&rwlock->write_wait_q) == NULL) &&
+	    release_blocked_readers(rwlock)) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <zephyr/syscalls/k_rwlock_write_lock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+	struct k_thread *thread;
+	bool resched;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	if ((rwlock->writer != _current) ||
+	    ((atomic_get(&rwlock->state) & RWLOCK_WRITER) == 0)) {
+		return -EPERM;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	thread = z_unpend_first_thread(&rwlock->write_wait_q);
+	if (thread != NULL) {
+		grant_writer(rwlock, thread);
+		resched = true;
+	} else {
+		rwlock->writer = NULL;
+		atomic_and(&rwlock->state, ~RWLOCK_WRITERS_WAITING);
+		resched = wake_readers(rwlock);
+	}
+
+	if (resched) {
+		z_reschedule(&rwlock->lock, key);
+	} else {
+		k_spin_unlock(&rwlock->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	K_OOPS(K_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <zephyr/syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#ifdef CONFIG_OBJ_CORE_RWLOCK
+static int init_rwlock_obj_core_list(void)
+{
+	/* Initialize rwlock object type */
+
+	z_obj_type_init(&obj_type_rwlock, K_OBJ_TYPE_RWLOCK_ID,
+			offsetof(struct k_rwlock, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_RWLOCK
+	k_obj_type_stats_init(&obj_type_rwlock, &rwlock_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_RWLOCK */
+
+	/* Initialize and link statically defined rwlocks */
+
+	STRUCT_SECTION_FOREACH(k_rwlock, rwlock) {
+		k_obj_core_init_and_link(K_OBJ_CORE(rwlock), &obj_type_rwlock);
+#ifdef CONFIG_OBJ_CORE_STATS_RWLOCK
+		k_obj_core_stats_register(K_OBJ_CORE(rwlock), &rwlock->stats,
+					  sizeof(struct k_rwlock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_RWLOCK */
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_rwlock_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_RWLOCK */
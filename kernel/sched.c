@@ -61,6 +61,23 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	 */
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
+	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_WORK_STEALING)
+	/* Queue the thread where it last ran (still cache-hot), unless
+	 * its mask has since excluded that CPU.  base.cpu and cpu_mask
+	 * cannot change while the thread sits in a run queue, so this
+	 * is stable between add and remove.
+	 */
+	int cpu = thread->base.cpu;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+
+	if ((m != 0) && ((m & BIT(cpu)) == 0)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 	return &_kernel.cpus[cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
@@ -70,18 +87,26 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+/* Source of base.runq_seq, protected by _sched_spinlock */
+static uint32_t runq_seq;
+#endif /* CONFIG_SCHED_WORK_STEALING */
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 	__ASSERT_NO_MSG(!is_thread_dummy(thread));
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	thread->base.runq_seq = runq_seq++;
+#endif /* CONFIG_SCHED_WORK_STEALING */
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -100,7 +125,37 @@ static ALWAYS_INLINE void runq_yield(void)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int id = _current_cpu->id;
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+
+	/* Each queue keeps equal priority threads in the order they
+	 * were queued, so comparing the queue heads by priority, then
+	 * by base.runq_seq, picks the thread a single global queue
+	 * would have.  The peers are walked starting after our own id
+	 * so that idle CPUs woken together don't all pile onto CPU 0.
+	 */
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		struct _cpu *peer = &_kernel.cpus[(id + i) % num_cpus];
+		struct k_thread *thread = _priq_run_best(&peer->ready_q.runq);
+		int32_t cmp;
+
+		if (thread == NULL) {
+			continue;
+		}
+
+		cmp = (best == NULL) ? 1 : z_sched_prio_cmp(thread, best);
+		if ((cmp > 0) ||
+		    ((cmp == 0) && ((int32_t)(thread->base.runq_seq - best->base.runq_seq) < 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_WORK_STEALING */
 }
 
 /* _current is never in the run queue until context switch on
@@ -345,6 +400,15 @@ static struct _cpu *thread_active_elsewhere(struct k_thread *thread)
 	return NULL;
 }
 
+bool z_thread_is_running(struct k_thread *thread)
+{
+#ifdef CONFIG_SMP
+	return _kernel.cpus[thread->base.cpu].current == thread;
+#else
+	return _kernel.cpus[0].current == thread;
+#endif /* CONFIG_SMP */
+}
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -622,32 +686,36 @@ void z_unpend_thread_no_timeout(struct k_thread *thread)
 	}
 }
 
-void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
+void z_sched_wake_thread_locked(struct k_thread *thread, bool is_timeout)
 {
-	K_SPINLOCK(&_sched_spinlock) {
-		bool killed = (thread->base.thread_state &
-				(_THREAD_DEAD | _THREAD_ABORTING));
+	bool killed = (thread->base.thread_state &
+			(_THREAD_DEAD | _THREAD_ABORTING));
 
 #ifdef CONFIG_EVENTS
-		bool do_nothing = thread->no_wake_on_timeout && is_timeout;
+	bool do_nothing = thread->no_wake_on_timeout && is_timeout;
 
-		thread->no_wake_on_timeout = false;
+	thread->no_wake_on_timeout = false;
 
-		if (do_nothing) {
-			continue;
-		}
+	if (do_nothing) {
+		return;
+	}
 #endif /* CONFIG_EVENTS */
 
-		if (!killed) {
-			/* The thread is not being killed */
-			if (thread->base.pended_on != NULL) {
-				unpend_thread_no_timeout(thread);
-			}
-			z_mark_thread_as_not_sleeping(thread);
-			ready_thread(thread);
+	if (!killed) {
+		/* The thread is not being killed */
+		if (thread->base.pended_on != NULL) {
+			unpend_thread_no_timeout(thread);
 		}
+		z_mark_thread_as_not_sleeping(thread);
+		ready_thread(thread);
 	}
+}
 
+void z_sched_wake_thread(struct k_thread *thread, bool is_timeout)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		z_sched_wake_thread_locked(thread, is_timeout);
+	}
 }
 
 #ifdef CONFIG_SYS_CLOCK_EXISTS
@@ -1007,13 +1075,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1548,6 +1616,32 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+unsigned int z_sched_wake_many(_wait_q_t *wait_q, unsigned int max,
+			       int swap_retval, void *swap_data)
+{
+	struct k_thread *thread;
+	unsigned int woken = 0U;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		while (woken < max) {
+			thread = _priq_wait_best(&wait_q->waitq);
+			if (thread == NULL) {
+				break;
+			}
+
+			z_thread_return_value_set_with_data(thread,
+							    swap_retval,
+							    swap_data);
+			unpend_thread_no_timeout(thread);
+			z_abort_thread_timeout(thread);
+			ready_thread(thread);
+			woken++;
+		}
+	}
+
+	return woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
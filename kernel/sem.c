@@ -129,6 +129,46 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <zephyr/syscalls/k_sem_give_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+void z_impl_k_sem_give_many(struct k_sem *sem, unsigned int count)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	unsigned int woken;
+	unsigned int remaining;
+	bool resched;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give_many, sem, count);
+
+	/* Hand the gives to waiters first, all under one scheduler lock
+	 * acquisition, then bank whatever is left in the count.
+	 */
+	woken = z_sched_wake_many(&sem->wait_q, count, 0, NULL);
+	remaining = count - woken;
+	resched = (woken != 0U);
+
+	if (remaining != 0U) {
+		sem->count += MIN(remaining, sem->limit - sem->count);
+		resched = handle_poll_events(sem) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give_many, sem, count);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_sem_give_many(struct k_sem *sem,
+					  unsigned int count)
+{
+	K_OOPS(K_SYSCALL_OBJ(sem, K_OBJ_SEM));
+	z_impl_k_sem_give_many(sem, count);
+}
+#include <zephyr/syscalls/k_sem_give_many_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret;
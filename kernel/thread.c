@@ -615,6 +615,12 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 
 	/* Initialize various struct k_thread members */
 	z_init_thread_base(&new_thread->base, prio, _THREAD_SLEEPING, options);
+#ifdef CONFIG_SCHED_WORK_STEALING
+	/* Until it first runs, queue the thread on the creating CPU rather
+	 * than having all new threads pile up on CPU 0.
+	 */
+	new_thread->base.cpu = arch_curr_cpu()->id;
+#endif /* CONFIG_SCHED_WORK_STEALING */
 	stack_ptr = setup_thread_stack(new_thread, stack, stack_size);
 
 #ifdef CONFIG_HW_SHADOW_STACK
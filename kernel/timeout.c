@@ -11,21 +11,45 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/seqlock.h>
 #include <zephyr/llext/symbol.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 /*
- * The timeout code shall take no locks other than its own (timeout_lock), nor
- * shall it call any other subsystem while holding this lock.
+ * The timeout code shall take no locks other than its own (timeout_lock and
+ * the per-CPU queue locks), nor shall it call any other subsystem while
+ * holding them.  A queue lock is never held while taking timeout_lock.
  */
 static struct k_spinlock timeout_lock;
 
 /* Ticks left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
 
+#ifdef CONFIG_TIMEOUT_TICK_SEQLOCK
+/* Lets sys_clock_tick_get() sample curr_tick and announce_remaining
+ * without taking timeout_lock.  Only written with timeout_lock held.
+ * The timer driver guarantees that sys_clock_elapsed() may be called
+ * without timeout_lock (CONFIG_SYSTEM_CLOCK_CONCURRENT_ELAPSED).
+ */
+static struct sys_seqlock tick_seqlock;
+#endif /* CONFIG_TIMEOUT_TICK_SEQLOCK */
+
+static ALWAYS_INLINE void tick_write_begin(void)
+{
+#ifdef CONFIG_TIMEOUT_TICK_SEQLOCK
+	sys_seqlock_write_begin(&tick_seqlock);
+#endif /* CONFIG_TIMEOUT_TICK_SEQLOCK */
+}
+
+static ALWAYS_INLINE void tick_write_end(void)
+{
+#ifdef CONFIG_TIMEOUT_TICK_SEQLOCK
+	sys_seqlock_write_end(&tick_seqlock);
+#endif /* CONFIG_TIMEOUT_TICK_SEQLOCK */
+}
+
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 unsigned int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 
@@ -38,29 +62,451 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#define WHEEL_BITS      6
+#define WHEEL_SLOTS     BIT(WHEEL_BITS)
+#define WHEEL_LEVELS    CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS (WHEEL_BITS * WHEEL_LEVELS)
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+struct timeout_q {
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	struct k_spinlock lock;
+	/* Tick of the next event, readable without taking the queue lock */
+	struct sys_seqlock next_seq;
+	uint64_t next;
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	/* Slot lists are only initialized when their occupancy bit gets set */
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	uint64_t occupied[WHEEL_LEVELS];
+	sys_dlist_t overflow;
+	/* Tick up to which the wheel has been cascaded */
+	uint64_t now;
+#else
+	sys_dlist_t list;
+	/* Tick the dticks of the list head is relative to */
+	uint64_t base;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+};
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+#define NUM_TIMEOUT_QS CONFIG_MP_MAX_NUM_CPUS
+#define TIMEOUT_Q_NEXT_INIT .next = UINT64_MAX,
+#else
+#define NUM_TIMEOUT_QS 1
+#define TIMEOUT_Q_NEXT_INIT
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#define TIMEOUT_Q_INIT(i, _) \
+	{ TIMEOUT_Q_NEXT_INIT .overflow = SYS_DLIST_STATIC_INIT(&timeout_qs[i].overflow) }
+#else
+#define TIMEOUT_Q_INIT(i, _) \
+	{ TIMEOUT_Q_NEXT_INIT .list = SYS_DLIST_STATIC_INIT(&timeout_qs[i].list) }
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static struct timeout_q timeout_qs[NUM_TIMEOUT_QS] = {
+	LISTIFY(NUM_TIMEOUT_QS, TIMEOUT_Q_INIT, (,))
+};
+
+static inline struct timeout_q *timeout_q_of(const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	return &timeout_qs[to->cpu];
+#else
+	ARG_UNUSED(to);
+
+	return &timeout_qs[0];
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+/* Queue locks nest inside timeout_lock, which already masks interrupts */
+static inline void timeout_q_acquire(struct timeout_q *q)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	(void)k_spin_lock(&q->lock);
+#else
+	ARG_UNUSED(q);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+static inline void timeout_q_release(struct timeout_q *q)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	k_spin_release(&q->lock);
+#else
+	ARG_UNUSED(q);
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/*
+ * Hierarchical timing wheel.
+ *
+ * Each level has WHEEL_SLOTS slots, and every slot of a level spans a whole
+ * revolution of the level below it.  A timeout is filed in the lowest level
+ * whose current block also contains its expiry tick and is moved down a
+ * level ("cascaded") once the wheel reaches the start of its slot.  Timeouts
+ * too far out for the top level are parked on an unsorted overflow list and
+ * refiled every time the top level wraps.
+ *
+ * Because cascading happens exactly on block boundaries, timeouts expiring
+ * on the same tick still fire in the order they were added.
+ *
+ * With this backend dticks holds the absolute expiry tick rather than the
+ * delta to the preceding timeout.
+ */
+static void wheel_file(struct timeout_q *q, struct _timeout *t)
+{
+	uint64_t expiry = (uint64_t)t->dticks;
+	uint64_t diff = expiry ^ q->now;
+
+	for (unsigned int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int shift = lvl * WHEEL_BITS;
+
+		if ((diff >> (shift + WHEEL_BITS)) == 0U) {
+			unsigned int idx = (expiry >> shift) & (WHEEL_SLOTS - 1U);
+
+			if ((q->occupied[lvl] & BIT64(idx)) == 0U) {
+				sys_dlist_init(&q->slots[lvl][idx]);
+				q->occupied[lvl] |= BIT64(idx);
+			}
+			sys_dlist_append(&q->slots[lvl][idx], &t->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&q->overflow, &t->node);
+}
+
+static void wheel_unfile(struct timeout_q *q, struct _timeout *t)
+{
+	sys_dnode_t *node = &t->node;
+
+	/* The last entry of a slot has the slot list head on both sides */
+	if ((node->next == node->prev) && (node->next != &q->overflow)) {
+		size_t slot = node->next - &q->slots[0][0];
+
+		q->occupied[slot / WHEEL_SLOTS] &= ~BIT64(slot % WHEEL_SLOTS);
+	}
+
+	sys_dlist_remove(node);
+}
+
+/* Tick of the next wheel event: either a level 0 expiry or the start of a
+ * higher level slot that must be cascaded.  *lvl is set to WHEEL_LEVELS
+ * when the event is the wrap-around of the overflow list.
+ */
+static uint64_t wheel_next_event(struct timeout_q *q, unsigned int *lvl, unsigned int *idx)
+{
+	for (*lvl = 0; *lvl < WHEEL_LEVELS; (*lvl)++) {
+		if (q->occupied[*lvl] != 0U) {
+			unsigned int shift = *lvl * WHEEL_BITS;
+			uint64_t block = q->now & ~BIT64_MASK(shift + WHEEL_BITS);
+
+			*idx = u64_count_trailing_zeros(q->occupied[*lvl]);
+
+			return block | ((uint64_t)*idx << shift);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&q->overflow)) {
+		return (q->now | BIT64_MASK(WHEEL_SPAN_BITS)) + 1U;
+	}
+
+	return UINT64_MAX;
+}
+
+static void wheel_cascade(struct timeout_q *q, sys_dlist_t *slot)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	sys_dnode_t *node;
+
+	/* Detach first: overflow entries may be refiled onto the same list */
+	while ((node = sys_dlist_get(slot)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		wheel_file(q, CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Files a timeout expiring at an absolute tick, returns true if the next
+ * event of the queue changed.
+ */
+static bool timeout_q_insert(struct timeout_q *q, struct _timeout *to, uint64_t expiry)
+{
+	unsigned int lvl;
+	unsigned int idx;
+	uint64_t prev_event = wheel_next_event(q, &lvl, &idx);
+
+	to->dticks = max(expiry, q->now);
+	wheel_file(q, to);
+
+	return wheel_next_event(q, &lvl, &idx) != prev_event;
+}
+
+/* Removes a timeout, returns true if the next event of the queue changed */
+static bool timeout_q_remove(struct timeout_q *q, struct _timeout *to)
+{
+	unsigned int lvl;
+	unsigned int idx;
+	uint64_t prev_event = wheel_next_event(q, &lvl, &idx);
+
+	wheel_unfile(q, to);
+
+	return wheel_next_event(q, &lvl, &idx) != prev_event;
+}
+
+/* Absolute tick of the next event of the queue, UINT64_MAX if none */
+static uint64_t timeout_q_next(struct timeout_q *q)
+{
+	unsigned int lvl;
+	unsigned int idx;
+
+	return wheel_next_event(q, &lvl, &idx);
+}
+
+/* Absolute expiry tick of a queued timeout */
+static uint64_t timeout_q_expiry(struct timeout_q *q, const struct _timeout *to)
+{
+	ARG_UNUSED(q);
+
+	return to->dticks;
+}
+
+/* Moves the queue to its next event, returns the timeout expiring there or
+ * NULL if the event was internal to the queue.
+ */
+static struct _timeout *timeout_q_advance(struct timeout_q *q)
+{
+	unsigned int lvl;
+	unsigned int idx;
+
+	q->now = wheel_next_event(q, &lvl, &idx);
+
+	if (lvl == 0U) {
+		sys_dnode_t *t = sys_dlist_peek_head(&q->slots[0][idx]);
+
+		return CONTAINER_OF(t, struct _timeout, node);
+	}
+
+	if (lvl < WHEEL_LEVELS) {
+		q->occupied[lvl] &= ~BIT64(idx);
+		wheel_cascade(q, &q->slots[lvl][idx]);
+	} else {
+		wheel_cascade(q, &q->overflow);
+	}
+
+	return NULL;
+}
+
+/* Dequeues a timeout returned by timeout_q_advance() */
+static void timeout_q_expire(struct timeout_q *q, struct _timeout *t)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	wheel_unfile(q, t);
+}
+
+/* Moves the queue to the given tick, there are no events up to it */
+static void timeout_q_announce_done(struct timeout_q *q, uint64_t tick)
+{
+	q->now = tick;
+}
+
+#ifdef CONFIG_ZTEST
+/* Moves the wheel and all queued timeouts by the given number of ticks */
+static void timeout_q_shift(struct timeout_q *q, int64_t delta)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	sys_dnode_t *node;
+
+	/* Slot by slot, so that timeouts expiring on the same tick keep
+	 * their order.
+	 */
+	for (unsigned int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		while (q->occupied[lvl] != 0U) {
+			unsigned int idx = u64_count_trailing_zeros(q->occupied[lvl]);
+
+			q->occupied[lvl] &= ~BIT64(idx);
+			while ((node = sys_dlist_get(&q->slots[lvl][idx])) != NULL) {
+				sys_dlist_append(&pending, node);
+			}
+		}
+	}
+
+	while ((node = sys_dlist_get(&q->overflow)) != NULL) {
+		sys_dlist_append(&pending, node);
+	}
+
+	q->now += delta;
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		t->dticks += delta;
+		wheel_file(q, t);
+	}
+}
+#endif /* CONFIG_ZTEST */
+
+#else /* CONFIG_TIMEOUT_QUEUE_DLIST */
+
+static struct _timeout *first(struct timeout_q *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_q *q, const struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
+/* Files a timeout expiring at an absolute tick, returns true if the next
+ * event of the queue changed.
+ */
+static bool timeout_q_insert(struct timeout_q *q, struct _timeout *to, uint64_t expiry)
+{
+	struct _timeout *t;
+
+	to->dticks = max(0, (int64_t)(expiry - q->base));
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+
+	return to == first(q);
+}
+
+/* Removes a timeout, returns true if the next event of the queue changed */
+static bool timeout_q_remove(struct timeout_q *q, struct _timeout *to)
+{
+	bool is_first = (to == first(q));
+
+	remove_timeout(q, to);
+
+	return is_first;
+}
+
+/* Absolute tick of the next event of the queue, UINT64_MAX if none */
+static uint64_t timeout_q_next(struct timeout_q *q)
+{
+	struct _timeout *to = first(q);
+
+	return (to == NULL) ? UINT64_MAX : q->base + to->dticks;
+}
+
+/* Absolute expiry tick of a queued timeout */
+static uint64_t timeout_q_expiry(struct timeout_q *q, const struct _timeout *timeout)
+{
+	uint64_t ticks = q->base;
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+/* Moves the queue to its next event, returns the timeout expiring there or
+ * NULL if the event was internal to the queue.
+ */
+static struct _timeout *timeout_q_advance(struct timeout_q *q)
+{
+	return first(q);
+}
+
+/* Dequeues a timeout returned by timeout_q_advance() */
+static void timeout_q_expire(struct timeout_q *q, struct _timeout *t)
+{
+	q->base += t->dticks;
+	t->dticks = 0;
+	remove_timeout(q, t);
+}
+
+/* Moves the queue to the given tick, there are no events up to it */
+static void timeout_q_announce_done(struct timeout_q *q, uint64_t tick)
+{
+	struct _timeout *t = first(q);
+
+	if (t != NULL) {
+		t->dticks -= tick - q->base;
+	}
+	q->base = tick;
+}
+
+#ifdef CONFIG_ZTEST
+/* Moves the queue and all queued timeouts by the given number of ticks */
+static void timeout_q_shift(struct timeout_q *q, int64_t delta)
+{
+	q->base += delta;
+}
+#endif /* CONFIG_ZTEST */
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Makes the next event of a queue visible to next_event(), must be called
+ * with the queue lock held after every change to the queue.
+ */
+static void timeout_q_publish(struct timeout_q *q)
+{
+	sys_seqlock_write_begin(&q->next_seq);
+	q->next = timeout_q_next(q);
+	sys_seqlock_write_end(&q->next_seq);
+}
+
+/* Tick of the next event of a queue, without taking its lock */
+static uint64_t timeout_q_published(struct timeout_q *q)
+{
+	unsigned int seq;
+	uint64_t event;
+
+	do {
+		seq = sys_seqlock_read_begin(&q->next_seq);
+		event = q->next;
+	} while (sys_seqlock_read_retry(&q->next_seq, seq));
+
+	return event;
+}
+#else
+static inline void timeout_q_publish(struct timeout_q *q)
+{
+	ARG_UNUSED(q);
+}
+
+static inline uint64_t timeout_q_published(struct timeout_q *q)
+{
+	return timeout_q_next(q);
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -82,22 +528,116 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+/* Returns the earliest event of all timeout queues and sets *qp to its
+ * queue.  Must be called with timeout_lock held, the queue locks are not
+ * needed.
+ */
+static uint64_t next_event(struct timeout_q **qp)
+{
+	uint64_t event = UINT64_MAX;
+
+	*qp = NULL;
+
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QS; i++) {
+		struct timeout_q *q = &timeout_qs[i];
+		uint64_t q_event = timeout_q_published(q);
+
+		if (q_event < event) {
+			event = q_event;
+			*qp = q;
+		}
+	}
+
+	return event;
+}
+
 static int32_t next_timeout(int32_t ticks_elapsed)
 {
-	struct _timeout *to = first();
+	struct timeout_q *q;
+	uint64_t event = next_event(&q);
+	int64_t dticks = (int64_t)(event - curr_tick) - ticks_elapsed;
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((event == UINT64_MAX) || (dticks > (int64_t)INT_MAX)) {
 		ret = SYS_CLOCK_MAX_WAIT;
 	} else {
-		ret = max(0, to->dticks - ticks_elapsed);
+		ret = max(0, dticks);
 	}
 
 	return ret;
 }
 
-k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Files a timeout on the queue of the current CPU, returns true if the
+ * timer may need to be reprogrammed.
+ */
+static bool add_local_timeout(struct _timeout *to, uint64_t expiry)
+{
+	struct timeout_q *q;
+	bool is_first = false;
+
+	/* Migrating right after reading the CPU id is harmless, the id only
+	 * selects the queue and its lock.
+	 */
+	to->cpu = arch_curr_cpu()->id;
+	q = timeout_q_of(to);
+
+	K_SPINLOCK(&q->lock) {
+		is_first = timeout_q_insert(q, to, expiry);
+		timeout_q_publish(q);
+	}
+
+	return is_first;
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+/* Defers an expiry to the next multiple of the slack, so that timeouts
+ * tolerating the same slack expire on the same tick.
+ */
+static inline uint64_t slack_expiry(uint64_t expiry, k_ticks_t slack)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	if (slack > 1) {
+		expiry = ROUND_UP(expiry, (uint64_t)slack);
+	}
+#else
+	ARG_UNUSED(slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
+	return expiry;
+}
+
+/* Computes the absolute expiry tick of a timeout, sets *ticks to the value
+ * returned by z_add_timeout() and *has_elapsed if *ticks_elapsed was read.
+ * Reads curr_tick, so must be called with timeout_lock held or under
+ * tick_seqlock.
+ */
+static ALWAYS_INLINE uint64_t timeout_expiry(k_timeout_t timeout, k_ticks_t slack,
+					     k_ticks_t *ticks, int32_t *ticks_elapsed,
+					     bool *has_elapsed)
+{
+	uint64_t expiry;
+
+	if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
+		*ticks_elapsed = elapsed();
+		*has_elapsed = true;
+		expiry = curr_tick + timeout.ticks + 1 + *ticks_elapsed;
+		expiry = slack_expiry(expiry, slack);
+		*ticks = expiry;
+	} else {
+		k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+
+		*has_elapsed = false;
+		expiry = curr_tick + max(1, dticks);
+		expiry = slack_expiry(expiry, slack);
+		*ticks = timeout.ticks;
+	}
+
+	return expiry;
+}
+
+static ALWAYS_INLINE k_ticks_t add_timeout(struct _timeout *to, _timeout_func_t fn,
+					   k_timeout_t timeout, k_ticks_t slack)
 {
 	k_ticks_t ticks = 0;
 
@@ -112,37 +652,33 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-		int32_t ticks_elapsed;
-		bool has_elapsed = false;
-
-		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
-			ticks_elapsed = elapsed();
-			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
-		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = max(1, dticks);
-			ticks = timeout.ticks;
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	uint64_t expiry;
+	int32_t ticks_elapsed;
+	bool has_elapsed;
+	unsigned int seq;
+
+	/* timeout_lock is only needed if the timer must be reprogrammed */
+	do {
+		seq = sys_seqlock_read_begin(&tick_seqlock);
+		expiry = timeout_expiry(timeout, slack, &ticks, &ticks_elapsed, &has_elapsed);
+	} while (sys_seqlock_read_retry(&tick_seqlock, seq));
+
+	if (add_local_timeout(to, expiry)) {
+		K_SPINLOCK(&timeout_lock) {
+			if (announce_remaining == 0) {
+				sys_clock_set_timeout(next_timeout(elapsed()), false);
 			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
 		}
+	}
+#else
+	K_SPINLOCK(&timeout_lock) {
+		int32_t ticks_elapsed;
+		bool has_elapsed;
+		uint64_t expiry = timeout_expiry(timeout, slack, &ticks, &ticks_elapsed,
+						 &has_elapsed);
 
-		if (to == first() && announce_remaining == 0) {
+		if (timeout_q_insert(&timeout_qs[0], to, expiry) && (announce_remaining == 0)) {
 			if (!has_elapsed) {
 				/* In case of absolute timeout that is first to expire
 				 * elapsed need to be read from the system clock.
@@ -152,19 +688,51 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 			sys_clock_set_timeout(next_timeout(ticks_elapsed), false);
 		}
 	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 	return ticks;
 }
 
+k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+{
+	return add_timeout(to, fn, timeout, 0);
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+k_ticks_t z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout,
+			      k_ticks_t slack)
+{
+	return add_timeout(to, fn, timeout, slack);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 int z_abort_timeout(struct _timeout *to)
 {
 	int ret = -EINVAL;
+	struct timeout_q *q = timeout_q_of(to);
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	bool is_first = false;
 
+	K_SPINLOCK(&q->lock) {
+		if (sys_dnode_is_linked(&to->node)) {
+			is_first = timeout_q_remove(q, to);
+			timeout_q_publish(q);
+			to->dticks = TIMEOUT_DTICKS_ABORTED;
+			ret = 0;
+		}
+	}
+
+	if (is_first) {
+		K_SPINLOCK(&timeout_lock) {
+			sys_clock_set_timeout(next_timeout(elapsed()), false);
+		}
+	}
+#else
 	K_SPINLOCK(&timeout_lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+			bool is_first = timeout_q_remove(q, to);
 
-			remove_timeout(to);
 			to->dticks = TIMEOUT_DTICKS_ABORTED;
 			ret = 0;
 			if (is_first) {
@@ -172,6 +740,7 @@ int z_abort_timeout(struct _timeout *to)
 			}
 		}
 	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 
 	return ret;
 }
@@ -179,16 +748,14 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
+	struct timeout_q *q = timeout_q_of(timeout);
+	uint64_t expiry;
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
+	timeout_q_acquire(q);
+	expiry = timeout_q_expiry(q, timeout);
+	timeout_q_release(q);
 
-	return ticks;
+	return expiry - curr_tick;
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -230,6 +797,36 @@ int32_t z_get_next_timeout_expiry(void)
 	return ret;
 }
 
+/* Dequeues the earliest timeout expiring within the ticks being announced,
+ * setting *dt to its distance from curr_tick.  Must be called with
+ * timeout_lock held.
+ */
+static struct _timeout *next_expired(int *dt)
+{
+	uint64_t limit = curr_tick + announce_remaining;
+	struct _timeout *t = NULL;
+	struct timeout_q *q;
+
+	while ((t == NULL) && (next_event(&q) <= limit)) {
+		uint64_t event;
+
+		timeout_q_acquire(q);
+		/* Other CPUs may have changed the queue since it was picked */
+		event = timeout_q_next(q);
+		if (event <= limit) {
+			t = timeout_q_advance(q);
+		}
+		if (t != NULL) {
+			*dt = max(0, (int64_t)(event - curr_tick));
+			timeout_q_expire(q, t);
+		}
+		timeout_q_publish(q);
+		timeout_q_release(q);
+	}
+
+	return t;
+}
+
 void sys_clock_announce(int32_t ticks)
 {
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
@@ -241,36 +838,52 @@ void sys_clock_announce(int32_t ticks)
 	 * and return.
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
+		tick_write_begin();
 		announce_remaining += ticks;
+		tick_write_end();
 		k_spin_unlock(&timeout_lock, key);
 		return;
 	}
 
+	tick_write_begin();
 	announce_remaining = ticks;
+	tick_write_end();
 
 	struct _timeout *t;
+	int dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
+	for (t = next_expired(&dt); t != NULL; t = next_expired(&dt)) {
+		tick_write_begin();
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		tick_write_end();
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
+
+		tick_write_begin();
 		announce_remaining -= dt;
+		tick_write_end();
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QS; i++) {
+		struct timeout_q *q = &timeout_qs[i];
+
+		timeout_q_acquire(q);
+		/* A timeout may have been added on another CPU, without
+		 * timeout_lock, since the queue was last checked.  Leave it
+		 * for the next announcement rather than skipping over it.
+		 */
+		timeout_q_announce_done(q, min(curr_tick + announce_remaining,
+					       timeout_q_next(q)));
+		timeout_q_publish(q);
+		timeout_q_release(q);
 	}
 
+	tick_write_begin();
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
+	tick_write_end();
 
 	sys_clock_set_timeout(next_timeout(0), false);
 
@@ -285,9 +898,18 @@ int64_t sys_clock_tick_get(void)
 {
 	uint64_t t = 0U;
 
+#ifdef CONFIG_TIMEOUT_TICK_SEQLOCK
+	unsigned int seq;
+
+	do {
+		seq = sys_seqlock_read_begin(&tick_seqlock);
+		t = curr_tick + elapsed();
+	} while (sys_seqlock_read_retry(&tick_seqlock, seq));
+#else
 	K_SPINLOCK(&timeout_lock) {
 		t = curr_tick + elapsed();
 	}
+#endif /* CONFIG_TIMEOUT_TICK_SEQLOCK */
 	return t;
 }
 
@@ -353,7 +975,22 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
-	curr_tick = tick;
+	K_SPINLOCK(&timeout_lock) {
+		/* The queues track the tick they are at, move them and their
+		 * timeouts along so that these keep the number of ticks they
+		 * had left.
+		 */
+		for (unsigned int i = 0; i < NUM_TIMEOUT_QS; i++) {
+			timeout_q_acquire(&timeout_qs[i]);
+			timeout_q_shift(&timeout_qs[i], (int64_t)(tick - curr_tick));
+			timeout_q_publish(&timeout_qs[i]);
+			timeout_q_release(&timeout_qs[i]);
+		}
+
+		tick_write_begin();
+		curr_tick = tick;
+		tick_write_end();
+	}
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -63,6 +63,16 @@ static inline void z_timer_observer_on_expiry(struct k_timer *timer)
 #define z_timer_observer_on_expiry(timer) (void)0
 #endif /* CONFIG_TIMER_OBSERVER */
 
+static inline void timer_add_timeout(struct k_timer *timer, k_timeout_t timeout)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	z_add_timeout_slack(&timer->timeout, z_timer_expiration_handler,
+			    timeout, timer->slack);
+#else
+	z_add_timeout(&timer->timeout, z_timer_expiration_handler, timeout);
+#endif /* CONFIG_TIMEOUT_SLACK */
+}
+
 /**
  * @brief Handle expiration of a kernel timer object.
  *
@@ -117,8 +127,7 @@ void z_timer_expiration_handler(struct _timeout *t)
 		 */
 		next = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + 1 + next.ticks);
 #endif /* CONFIG_TIMEOUT_64BIT */
-		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-			      next);
+		timer_add_timeout(timer, next);
 	}
 
 	/* update timer's status */
@@ -180,6 +189,10 @@ void k_timer_init(struct k_timer *timer,
 
 	timer->user_data = NULL;
 
+#ifdef CONFIG_TIMEOUT_SLACK
+	timer->slack = 0;
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 	k_object_init(timer);
 
 #ifdef CONFIG_OBJ_CORE_TIMER
@@ -233,8 +246,7 @@ void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
 	timer->period = period;
 	timer->status = 0U;
 
-	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-		     duration);
+	timer_add_timeout(timer, duration);
 
 	z_timer_observer_on_start(timer, duration, period);
 
@@ -291,6 +303,31 @@ static inline void z_vrfy_k_timer_stop(struct k_timer *timer)
 #include <zephyr/syscalls/k_timer_stop_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void z_impl_k_timer_slack_set(struct k_timer *timer, k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(Z_IS_TIMEOUT_RELATIVE(slack));
+	__ASSERT_NO_MSG(!K_TIMEOUT_EQ(slack, K_FOREVER));
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	timer->slack = slack.ticks;
+
+	k_spin_unlock(&lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer, k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	K_OOPS(K_SYSCALL_VERIFY(Z_IS_TIMEOUT_RELATIVE(slack) &&
+				!K_TIMEOUT_EQ(slack, K_FOREVER)));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <zephyr/syscalls/k_timer_slack_set_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 uint32_t z_impl_k_timer_status_get(struct k_timer *timer)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
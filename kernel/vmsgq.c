@@ -0,0 +1,479 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Variable-size message queue kernel object.
+ *
+ * Messages are laid out back to back in a ring of 32-bit words, each one
+ * behind a header word holding its length and its state. A message that
+ * does not fit before the end of the ring is placed at its start, behind
+ * a padding header covering the words left at the end.
+ *
+ * Three indices walk the ring in the same direction: wr_idx where the next
+ * message is allocated, claim_idx where the next message is claimed, and
+ * rd_idx behind which space is free again. Messages are claimed in the
+ * order they were allocated, once committed, but can be freed in any
+ * order: rd_idx only moves past a run of freed messages.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <errno.h>
+#include <string.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/init.h>
+
+#define HDR_LEN_MASK     BIT_MASK(28)
+#define HDR_STATE_SHIFT  28
+#define HDR_STATE(hdr)   ((hdr) >> HDR_STATE_SHIFT)
+#define HDR(state, len)  (((uint32_t)(state) << HDR_STATE_SHIFT) | (uint32_t)(len))
+
+enum vmsg_state {
+	VMSG_ALLOCATED,
+	VMSG_COMMITTED,
+	VMSG_CLAIMED,
+	VMSG_FREED,
+	VMSG_PADDING,
+};
+
+#ifdef CONFIG_OBJ_CORE_VMSGQ
+static struct k_obj_type obj_type_vmsgq;
+#endif /* CONFIG_OBJ_CORE_VMSGQ */
+
+static inline uint32_t msg_words(size_t len)
+{
+	return 1 + DIV_ROUND_UP(len, sizeof(uint32_t));
+}
+
+static inline uint32_t idx_add(struct k_vmsgq *vmsgq, uint32_t idx, uint32_t words)
+{
+	idx += words;
+
+	return (idx == vmsgq->size) ? 0 : idx;
+}
+
+/*
+ * Words taken by the message at idx, never past the end of the ring: a
+ * queue initialized from user mode has its headers in memory its owner
+ * can write.
+ */
+static inline uint32_t hdr_words(struct k_vmsgq *vmsgq, uint32_t idx)
+{
+	return MIN(msg_words(vmsgq->buffer[idx] & HDR_LEN_MASK), vmsgq->size - idx);
+}
+
+static inline uint32_t *msg_hdr(struct k_vmsgq *vmsgq, void *msg)
+{
+	uint32_t *hdr = (uint32_t *)msg - 1;
+
+	__ASSERT((hdr >= vmsgq->buffer) && (hdr < &vmsgq->buffer[vmsgq->size]),
+		 "message %p not in queue %p", msg, vmsgq);
+
+	return hdr;
+}
+
+void z_impl_k_vmsgq_init(struct k_vmsgq *vmsgq, void *buffer, size_t buffer_size)
+{
+	__ASSERT(IS_ALIGNED(buffer, sizeof(uint32_t)), "buffer not 4-byte aligned");
+
+	vmsgq->buffer = buffer;
+	vmsgq->size = buffer_size / sizeof(uint32_t);
+	vmsgq->wr_idx = 0;
+	vmsgq->rd_idx = 0;
+	vmsgq->claim_idx = 0;
+	vmsgq->used = 0;
+	vmsgq->unclaimed = 0;
+	vmsgq->lock = (struct k_spinlock) {};
+	z_waitq_init(&vmsgq->put_wait_q);
+	z_waitq_init(&vmsgq->get_wait_q);
+
+#ifdef CONFIG_OBJ_CORE_VMSGQ
+	k_obj_core_init_and_link(K_OBJ_CORE(vmsgq), &obj_type_vmsgq);
+#endif /* CONFIG_OBJ_CORE_VMSGQ */
+
+	SYS_PORT_TRACING_OBJ_INIT(k_vmsgq, vmsgq);
+
+	k_object_init(vmsgq);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_vmsgq_init(struct k_vmsgq *vmsgq, void *buffer, size_t buffer_size)
+{
+	K_OOPS(K_SYSCALL_OBJ_NEVER_INIT(vmsgq, K_OBJ_VMSGQ));
+	K_OOPS(K_SYSCALL_VERIFY_MSG(IS_ALIGNED(buffer, sizeof(uint32_t)),
+				    "buffer not 4-byte aligned"));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(buffer, buffer_size));
+
+	z_impl_k_vmsgq_init(vmsgq, buffer, buffer_size);
+}
+#include <zephyr/syscalls/k_vmsgq_init_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+/* Reserve space for a message, with the lock held. */
+static void *try_alloc(struct k_vmsgq *vmsgq, size_t len)
+{
+	uint32_t words = msg_words(len);
+	uint32_t tail;
+	uint32_t *hdr;
+
+	if (vmsgq->used == 0) {
+		/* Empty: restart from the beginning for the most contiguous space */
+		vmsgq->wr_idx = 0;
+		vmsgq->rd_idx = 0;
+		vmsgq->claim_idx = 0;
+	}
+
+	tail = vmsgq->size - vmsgq->wr_idx;
+	if (words > tail) {
+		/* Pad the end of the ring and start over, if that makes room */
+		if (vmsgq->used + tail + words > vmsgq->size) {
+			return NULL;
+		}
+		vmsgq->buffer[vmsgq->wr_idx] = HDR(VMSG_PADDING, 0);
+		vmsgq->used += tail;
+		vmsgq->unclaimed += tail;
+		vmsgq->wr_idx = 0;
+	} else if (vmsgq->used + words > vmsgq->size) {
+		return NULL;
+	}
+
+	hdr = &vmsgq->buffer[vmsgq->wr_idx];
+	*hdr = HDR(VMSG_ALLOCATED, len);
+	vmsgq->wr_idx = idx_add(vmsgq, vmsgq->wr_idx, words);
+	vmsgq->used += words;
+	vmsgq->unclaimed += words;
+
+	return hdr + 1;
+}
+
+/*
+ * Claim the oldest message, with the lock held. Returns -ENOMSG when there
+ * is no committed message to claim.
+ */
+static int try_claim(struct k_vmsgq *vmsgq, void **msg, size_t *len, size_t max_len)
+{
+	uint32_t *hdr;
+
+	while (vmsgq->unclaimed != 0) {
+		hdr = &vmsgq->buffer[vmsgq->claim_idx];
+
+		switch (HDR_STATE(*hdr)) {
+		case VMSG_PADDING:
+			vmsgq->unclaimed -= vmsgq->size - vmsgq->claim_idx;
+			vmsgq->claim_idx = 0;
+			continue;
+		case VMSG_COMMITTED:
+			break;
+		default:
+			/* The oldest message is still being written */
+			return -ENOMSG;
+		}
+
+		*len = *hdr & HDR_LEN_MASK;
+		if (msg_words(*len) > vmsgq->size - vmsgq->claim_idx) {
+			/* Header overwritten through the buffer */
+			return -EIO;
+		}
+
+		if (*len > max_len) {
+			return -EMSGSIZE;
+		}
+
+		*hdr = HDR(VMSG_CLAIMED, *len);
+		*msg = hdr + 1;
+		vmsgq->claim_idx = idx_add(vmsgq, vmsgq->claim_idx, msg_words(*len));
+		vmsgq->unclaimed -= msg_words(*len);
+
+		return 0;
+	}
+
+	return -ENOMSG;
+}
+
+/* True if the oldest unclaimed message is committed, with the lock held. */
+static bool claimable(struct k_vmsgq *vmsgq)
+{
+	uint32_t idx = vmsgq->claim_idx;
+
+	if (vmsgq->unclaimed == 0) {
+		return false;
+	}
+
+	if (HDR_STATE(vmsgq->buffer[idx]) == VMSG_PADDING) {
+		if (vmsgq->unclaimed == vmsgq->size - idx) {
+			return false;
+		}
+		idx = 0;
+	}
+
+	return HDR_STATE(vmsgq->buffer[idx]) == VMSG_COMMITTED;
+}
+
+int k_vmsgq_alloc(struct k_vmsgq *vmsgq, size_t len, void **msg, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	bool no_wait = K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_timeout_t wait = timeout;
+	k_spinlock_key_t key;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_vmsgq, alloc, vmsgq, len, timeout);
+
+	if ((len > HDR_LEN_MASK) || (msg_words(len) > vmsgq->size)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_vmsgq, alloc, vmsgq, timeout, -EMSGSIZE);
+
+		return -EMSGSIZE;
+	}
+
+	key = k_spin_lock(&vmsgq->lock);
+
+	for (;;) {
+		*msg = try_alloc(vmsgq, len);
+		if (*msg != NULL) {
+			result = 0;
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = no_wait ? -ENOMSG : -EAGAIN;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_vmsgq, alloc, vmsgq, timeout);
+
+		/* Woken up whenever space is freed, try again */
+		result = z_pend_curr(&vmsgq->lock, key, &vmsgq->put_wait_q, timeout);
+		key = k_spin_lock(&vmsgq->lock);
+		if (result != 0) {
+			break;
+		}
+	}
+
+	k_spin_unlock(&vmsgq->lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_vmsgq, alloc, vmsgq, wait, result);
+
+	return result;
+}
+
+void k_vmsgq_commit(struct k_vmsgq *vmsgq, void *msg)
+{
+	uint32_t *hdr = msg_hdr(vmsgq, msg);
+	k_spinlock_key_t key = k_spin_lock(&vmsgq->lock);
+
+	__ASSERT(HDR_STATE(*hdr) == VMSG_ALLOCATED, "message %p not allocated", msg);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_vmsgq, commit, vmsgq, msg);
+
+	*hdr = HDR(VMSG_COMMITTED, *hdr & HDR_LEN_MASK);
+
+	if (claimable(vmsgq) && z_sched_wake(&vmsgq->get_wait_q, 0, NULL)) {
+		z_reschedule(&vmsgq->lock, key);
+		return;
+	}
+
+	k_spin_unlock(&vmsgq->lock, key);
+}
+
+static int vmsgq_claim(struct k_vmsgq *vmsgq, void **msg, size_t *len, size_t max_len,
+		       k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	bool no_wait = K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&vmsgq->lock);
+	int result;
+
+	for (;;) {
+		result = try_claim(vmsgq, msg, len, max_len);
+		if (result != -ENOMSG) {
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = no_wait ? -ENOMSG : -EAGAIN;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_vmsgq, claim, vmsgq, timeout);
+
+		/* Woken up whenever a message becomes claimable, try again */
+		result = z_pend_curr(&vmsgq->lock, key, &vmsgq->get_wait_q, timeout);
+		key = k_spin_lock(&vmsgq->lock);
+		if (result != 0) {
+			break;
+		}
+	}
+
+	/*
+	 * A commit only wakes one consumer, which may have found the oldest
+	 * message still being written. Pass the wakeup on if more messages
+	 * are ready, so that none is left behind with consumers waiting.
+	 */
+	if (claimable(vmsgq) && z_sched_wake(&vmsgq->get_wait_q, 0, NULL)) {
+		z_reschedule(&vmsgq->lock, key);
+	} else {
+		k_spin_unlock(&vmsgq->lock, key);
+	}
+
+	return result;
+}
+
+int k_vmsgq_claim(struct k_vmsgq *vmsgq, void **msg, size_t *len, k_timeout_t timeout)
+{
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_vmsgq, claim, vmsgq, timeout);
+
+	result = vmsgq_claim(vmsgq, msg, len, SIZE_MAX, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_vmsgq, claim, vmsgq, timeout, result);
+
+	return result;
+}
+
+void k_vmsgq_free(struct k_vmsgq *vmsgq, void *msg)
+{
+	uint32_t *hdr = msg_hdr(vmsgq, msg);
+	uint32_t state, words;
+	bool freed = false;
+	k_spinlock_key_t key = k_spin_lock(&vmsgq->lock);
+
+	__ASSERT(HDR_STATE(*hdr) == VMSG_CLAIMED, "message %p not claimed", msg);
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_vmsgq, free, vmsgq, msg);
+
+	*hdr = HDR(VMSG_FREED, *hdr & HDR_LEN_MASK);
+
+	/* Release the run of freed messages behind the oldest claimed one */
+	while (vmsgq->used > vmsgq->unclaimed) {
+		hdr = &vmsgq->buffer[vmsgq->rd_idx];
+		state = HDR_STATE(*hdr);
+
+		if (state == VMSG_PADDING) {
+			words = vmsgq->size - vmsgq->rd_idx;
+		} else if (state == VMSG_FREED) {
+			words = hdr_words(vmsgq, vmsgq->rd_idx);
+		} else {
+			break;
+		}
+
+		vmsgq->rd_idx = idx_add(vmsgq, vmsgq->rd_idx, words);
+		vmsgq->used -= words;
+		freed = true;
+	}
+
+	if (freed && z_sched_wake_all(&vmsgq->put_wait_q, 0, NULL)) {
+		z_reschedule(&vmsgq->lock, key);
+		return;
+	}
+
+	k_spin_unlock(&vmsgq->lock, key);
+}
+
+int z_impl_k_vmsgq_put(struct k_vmsgq *vmsgq, const void *data, size_t len,
+		       k_timeout_t timeout)
+{
+	void *msg;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_vmsgq, put, vmsgq, timeout);
+
+	result = k_vmsgq_alloc(vmsgq, len, &msg, timeout);
+	if (result == 0) {
+		/* The message is ours until committed, copy without the lock */
+		memcpy(msg, data, len);
+		k_vmsgq_commit(vmsgq, msg);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_vmsgq, put, vmsgq, timeout, result);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_vmsgq_put(struct k_vmsgq *vmsgq, const void *data, size_t len,
+				     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(vmsgq, K_OBJ_VMSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_READ(data, len));
+
+	return z_impl_k_vmsgq_put(vmsgq, data, len, timeout);
+}
+#include <zephyr/syscalls/k_vmsgq_put_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_vmsgq_get(struct k_vmsgq *vmsgq, void *data, size_t size, k_timeout_t timeout)
+{
+	void *msg;
+	size_t len;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_vmsgq, get, vmsgq, timeout);
+
+	result = vmsgq_claim(vmsgq, &msg, &len, size, timeout);
+	if (result == 0) {
+		/* The message is ours until freed, copy without the lock */
+		memcpy(data, msg, len);
+		k_vmsgq_free(vmsgq, msg);
+		result = (int)len;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_vmsgq, get, vmsgq, timeout, result);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_vmsgq_get(struct k_vmsgq *vmsgq, void *data, size_t size,
+				     k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(vmsgq, K_OBJ_VMSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, size));
+
+	return z_impl_k_vmsgq_get(vmsgq, data, size, timeout);
+}
+#include <zephyr/syscalls/k_vmsgq_get_mrsh.c>
+
+static inline uint32_t z_vrfy_k_vmsgq_free_space_get(struct k_vmsgq *vmsgq)
+{
+	K_OOPS(K_SYSCALL_OBJ(vmsgq, K_OBJ_VMSGQ));
+
+	return z_impl_k_vmsgq_free_space_get(vmsgq);
+}
+#include <zephyr/syscalls/k_vmsgq_free_space_get_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#ifdef CONFIG_OBJ_CORE_VMSGQ
+static int init_vmsgq_obj_core_list(void)
+{
+	/* Initialize variable-size message queue object type */
+
+	z_obj_type_init(&obj_type_vmsgq, K_OBJ_TYPE_VMSGQ_ID,
+			offsetof(struct k_vmsgq, obj_core));
+
+	/* Initialize and link statically defined message queues */
+
+	STRUCT_SECTION_FOREACH(k_vmsgq, vmsgq) {
+		k_obj_core_init_and_link(K_OBJ_CORE(vmsgq), &obj_type_vmsgq);
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_vmsgq_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_VMSGQ */
@@ -192,6 +192,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 				 struct z_work_flusher *flusher)
 {
 	init_flusher(flusher);
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	flusher->target = work;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 
 	if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
 		sys_slist_insert(&queue->pending, &work->node,
@@ -216,6 +219,26 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 	}
 }
 
+/* Check whether a thread animates a work queue.
+ *
+ * @param queue the queue to check
+ * @param thread the thread to look for
+ *
+ * @return true if and only if @p thread processes the work of @p queue.
+ */
+static inline bool is_queue_thread(const struct k_work_q *queue,
+				   const struct k_thread *thread)
+{
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (queue->workers != NULL) {
+		return (thread >= queue->workers)
+			&& (thread < &queue->workers[queue->num_workers]);
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
+	return thread == queue->thread_id;
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -265,7 +288,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == queue->thread_id) && !k_is_in_isr();
+	bool chained = is_queue_thread(queue, _current) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -648,6 +671,118 @@ static void work_timeout_stop_locked(struct k_work_q *queue)
 }
 #endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+/* Check whether a pending work item must stay on the queue for now.
+ *
+ * With several worker threads, an item that is running on one of them
+ * is left queued until its handler returns so that it doesn't run
+ * re-entrantly, and so is a flusher for an item that is running.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the pending work item
+ */
+static bool work_blocked_locked(struct k_work *work)
+{
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		struct z_work_flusher *flusher
+			= CONTAINER_OF(work, struct z_work_flusher, work);
+
+		work = flusher->target;
+	}
+
+	return flag_test(&work->flags, K_WORK_RUNNING_BIT);
+}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
+/* Remove the next work item to process from the pending list.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue from which work should be taken
+ *
+ * @return the node of the work item, or null if no item can run now.
+ */
+static sys_snode_t *pending_get_locked(struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (queue->workers != NULL) {
+		sys_snode_t *prev = NULL;
+		sys_snode_t *node;
+
+		SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+			if (!work_blocked_locked(CONTAINER_OF(node, struct k_work, node))) {
+				sys_slist_remove(&queue->pending, prev, node);
+				return node;
+			}
+			prev = node;
+		}
+
+		return NULL;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
+	return sys_slist_get(&queue->pending);
+}
+
+/* Record that a work queue thread starts or stops running a work item.
+ *
+ * The BUSY flag stays set as long as any thread of the queue is running
+ * an item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_set_locked(struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	queue->num_busy++;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+	flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+static inline void queue_busy_clear_locked(struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (--queue->num_busy != 0U) {
+		return;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+	flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+/* Let the calling thread exit a work queue that has been stopped.
+ *
+ * With several worker threads, the one identified by thread_id exits
+ * last, so that joining it waits for all of them.  It is also the one
+ * that clears the status flags.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue being stopped
+ *
+ * @retval true if the calling thread must exit
+ * @retval false if it must wait for other threads to exit first
+ */
+static bool work_queue_exit_locked(struct k_work_q *queue)
+{
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if (queue->num_threads > 1U) {
+		if (_current == queue->thread_id) {
+			/* Make sure the other workers see the request */
+			(void)z_sched_wake_all(&queue->notifyq, 0, NULL);
+			return false;
+		}
+
+		queue->num_threads--;
+		(void)z_sched_wake_all(&queue->notifyq, 0, NULL);
+		return true;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
+	flags_set(&queue->flags, 0);
+	return true;
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -664,15 +799,18 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
+		bool idle;
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = pending_get_locked(queue);
+		idle = sys_slist_is_empty(&queue->pending)
+			&& !flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			queue_busy_set_locked(queue);
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -690,8 +828,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		} else if (idle && flag_test_and_clear(&queue->flags,
+						       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -702,12 +840,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * submissions.
 			 */
 			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
-		} else if (flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
+		} else if (idle && flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
 			/* User has requested that the queue stop. Clear the status flags and exit.
 			 */
-			flags_set(&queue->flags, 0);
-			k_spin_unlock(&lock, key);
-			return;
+			if (work_queue_exit_locked(queue)) {
+				k_spin_unlock(&lock, key);
+				return;
+			}
 		} else {
 			/* No work is available and no queue state requires
 			 * special handling.
@@ -755,7 +894,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue_busy_clear_locked(queue);
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+		/* Items left queued while this one was running may now be
+		 * processed by another worker.
+		 */
+		if ((queue->workers != NULL) && !sys_slist_is_empty(&queue->pending)) {
+			(void)notify_queue_locked(queue);
+		}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -804,6 +951,15 @@ void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	/* The queue may have been run by workers before it was stopped */
+	queue->workers = NULL;
+	queue->num_workers = 0U;
+	queue->num_threads = 0U;
+	queue->num_busy = 0U;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 	queue->thread_id = _current;
 	flags_set(&queue->flags, flags);
 	work_queue_main(queue, NULL, NULL);
@@ -831,6 +987,14 @@ void k_work_queue_start(struct k_work_q *queue,
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	/* The queue may have been run by workers before it was stopped */
+	queue->workers = NULL;
+	queue->num_workers = 0U;
+	queue->num_threads = 0U;
+	queue->num_busy = 0U;
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 	/* It hasn't actually been started yet, but all the state is in place
 	 * so we can submit things and once the thread gets control it's ready
 	 * to roll.
@@ -863,6 +1027,76 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+void k_work_queue_start_workers(struct k_work_q *queue,
+				struct k_thread *threads,
+				k_thread_stack_t *stacks,
+				size_t num_threads,
+				size_t stack_size,
+				int prio,
+				const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(threads);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG((num_threads > 0) && (num_threads <= UINT16_MAX));
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	uint32_t flags = K_WORK_QUEUE_STARTED;
+	size_t stride = K_THREAD_STACK_LEN(stack_size);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+
+	if ((cfg != NULL) && cfg->no_yield) {
+		flags |= K_WORK_QUEUE_NO_YIELD;
+	}
+
+#if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
+	/* A single timeout record can't track the items of several threads */
+	queue->work_timeout = K_FOREVER;
+#endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+	queue->workers = threads;
+	queue->num_workers = (uint16_t)num_threads;
+	queue->num_threads = (uint16_t)num_threads;
+	queue->num_busy = 0U;
+	queue->thread_id = &threads[0];
+	flags_set(&queue->flags, flags);
+
+	for (size_t i = 0; i < num_threads; i++) {
+		struct k_thread *thread = &threads[i];
+
+		(void)k_thread_create(thread, &stacks[stride * i], stack_size,
+				      work_queue_main, queue, NULL, NULL,
+				      prio, 0, K_FOREVER);
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(thread, cfg->name);
+		}
+
+		if ((cfg != NULL) && (cfg->essential)) {
+			thread->base.user_options |= K_ESSENTIAL;
+		}
+
+#if defined(CONFIG_SCHED_CPU_MASK)
+		if ((cfg != NULL) && cfg->pin_workers) {
+			(void)k_thread_cpu_pin(thread, (int)(i % arch_num_cpus()));
+		}
+#endif /* defined(CONFIG_SCHED_CPU_MASK) */
+	}
+
+	for (size_t i = 0; i < num_threads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -925,6 +1159,12 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 		return -ENOTSUP;
 	}
 
+#if defined(CONFIG_WORKQUEUE_WORKERS)
+	if ((queue->workers != NULL) && z_is_thread_essential(queue->thread_id)) {
+		return -ENOTSUP;
+	}
+#endif /* defined(CONFIG_WORKQUEUE_WORKERS) */
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
@@ -999,6 +1239,22 @@ void k_work_init_delayable(struct k_work_delayable *dwork,
 	SYS_PORT_TRACING_OBJ_INIT(k_work_delayable, dwork);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+				k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(dwork != NULL);
+	__ASSERT_NO_MSG(Z_IS_TIMEOUT_RELATIVE(slack));
+	__ASSERT_NO_MSG(!K_TIMEOUT_EQ(slack, K_FOREVER));
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	dwork->slack = slack.ticks;
+
+	k_spin_unlock(&lock, key);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static inline int work_delayable_busy_get_locked(const struct k_work_delayable *dwork)
 {
 	return flags_get(&dwork->work.flags) & K_WORK_MASK;
@@ -1053,7 +1309,11 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	dwork->queue = *queuep;
 
 	/* Add timeout */
+#ifdef CONFIG_TIMEOUT_SLACK
+	z_add_timeout_slack(&dwork->timeout, work_timeout, delay, dwork->slack);
+#else
 	z_add_timeout(&dwork->timeout, work_timeout, delay);
+#endif /* CONFIG_TIMEOUT_SLACK */
 
 	return ret;
 }
@@ -37,11 +37,11 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_bucket_avail(h, bidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +70,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -208,6 +208,56 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int bi = bucket_fit_idx(h, sz);
+	uint32_t *sl_avail = sl_bitmaps(h);
+	chunkid_t c;
+
+	/* Every chunk from the bucket "sz" was rounded up to, or from
+	 * any larger bucket, fits.  Find the first non-empty one with a
+	 * bit scan of its level's bitmap, or of the first level bitmap
+	 * and then of the level found, and take its first chunk.
+	 */
+	if (bi <= bucket_idx(h, h->end_chunk)) {
+		int fl = bi >> SL_LOG2;
+		uint32_t slmask = sl_avail[fl] & ~BIT_MASK(bi & (SL_COUNT - 1));
+
+		if (slmask == 0U) {
+			uint32_t flmask = h->avail_buckets & ~BIT_MASK(fl + 1);
+
+			if (flmask != 0U) {
+				fl = __builtin_ctz(flmask);
+				slmask = sl_avail[fl];
+			}
+		}
+
+		if (slmask != 0U) {
+			bi = (fl << SL_LOG2) + __builtin_ctz(slmask);
+			c = h->buckets[bi].next;
+
+			free_list_remove_bidx(h, c, bi);
+			CHECK(chunk_size(h, c) >= sz);
+			return c;
+		}
+	}
+
+	/* Otherwise the first chunk of the bucket "sz" itself belongs
+	 * to may still be large enough.  Looking at that one only keeps
+	 * the allocation time constant.
+	 */
+	bi = bucket_idx(h, sz);
+	c = h->buckets[bi].next;
+
+	if (c != 0U && chunk_size(h, c) >= sz) {
+		free_list_remove_bidx(h, c, bi);
+		return c;
+	}
+
+	return 0;
+}
+#else
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -259,6 +309,7 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 
 	return 0;
 }
+#endif /* CONFIG_SYS_HEAP_TLSF */
 
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
@@ -562,8 +613,14 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 #endif
 
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
-	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+	size_t meta_bytes = sizeof(struct z_heap) +
+			    nb_buckets * sizeof(struct z_heap_bucket);
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+	meta_bytes += nb_first_levels(h) * sizeof(uint32_t);
+#endif
+
+	chunksz_t chunk0_size = chunksz(meta_bytes);
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
@@ -571,6 +628,12 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	for (int i = 0; i < nb_first_levels(h); i++) {
+		sl_bitmaps(h)[i] = 0;
+	}
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
@@ -41,9 +41,10 @@
  *   FREE_NEXT: Chunk ID of the next node in a free list.
  *
  * The free lists are circular lists, one for each power-of-two size
- * category.  The free list pointers exist only for free chunks,
- * obviously.  This memory is part of the user's buffer when
- * allocated.
+ * category (or, with CONFIG_SYS_HEAP_TLSF, for each of the linear
+ * subdivisions of such a category, see bucket_idx()).  The free list
+ * pointers exist only for free chunks, obviously.  This memory is part
+ * of the user's buffer when allocated.
  *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
@@ -65,6 +66,11 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+/* With CONFIG_SYS_HEAP_TLSF, avail_buckets has one bit per first
+ * level (i.e. per group of SL_COUNT buckets) and the per-level
+ * bitmaps of non-empty buckets follow the buckets array, see
+ * sl_bitmaps().
+ */
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -258,12 +264,117 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+
+#define SL_LOG2 CONFIG_SYS_HEAP_TLSF_SL_LOG2
+#define SL_COUNT BIT(SL_LOG2)
+
+/* Two-level segregated fit: usable sizes below 2 * SL_COUNT units get
+ * one bucket each, above that every power-of-two range is split into
+ * SL_COUNT buckets of equal width.  Bucket numbers grow with the size
+ * and bucket "bidx" is list "bidx % SL_COUNT" of first level
+ * "bidx / SL_COUNT".
+ */
+static inline int usable_bucket_idx(unsigned int usable_sz)
+{
+	int fl = 31 - __builtin_clz(usable_sz);
+
+	if (fl <= SL_LOG2) {
+		return usable_sz;
+	}
+	return ((fl - SL_LOG2) << SL_LOG2) + (usable_sz >> (fl - SL_LOG2));
+}
+
+static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
+{
+	return usable_bucket_idx(sz - min_chunk_size(h) + 1);
+}
+
+/* The first bucket all chunks of which are at least "sz" units */
+static inline int bucket_fit_idx(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int fl = 31 - __builtin_clz(usable_sz);
+
+	if (fl > SL_LOG2) {
+		usable_sz += BIT(fl - SL_LOG2) - 1;
+	}
+	return usable_bucket_idx(usable_sz);
+}
+
+/* Smallest chunk size stored in a bucket */
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	int fl = bidx >> SL_LOG2;
+	unsigned int usable_sz = bidx;
+
+	if (fl > 1) {
+		usable_sz = (SL_COUNT + (bidx & (SL_COUNT - 1))) << (fl - 1);
+	}
+	return usable_sz - 1 + min_chunk_size(h);
+}
+
+static inline int nb_first_levels(struct z_heap *h)
+{
+	return (bucket_idx(h, h->end_chunk) >> SL_LOG2) + 1;
+}
+
+static inline uint32_t *sl_bitmaps(struct z_heap *h)
+{
+	return (uint32_t *)&h->buckets[bucket_idx(h, h->end_chunk) + 1];
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (sl_bitmaps(h)[bidx >> SL_LOG2] & BIT(bidx & (SL_COUNT - 1))) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	int fl = bidx >> SL_LOG2;
+	uint32_t *sl = &sl_bitmaps(h)[fl];
+
+	if (avail) {
+		*sl |= BIT(bidx & (SL_COUNT - 1));
+		h->avail_buckets |= BIT(fl);
+	} else {
+		*sl &= ~BIT(bidx & (SL_COUNT - 1));
+		if (*sl == 0U) {
+			h->avail_buckets &= ~BIT(fl);
+		}
+	}
+}
+
+#else
+
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
 	return 31 - __builtin_clz(usable_sz);
 }
 
+/* Smallest chunk size stored in a bucket */
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	return (1 << bidx) - 1 + min_chunk_size(h);
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (h->avail_buckets & BIT(bidx)) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	if (avail) {
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_buckets &= ~BIT(bidx);
+	}
+}
+
+#endif /* CONFIG_SYS_HEAP_TLSF */
+
 static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
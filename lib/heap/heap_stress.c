@@ -127,8 +127,12 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	for (uint32_t i = 0; i < op_count; i++) {
 		if (rand_alloc_choice(&sr)) {
 			size_t sz = rand_alloc_size(&sr);
+			uint32_t start = k_cycle_get_32();
 			void *p = sr.alloc_fn(sr.arg, sz);
+			uint32_t cycles = k_cycle_get_32() - start;
 
+			result->max_alloc_cycles = max(result->max_alloc_cycles, cycles);
+			result->accumulated_alloc_cycles += cycles;
 			result->total_allocs++;
 			if (p != NULL) {
 				result->successful_allocs++;
@@ -146,7 +150,15 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
 			sr.blocks_alloced--;
 			sr.bytes_alloced -= sz;
+
+			uint32_t start = k_cycle_get_32();
+
 			sr.free_fn(sr.arg, p);
+
+			uint32_t cycles = k_cycle_get_32() - start;
+
+			result->max_free_cycles = max(result->max_free_cycles, cycles);
+			result->accumulated_free_cycles += cycles;
 		}
 		result->accumulated_in_use_bytes += sr.bytes_alloced;
 	}
@@ -137,13 +137,287 @@ malloc_unlock(void)
 #define malloc_unlock()
 #endif
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+
+/*
+ * Small requests are rounded up to a power of two size class. Each CPU
+ * keeps a bin of free blocks per class, linked through their first word
+ * and protected by a spinlock that only other CPUs reclaiming the caches
+ * ever contend on. Lock order is the heap mutex, then a cache lock.
+ */
+
+#define CACHE_CLASSES	CONFIG_COMMON_LIBC_MALLOC_CACHE_CLASSES
+#define CACHE_DEPTH	CONFIG_COMMON_LIBC_MALLOC_CACHE_DEPTH
+#define CACHE_BATCH	(CACHE_DEPTH / 2)
+#define CLASS_MIN_SHIFT	4
+#define CLASS_SIZE(cls)	((size_t)1 << (CLASS_MIN_SHIFT + (cls)))
+
+struct malloc_cache_bin {
+	void *head;
+	size_t bytes;
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+};
+
+struct malloc_cache {
+	struct k_spinlock lock;
+	struct malloc_cache_bin bins[CACHE_CLASSES];
+};
+
+static struct malloc_cache malloc_caches[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Returns the class serving requests of @a size bytes, or -1 */
+static int size_to_class(size_t size)
+{
+	for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+		if (size <= CLASS_SIZE(cls)) {
+			return cls;
+		}
+	}
+
+	return -1;
+}
+
+/* Returns the class a freed block of @a usable bytes is cached in, or -1 */
+static int usable_to_class(size_t usable)
+{
+	for (int cls = CACHE_CLASSES - 1; cls >= 0; cls--) {
+		if (usable >= CLASS_SIZE(cls)) {
+			return (usable < 2 * CLASS_SIZE(cls)) ? cls : -1;
+		}
+	}
+
+	return -1;
+}
+
+static struct malloc_cache *cache_lock(unsigned int *irq, k_spinlock_key_t *key)
+{
+	struct malloc_cache *cache;
+
+	*irq = arch_irq_lock();
+	cache = &malloc_caches[arch_curr_cpu()->id];
+	*key = k_spin_lock(&cache->lock);
+
+	return cache;
+}
+
+static void cache_unlock(struct malloc_cache *cache, unsigned int irq,
+			 k_spinlock_key_t key)
+{
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+}
+
+static void bin_push(struct malloc_cache_bin *bin, void *mem, size_t usable)
+{
+	*(void **)mem = bin->head;
+	bin->head = mem;
+	bin->bytes += usable;
+	bin->count++;
+}
+
+static void *bin_pop(struct malloc_cache_bin *bin)
+{
+	void *mem = bin->head;
+
+	bin->head = *(void **)mem;
+	bin->bytes -= sys_heap_usable_size(&z_malloc_heap, mem);
+	bin->count--;
+
+	return mem;
+}
+
+/* Frees a list of blocks linked through their first word. Called with the heap mutex held. */
+static void heap_free_list(void *list)
+{
+	while (list != NULL) {
+		void *next = *(void **)list;
+
+		sys_heap_free(&z_malloc_heap, list);
+		list = next;
+	}
+}
+
+static void *cache_alloc(int cls)
+{
+	unsigned int irq;
+	k_spinlock_key_t key;
+	struct malloc_cache *cache = cache_lock(&irq, &key);
+	struct malloc_cache_bin *bin = &cache->bins[cls];
+	void *mem = NULL;
+
+	if (bin->head != NULL) {
+		mem = bin_pop(bin);
+		bin->hits++;
+	} else {
+		bin->misses++;
+	}
+
+	cache_unlock(cache, irq, key);
+
+	return mem;
+}
+
+/* Fills the current CPU's bin up to half. Called with the heap mutex held. */
+static void cache_refill(int cls)
+{
+	unsigned int irq;
+	k_spinlock_key_t key;
+	struct malloc_cache *cache;
+	struct malloc_cache_bin *bin;
+	void *list = NULL;
+
+	for (int i = 0; i < CACHE_BATCH; i++) {
+		void *mem = sys_heap_aligned_alloc(&z_malloc_heap,
+						   __alignof__(z_max_align_t),
+						   CLASS_SIZE(cls));
+		if (mem == NULL) {
+			break;
+		}
+		*(void **)mem = list;
+		list = mem;
+	}
+
+	cache = cache_lock(&irq, &key);
+	bin = &cache->bins[cls];
+	while ((list != NULL) && (bin->count < CACHE_DEPTH)) {
+		void *next = *(void **)list;
+
+		bin_push(bin, list, sys_heap_usable_size(&z_malloc_heap, list));
+		list = next;
+	}
+	cache_unlock(cache, irq, key);
+
+	/* Only left over if this thread moved to another CPU meanwhile */
+	heap_free_list(list);
+}
+
+static bool cache_free(void *mem)
+{
+	size_t usable = sys_heap_usable_size(&z_malloc_heap, mem);
+	int cls = usable_to_class(usable);
+	unsigned int irq;
+	k_spinlock_key_t key;
+	struct malloc_cache *cache;
+	struct malloc_cache_bin *bin;
+	void *spill = NULL;
+
+	if (cls < 0) {
+		return false;
+	}
+
+	cache = cache_lock(&irq, &key);
+	bin = &cache->bins[cls];
+	if (bin->count == CACHE_DEPTH) {
+		for (int i = 0; i < CACHE_BATCH; i++) {
+			void *p = bin_pop(bin);
+
+			*(void **)p = spill;
+			spill = p;
+		}
+	}
+	bin_push(bin, mem, usable);
+	cache_unlock(cache, irq, key);
+
+	if (spill != NULL) {
+		malloc_lock();
+		heap_free_list(spill);
+		malloc_unlock();
+	}
+
+	return true;
+}
+
+/*
+ * Returns the blocks of all CPU caches to the heap, and whether there were
+ * any. Called with the heap mutex held.
+ */
+static bool cache_reclaim_all(void)
+{
+	void *list = NULL;
+
+	for (unsigned int cpu = 0; cpu < ARRAY_SIZE(malloc_caches); cpu++) {
+		struct malloc_cache *cache = &malloc_caches[cpu];
+
+		K_SPINLOCK(&cache->lock) {
+			for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+				struct malloc_cache_bin *bin = &cache->bins[cls];
+
+				while (bin->head != NULL) {
+					void *p = bin_pop(bin);
+
+					*(void **)p = list;
+					list = p;
+				}
+			}
+		}
+	}
+
+	heap_free_list(list);
+
+	return list != NULL;
+}
+
+int malloc_runtime_class_stats_get(unsigned int size_class,
+				   struct malloc_class_stats *stats)
+{
+	if ((stats == NULL) || (size_class >= CACHE_CLASSES)) {
+		return -EINVAL;
+	}
+
+	*stats = (struct malloc_class_stats) {
+		.block_size = CLASS_SIZE(size_class),
+	};
+
+	for (unsigned int cpu = 0; cpu < ARRAY_SIZE(malloc_caches); cpu++) {
+		struct malloc_cache *cache = &malloc_caches[cpu];
+
+		K_SPINLOCK(&cache->lock) {
+			struct malloc_cache_bin *bin = &cache->bins[size_class];
+
+			stats->cached_blocks += bin->count;
+			stats->hits += bin->hits;
+			stats->misses += bin->misses;
+		}
+	}
+
+	return 0;
+}
+#else
+#define cache_reclaim_all() false
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 void *malloc(size_t size)
 {
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	int cls = (size != 0) ? size_to_class(size) : -1;
+
+	if (cls >= 0) {
+		void *ret = cache_alloc(cls);
+
+		if (ret != NULL) {
+			return ret;
+		}
+		size = CLASS_SIZE(cls);
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 	malloc_lock();
 
 	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
 					   __alignof__(z_max_align_t),
 					   size);
+	if (ret == NULL && size != 0 && cache_reclaim_all()) {
+		ret = sys_heap_aligned_alloc(&z_malloc_heap,
+					     __alignof__(z_max_align_t),
+					     size);
+	}
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	if (ret != NULL && cls >= 0) {
+		cache_refill(cls);
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -160,6 +434,9 @@ void *aligned_alloc(size_t alignment, size_t size)
 	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
 					   alignment,
 					   size);
+	if (ret == NULL && size != 0 && cache_reclaim_all()) {
+		ret = sys_heap_aligned_alloc(&z_malloc_heap, alignment, size);
+	}
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -246,6 +523,11 @@ void *realloc(void *ptr, size_t requested_size)
 					     __alignof__(z_max_align_t),
 					     requested_size);
 
+	if (ret == NULL && requested_size != 0 && cache_reclaim_all()) {
+		ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
+					       __alignof__(z_max_align_t),
+					       requested_size);
+	}
 	if (ret == NULL && requested_size != 0) {
 		errno = ENOMEM;
 	}
@@ -257,11 +539,50 @@ void *realloc(void *ptr, size_t requested_size)
 
 void free(void *ptr)
 {
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	if ((ptr != NULL) && cache_free(ptr)) {
+		return;
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 	malloc_lock();
 	sys_heap_free(&z_malloc_heap, ptr);
 	malloc_unlock();
 }
 
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int malloc_runtime_stats_get(struct sys_memory_stats *stats)
+{
+	int ret;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	malloc_lock();
+
+	ret = sys_heap_runtime_stats_get(&z_malloc_heap, stats);
+
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	/* Blocks sitting in the caches are free as far as callers care */
+	for (unsigned int cpu = 0; (ret == 0) && (cpu < ARRAY_SIZE(malloc_caches)); cpu++) {
+		struct malloc_cache *cache = &malloc_caches[cpu];
+
+		K_SPINLOCK(&cache->lock) {
+			for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+				stats->allocated_bytes -= cache->bins[cls].bytes;
+				stats->free_bytes += cache->bins[cls].bytes;
+			}
+		}
+	}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
+	malloc_unlock();
+
+	return ret;
+}
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
+
 SYS_INIT(malloc_prepare, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_LIBC);
 #else /* No malloc arena */
 void *malloc(size_t size)
@@ -24,6 +24,58 @@ typedef uintptr_t mem_word_t;
 
 #endif
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+
+#define MEM_WORD_MASK ((uintptr_t)sizeof(mem_word_t) - 1)
+
+/* 0x01 and 0x80 repeated in every byte of a word */
+#define MEM_WORD_ONES  ((mem_word_t)-1 / 0xff)
+#define MEM_WORD_HIGHS (MEM_WORD_ONES * 0x80)
+
+/*
+ * Non-zero if any byte of <w> is zero. Bytes above the first zero byte may
+ * be flagged spuriously, but the result is only used to stop a word scan,
+ * the exact position being looked up byte by byte afterwards.
+ */
+#define MEM_WORD_HAS_ZERO(w) (((w) - MEM_WORD_ONES) & ~(w) & MEM_WORD_HIGHS)
+
+/*
+ * strlen() and memchr() scan whole aligned words, which may include bytes
+ * past the end of the object. That cannot fault, but the address sanitizer
+ * reports it, so these scan byte by byte in sanitized builds.
+ */
+#if !defined(CONFIG_ASAN)
+#define MEM_WORD_SCAN
+#endif
+
+#if defined(CONFIG_MINIMAL_LIBC_STRING_UNALIGNED_ACCESS)
+
+struct unaligned_mem_word {
+	mem_word_t word;
+} __attribute__((__packed__));
+
+/* the target handles unaligned word loads, any pair of buffers qualifies */
+#define MEM_WORD_PAIR_OK(a, b) 1
+
+static inline mem_word_t load_word(const void *p)
+{
+	return ((const struct unaligned_mem_word *)p)->word;
+}
+
+#else
+
+/* word accesses to both buffers require them to have identical alignment */
+#define MEM_WORD_PAIR_OK(a, b) ((((uintptr_t)(a) ^ (uintptr_t)(b)) & MEM_WORD_MASK) == 0)
+
+static inline mem_word_t load_word(const void *p)
+{
+	return *(const mem_word_t *)p;
+}
+
+#endif /* CONFIG_MINIMAL_LIBC_STRING_UNALIGNED_ACCESS */
+
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE */
+
 /**
  *
  * @brief Copy a string
@@ -120,14 +172,38 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *p = s;
 
-	while (*s != '\0') {
-		s++;
-		n++;
+#if defined(MEM_WORD_SCAN)
+	/* scan bytes until word-aligned or terminator found */
+
+	while (((uintptr_t)p) & MEM_WORD_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	/*
+	 * Scan words until one contains the terminator. An aligned word never
+	 * straddles a page or memory protection region, so reading the bytes
+	 * past the terminator within the same word cannot fault.
+	 */
+
+	const mem_word_t *w = (const mem_word_t *)p;
+
+	while (!MEM_WORD_HAS_ZERO(*w)) {
+		w++;
+	}
+
+	p = (const char *)w;
+#endif
+
+	while (*p != '\0') {
+		p++;
 	}
 
-	return n;
+	return p - s;
 }
 
 /**
@@ -240,6 +316,32 @@ int memcmp(const void *m1, const void *m2, size_t n)
 		return 0;
 	}
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	if (MEM_WORD_PAIR_OK(c1, c2)) {
+
+		/* compare bytes until word-aligned */
+
+		while (((uintptr_t)c1) & MEM_WORD_MASK) {
+			if (*c1 != *c2) {
+				return *c1 - *c2;
+			}
+			if (--n == 0) {
+				return 0;
+			}
+			c1++;
+			c2++;
+		}
+
+		/* skip equal words, a differing one is compared byte-wise below */
+
+		while ((n > sizeof(mem_word_t)) && (load_word(c1) == load_word(c2))) {
+			c1 += sizeof(mem_word_t);
+			c2 += sizeof(mem_word_t);
+			n -= sizeof(mem_word_t);
+		}
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -298,13 +400,11 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 	const unsigned char *s_byte = (const unsigned char *)s;
 
 #if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	const uintptr_t mask = sizeof(mem_word_t) - 1;
-
-	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
+	if (MEM_WORD_PAIR_OK(d, s_byte)) {
 
 		/* do byte-sized copying until word-aligned or finished */
 
-		while (((uintptr_t)d_byte) & mask) {
+		while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
 			if (n == 0) {
 				return d;
 			}
@@ -312,18 +412,27 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 			n--;
 		}
 
-		/* do word-sized copying as long as possible */
+		/* do word-sized copying, four words at a time, as long as possible */
 
 		mem_word_t *d_word = (mem_word_t *)d_byte;
-		const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+		while (n >= 4 * sizeof(mem_word_t)) {
+			d_word[0] = load_word(s_byte);
+			d_word[1] = load_word(s_byte + sizeof(mem_word_t));
+			d_word[2] = load_word(s_byte + 2 * sizeof(mem_word_t));
+			d_word[3] = load_word(s_byte + 3 * sizeof(mem_word_t));
+			d_word += 4;
+			s_byte += 4 * sizeof(mem_word_t);
+			n -= 4 * sizeof(mem_word_t);
+		}
 
 		while (n >= sizeof(mem_word_t)) {
-			*(d_word++) = *(s_word++);
+			*(d_word++) = load_word(s_byte);
+			s_byte += sizeof(mem_word_t);
 			n -= sizeof(mem_word_t);
 		}
 
 		d_byte = (unsigned char *)d_word;
-		s_byte = (unsigned char *)s_word;
 	}
 #endif
 
@@ -352,7 +461,7 @@ void *memset(void *buf, int c, size_t n)
 	unsigned char c_byte = (unsigned char)c;
 
 #if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	while (((uintptr_t)d_byte) & (sizeof(mem_word_t) - 1)) {
+	while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
 		if (n == 0) {
 			return buf;
 		}
@@ -371,6 +480,15 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -398,15 +516,39 @@ void *memset(void *buf, int c, size_t n)
 
 void *memchr(const void *s, int c, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p = s;
+	const unsigned char *p = s;
+	unsigned char c_byte = (unsigned char)c;
 
-		do {
-			if (*p++ == (unsigned char)c) {
-				return ((void *)(p - 1));
-			}
+#if defined(MEM_WORD_SCAN)
+	/* scan bytes until word-aligned */
+
+	while ((n > 0) && (((uintptr_t)p) & MEM_WORD_MASK)) {
+		if (*p == c_byte) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	/* scan words until one contains the byte, see strlen() */
+
+	const mem_word_t *w = (const mem_word_t *)p;
+	mem_word_t c_word = MEM_WORD_ONES * c_byte;
 
-		} while (--n != 0);
+	while ((n >= sizeof(mem_word_t)) && !MEM_WORD_HAS_ZERO(*w ^ c_word)) {
+		w++;
+		n -= sizeof(mem_word_t);
+	}
+
+	p = (const unsigned char *)w;
+#endif
+
+	while (n > 0) {
+		if (*p == c_byte) {
+			return (void *)p;
+		}
+		p++;
+		n--;
 	}
 
 	return NULL;
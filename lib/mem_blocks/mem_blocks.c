@@ -13,6 +13,320 @@
 #include <zephyr/init.h>
 #include <string.h>
 
+#ifdef CONFIG_SYS_MEM_BLOCKS_LOCK_FREE
+
+/*
+ * In lock-free mode the bundles of the bitarray are only modified with
+ * atomic compare-and-swap, one 32-bit bundle at a time, so allocating
+ * and freeing never takes a lock and is safe from any context.  The
+ * read-only sys_bitarray API still works on the bitmap as each bundle
+ * it reads is consistent.
+ */
+BUILD_ASSERT(sizeof(atomic_t) == sizeof(uint32_t),
+	     "lock-free memory blocks need 32-bit atomic variables");
+
+#define BUNDLE_BITS 32U
+
+static inline atomic_t *bundle(sys_mem_blocks_t *mem_block, size_t idx)
+{
+	return (atomic_t *)&mem_block->bitmap->bundles[idx];
+}
+
+static inline uint32_t low_mask(size_t num_bits)
+{
+	return (num_bits >= BUNDLE_BITS) ? ~0U : (uint32_t)BIT_MASK(num_bits);
+}
+
+/* Bits of a bundle that correspond to existing blocks */
+static inline uint32_t valid_bits(sys_mem_blocks_t *mem_block, size_t idx)
+{
+	return low_mask(mem_block->info.num_blocks - idx * BUNDLE_BITS);
+}
+
+static void stats_alloced(sys_mem_blocks_t *mem_block, size_t num_blocks)
+{
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	k_spinlock_key_t key = k_spin_lock(&mem_block->lock);
+
+	mem_block->info.used_blocks += (uint32_t)num_blocks;
+
+	if (mem_block->info.max_used_blocks < mem_block->info.used_blocks) {
+		mem_block->info.max_used_blocks = mem_block->info.used_blocks;
+	}
+
+	k_spin_unlock(&mem_block->lock, key);
+#else
+	ARG_UNUSED(mem_block);
+	ARG_UNUSED(num_blocks);
+#endif
+}
+
+static void stats_freed(sys_mem_blocks_t *mem_block, size_t num_blocks)
+{
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	k_spinlock_key_t key = k_spin_lock(&mem_block->lock);
+
+	mem_block->info.used_blocks -= (uint32_t)num_blocks;
+
+	k_spin_unlock(&mem_block->lock, key);
+#else
+	ARG_UNUSED(mem_block);
+	ARG_UNUSED(num_blocks);
+#endif
+}
+
+static bool bits_set(atomic_t *target, uint32_t mask)
+{
+	return ((uint32_t)atomic_get(target) & mask) == mask;
+}
+
+/* Sets the bits in mask if they are all clear */
+static bool claim_bits(atomic_t *target, uint32_t mask)
+{
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(target);
+		if (((uint32_t)old & mask) != 0U) {
+			return false;
+		}
+	} while (!atomic_cas(target, old, old | mask));
+
+	return true;
+}
+
+/* Clears the bits in mask if they are all set */
+static bool release_bits(atomic_t *target, uint32_t mask)
+{
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(target);
+		if (((uint32_t)old & mask) != mask) {
+			return false;
+		}
+	} while (!atomic_cas(target, old, old & ~mask));
+
+	return true;
+}
+
+/*
+ * Calls fn on the bits of each bundle covered by a region, stopping at
+ * the first call that fails. Returns the number of blocks processed.
+ */
+static size_t for_each_bundle(sys_mem_blocks_t *mem_block, size_t offset,
+			      size_t count, bool (*fn)(atomic_t *target, uint32_t mask))
+{
+	size_t off = offset;
+
+	while (off < offset + count) {
+		size_t bit = off % BUNDLE_BITS;
+		size_t num = MIN(BUNDLE_BITS - bit, offset + count - off);
+
+		if (!fn(bundle(mem_block, off / BUNDLE_BITS), low_mask(num) << bit)) {
+			break;
+		}
+		off += num;
+	}
+
+	return off - offset;
+}
+
+static bool claim_region(sys_mem_blocks_t *mem_block, size_t offset, size_t count)
+{
+	size_t claimed = for_each_bundle(mem_block, offset, count, claim_bits);
+
+	if (claimed < count) {
+		/* Lost a race for part of the region, give back the rest */
+		(void)for_each_bundle(mem_block, offset, claimed, release_bits);
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Bitmap of the positions in "free_bits" that start a run of at least
+ * "count" free bits, computed by doubling the run length at each step.
+ */
+static uint32_t run_starts(uint32_t free_bits, size_t count)
+{
+	uint32_t starts = free_bits;
+	size_t len = 1;
+
+	while ((len < count) && (starts != 0U)) {
+		size_t step = MIN(len, count - len);
+
+		starts &= starts >> step;
+		len += step;
+	}
+
+	return starts;
+}
+
+/*
+ * First fit search of "count" contiguous free blocks, one bundle at a
+ * time.  A run within a single bundle is claimed with one
+ * compare-and-swap, a run crossing bundles is claimed bundle by bundle
+ * and given back if another context took part of it meanwhile.
+ */
+static int find_contiguous(sys_mem_blocks_t *mem_block, size_t count, size_t *offset)
+{
+	size_t num_bundles = mem_block->bitmap->num_bundles;
+	size_t start;
+	size_t run;
+
+retry:
+	/* Free blocks at the top of the bundles seen so far */
+	start = 0;
+	run = 0;
+
+	for (size_t idx = 0; idx < num_bundles; idx++) {
+		atomic_t *target = bundle(mem_block, idx);
+		uint32_t valid = valid_bits(mem_block, idx);
+		atomic_val_t old = atomic_get(target);
+		uint32_t free_bits = ~(uint32_t)old & valid;
+		size_t lead = (free_bits == valid) ? POPCOUNT(valid) :
+			      (size_t)(find_lsb_set(~free_bits) - 1);
+
+		if ((run > 0) && (run + lead >= count)) {
+			if (!claim_region(mem_block, start, count)) {
+				goto retry;
+			}
+			*offset = start;
+			return 0;
+		}
+
+		if (count <= BUNDLE_BITS) {
+			uint32_t starts = run_starts(free_bits, count);
+
+			if (starts != 0U) {
+				size_t bit = find_lsb_set(starts) - 1;
+
+				if (!atomic_cas(target, old, old | (low_mask(count) << bit))) {
+					goto retry;
+				}
+				*offset = idx * BUNDLE_BITS + bit;
+				return 0;
+			}
+		}
+
+		if (free_bits == valid) {
+			if (run == 0) {
+				start = idx * BUNDLE_BITS;
+			}
+			run += POPCOUNT(valid);
+		} else {
+			/* Only the free bits at the top can extend a run */
+			if ((free_bits & BIT(BUNDLE_BITS - 1)) == 0U) {
+				run = 0;
+			} else {
+				run = BUNDLE_BITS - find_msb_set(~free_bits);
+				start = (idx + 1) * BUNDLE_BITS - run;
+			}
+		}
+	}
+
+	return -ENOSPC;
+}
+
+static void *alloc_blocks(sys_mem_blocks_t *mem_block, size_t num_blocks)
+{
+	size_t offset;
+
+	if (find_contiguous(mem_block, num_blocks, &offset) != 0) {
+		return NULL;
+	}
+
+	stats_alloced(mem_block, num_blocks);
+
+	return mem_block->buffer + (offset << mem_block->info.blk_sz_shift);
+}
+
+/*
+ * Allocates "count" blocks wherever they are free, claiming as many of
+ * them as needed from each bundle with a single compare-and-swap.
+ */
+static int alloc_scattered(sys_mem_blocks_t *mem_block, size_t count, void **out_blocks)
+{
+	size_t num_bundles = mem_block->bitmap->num_bundles;
+	size_t got = 0;
+
+	for (size_t idx = 0; (idx < num_bundles) && (got < count); idx++) {
+		atomic_t *target = bundle(mem_block, idx);
+		atomic_val_t old;
+		uint32_t claim;
+
+		do {
+			uint32_t free_bits;
+
+			old = atomic_get(target);
+			free_bits = ~(uint32_t)old & valid_bits(mem_block, idx);
+			claim = 0U;
+
+			for (size_t n = got; (free_bits != 0U) && (n < count); n++) {
+				claim |= free_bits & -free_bits;
+				free_bits &= free_bits - 1U;
+			}
+		} while ((claim != 0U) && !atomic_cas(target, old, old | claim));
+
+		while (claim != 0U) {
+			size_t bit = find_lsb_set(claim) - 1;
+
+			out_blocks[got++] = mem_block->buffer +
+				((idx * BUNDLE_BITS + bit) << mem_block->info.blk_sz_shift);
+			claim &= claim - 1U;
+		}
+	}
+
+	if (got < count) {
+		for (size_t i = 0; i < got; i++) {
+			size_t offset = ((uint8_t *)out_blocks[i] - mem_block->buffer) >>
+					mem_block->info.blk_sz_shift;
+
+			(void)for_each_bundle(mem_block, offset, 1, release_bits);
+		}
+		return -ENOMEM;
+	}
+
+	stats_alloced(mem_block, count);
+
+	return 0;
+}
+
+static int free_blocks(sys_mem_blocks_t *mem_block, void *ptr,
+		       size_t num_blocks)
+{
+	size_t offset;
+	uint8_t *blk = ptr;
+
+	/* Make sure incoming block is within the mem_block buffer */
+	if (blk < mem_block->buffer) {
+		return -EFAULT;
+	}
+
+	offset = (blk - mem_block->buffer) >> mem_block->info.blk_sz_shift;
+	if ((offset >= mem_block->info.num_blocks) ||
+	    (num_blocks > mem_block->info.num_blocks - offset)) {
+		return -EFAULT;
+	}
+
+	/* Fail early, without touching anything, on a plain double free */
+	if (for_each_bundle(mem_block, offset, num_blocks, bits_set) < num_blocks) {
+		return -EFAULT;
+	}
+
+	if (for_each_bundle(mem_block, offset, num_blocks, release_bits) < num_blocks) {
+		return -EFAULT;
+	}
+
+	stats_freed(mem_block, num_blocks);
+
+	return 0;
+}
+
+#else
+
 static void *alloc_blocks(sys_mem_blocks_t *mem_block, size_t num_blocks)
 {
 	size_t offset;
@@ -86,6 +400,8 @@ out:
 	return ret;
 }
 
+#endif /* CONFIG_SYS_MEM_BLOCKS_LOCK_FREE */
+
 int sys_mem_blocks_alloc_contiguous(sys_mem_blocks_t *mem_block, size_t count,
 				    void **out_block)
 {
@@ -127,7 +443,9 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 			 void **out_blocks)
 {
 	int ret = 0;
+#ifndef CONFIG_SYS_MEM_BLOCKS_LOCK_FREE
 	int i;
+#endif
 
 	__ASSERT_NO_MSG(mem_block != NULL);
 	__ASSERT_NO_MSG(out_blocks != NULL);
@@ -145,6 +463,17 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 		goto out;
 	}
 
+#ifdef CONFIG_SYS_MEM_BLOCKS_LOCK_FREE
+	ret = alloc_scattered(mem_block, count, out_blocks);
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
+	for (size_t i = 0; (ret == 0) && (i < count); i++) {
+		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
+					   out_blocks[i],
+					   BIT(mem_block->info.blk_sz_shift));
+	}
+#endif
+#else
 	for (i = 0; i < count; i++) {
 		void *ptr = alloc_blocks(mem_block, 1);
 
@@ -166,6 +495,7 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 		(void)sys_mem_blocks_free(mem_block, i, out_blocks);
 		ret = -ENOMEM;
 	}
+#endif
 
 out:
 	return ret;
@@ -214,6 +544,14 @@ int sys_mem_blocks_get(sys_mem_blocks_t *mem_block, void *in_block, size_t count
 		goto out;
 	}
 
+#ifdef CONFIG_SYS_MEM_BLOCKS_LOCK_FREE
+	if (!claim_region(mem_block, offset, count)) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	stats_alloced(mem_block, count);
+#else
 #ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
 	k_spinlock_key_t  key = k_spin_lock(&mem_block->lock);
 #endif
@@ -238,6 +576,7 @@ int sys_mem_blocks_get(sys_mem_blocks_t *mem_block, void *in_block, size_t count
 
 	k_spin_unlock(&mem_block->lock, key);
 #endif
+#endif /* CONFIG_SYS_MEM_BLOCKS_LOCK_FREE */
 
 #ifdef CONFIG_SYS_MEM_BLOCKS_LISTENER
 	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(mem_block),
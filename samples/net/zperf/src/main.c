@@ -13,7 +13,8 @@
 
 LOG_MODULE_REGISTER(zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
-#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP) || \
+	defined(CONFIG_NET_LOOPBACK_SIMULATE_DELAY)
 #include <zephyr/net/loopback.h>
 #endif
 
@@ -44,6 +45,10 @@ int main(void)
 	loopback_set_packet_drop_ratio(1);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	loopback_set_delay(CONFIG_NET_SAMPLE_LOOPBACK_DELAY_MS);
+#endif
+
 #if defined(CONFIG_NET_DHCPV4) && !defined(CONFIG_NET_CONFIG_SETTINGS)
 	net_dhcpv4_start(net_if_get_default());
 #endif
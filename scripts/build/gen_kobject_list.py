@@ -93,6 +93,7 @@ kobjects = OrderedDict(
     [
         ("k_mem_slab", (None, False, True)),
         ("k_msgq", (None, False, True)),
+        ("k_vmsgq", (None, False, True)),
         ("k_mutex", (None, False, True)),
         ("k_pipe", (None, False, True)),
         ("k_queue", (None, False, True)),
@@ -108,6 +109,7 @@ kobjects = OrderedDict(
         ("sys_mutex", (None, True, False)),
         ("k_futex", (None, True, False)),
         ("k_condvar", (None, False, True)),
+        ("k_rwlock", (None, False, True)),
         ("k_event", ("CONFIG_EVENTS", False, True)),
         ("ztest_suite_node", ("CONFIG_ZTEST", True, False)),
         ("ztest_suite_stats", ("CONFIG_ZTEST", True, False)),
@@ -0,0 +1,168 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock with aging eviction algorithm for demand paging.
+ *
+ * Theory of Operation:
+ *
+ * - Each page frame has an 8-bit age. A periodic timer shifts every age
+ *   right by one bit, sets the top bit if the page was accessed during the
+ *   last period, and clears the page's accessed flag. The age is thus a
+ *   history of use over the last eight periods, the most recent one
+ *   weighing the most.
+ *
+ * - On page reclamation, a clock hand sweeps the page frames starting
+ *   after the last victim. A page accessed since the last period counts
+ *   as if the timer had just aged it. The page with the lowest age is
+ *   selected, clean pages winning over dirty ones of the same age. The
+ *   sweep ends early on a clean page with an age of zero.
+ *
+ * - The victim's frame receives a new page which has not been accessed
+ *   yet. Its age starts as if it had been accessed one period ago, so that
+ *   it is not selected again before it gets a chance to be used. The same
+ *   age is given to frames found on the free list by the timer, so that a
+ *   page later mapped there does not inherit the history of the previous
+ *   one.
+ */
+
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/init.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+#define AGE_ACCESSED	BIT(7)
+#define AGE_NEW_PAGE	BIT(6)
+
+static uint8_t clock_age[ARRAY_SIZE(k_mem_page_frames)];
+
+static void clock_periodic_update(struct k_timer *timer)
+{
+	uintptr_t phys;
+	uintptr_t flags;
+	struct k_mem_page_frame *pf;
+	unsigned int key = irq_lock();
+
+	K_MEM_PAGE_FRAME_FOREACH(phys, pf) {
+		uint32_t pf_idx = pf - k_mem_page_frames;
+
+		if (k_mem_page_frame_is_free(pf)) {
+			clock_age[pf_idx] = AGE_NEW_PAGE;
+			continue;
+		}
+
+		if (!k_mem_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Clear accessed bit in page tables */
+		flags = arch_page_info_get(k_mem_page_frame_to_virt(pf),
+					   NULL, true);
+
+		clock_age[pf_idx] >>= 1;
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			clock_age[pf_idx] |= AGE_ACCESSED;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+struct k_mem_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	unsigned int last_prec = UINT_MAX;
+	struct k_mem_page_frame *last_pf = NULL, *pf;
+	bool last_dirty = false;
+	bool dirty;
+	uintptr_t flags;
+	uint32_t pf_idx;
+	static uint32_t last_pf_idx;
+
+	last_pf_idx = (last_pf_idx + 1) % ARRAY_SIZE(k_mem_page_frames);
+	pf_idx = last_pf_idx;
+	do {
+		unsigned int age;
+		unsigned int prec;
+
+		pf = &k_mem_page_frames[pf_idx];
+		age = clock_age[pf_idx];
+		pf_idx = (pf_idx + 1) % ARRAY_SIZE(k_mem_page_frames);
+
+		if (!k_mem_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL, false);
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			age = (age >> 1) | AGE_ACCESSED;
+		}
+
+		prec = (age << 1) | (dirty ? 1U : 0U);
+		if (prec == 0) {
+			/* Clean page unused for the whole history, we're done */
+			last_pf = pf;
+			last_dirty = dirty;
+			break;
+		}
+
+		if (prec < last_prec) {
+			last_prec = prec;
+			last_pf = pf;
+			last_dirty = dirty;
+		}
+	} while (pf_idx != last_pf_idx);
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(last_pf != NULL, "no page to evict");
+
+	last_pf_idx = last_pf - k_mem_page_frames;
+	clock_age[last_pf_idx] = AGE_NEW_PAGE;
+	*dirty_ptr = last_dirty;
+
+	return last_pf;
+}
+
+static K_TIMER_DEFINE(clock_timer, clock_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	k_timer_start(&clock_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_CLOCK_PERIOD));
+}
+
+#ifdef CONFIG_EVICTION_TRACKING
+/*
+ * Empty functions defined here so that architectures unconditionally
+ * implement eviction tracking can still use this algorithm for
+ * testing.
+ */
+
+void k_mem_paging_eviction_add(struct k_mem_page_frame *pf)
+{
+	ARG_UNUSED(pf);
+}
+
+void k_mem_paging_eviction_remove(struct k_mem_page_frame *pf)
+{
+	ARG_UNUSED(pf);
+}
+
+void k_mem_paging_eviction_accessed(uintptr_t phys)
+{
+	ARG_UNUSED(phys);
+}
+
+#endif /* CONFIG_EVICTION_TRACKING */
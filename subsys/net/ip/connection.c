@@ -61,6 +61,13 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* UDP and TCP handlers bound to a local port are chained by protocol and
+ * port, every other handler is on the wildcard chain. A packet is matched
+ * against its port chain and the wildcard chain only.
+ */
+static sys_slist_t conn_port_hash[BIT(CONFIG_NET_CONN_HASH_BITS)];
+static sys_slist_t conn_wildcard;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +120,32 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static bool conn_is_port_hashed(uint16_t proto)
+{
+	return (IS_ENABLED(CONFIG_NET_UDP) && proto == NET_IPPROTO_UDP) ||
+	       (IS_ENABLED(CONFIG_NET_TCP) && proto == NET_IPPROTO_TCP);
+}
+
+/* Port is in network byte order */
+static sys_slist_t *conn_port_chain(uint16_t proto, uint16_t port)
+{
+	uint32_t hash = (((uint32_t)proto << 16) | port) * 0x9e3779b1U;
+
+	return &conn_port_hash[(hash >> 16) & (ARRAY_SIZE(conn_port_hash) - 1)];
+}
+
+static sys_slist_t *conn_chain(struct net_conn *conn)
+{
+	if (conn_is_port_hashed(conn->proto) &&
+	    (conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0U &&
+	    (conn->family == NET_AF_INET || conn->family == NET_AF_INET6 ||
+	     conn->family == NET_AF_UNSPEC)) {
+		return conn_port_chain(conn->proto, net_sin(&conn->local_addr)->sin_port);
+	}
+
+	return &conn_wildcard;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -138,6 +171,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_chain(conn), &conn->hash_node);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -159,106 +193,119 @@ static struct net_conn *conn_find_handler(struct net_if *iface,
 					  uint16_t local_port,
 					  bool reuseport_set)
 {
+	/* A handler with this local port is either on the port chain or,
+	 * if it was not registered with a port, on the wildcard chain.
+	 */
+	sys_slist_t *chains[] = {
+		conn_is_port_hashed(proto) && local_port != 0U ?
+			conn_port_chain(proto, net_htons(local_port)) : NULL,
+		&conn_wildcard,
+	};
 	struct net_conn *conn;
-	struct net_conn *tmp;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
-		if (conn->proto != proto) {
+	ARRAY_FOR_EACH(chains, i) {
+		if (chains[i] == NULL) {
 			continue;
 		}
 
-		if (conn->family != family) {
-			continue;
-		}
+		SYS_SLIST_FOR_EACH_CONTAINER(chains[i], conn, hash_node) {
+			if (conn->proto != proto) {
+				continue;
+			}
 
-		if (local_addr) {
-			if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			if (conn->family != family) {
 				continue;
 			}
 
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    local_addr->sa_family == NET_AF_INET6 &&
-			    local_addr->sa_family ==
-			    conn->local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conn->local_addr)->
-								sin6_addr)) {
+			if (local_addr) {
+				if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
 					continue;
 				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   local_addr->sa_family == NET_AF_INET &&
-				   local_addr->sa_family ==
-				   conn->local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conn->local_addr)->
-								sin_addr)) {
+
+				if (IS_ENABLED(CONFIG_NET_IPV6) &&
+				    local_addr->sa_family == NET_AF_INET6 &&
+				    local_addr->sa_family ==
+				    conn->local_addr.sa_family) {
+					if (!net_ipv6_addr_cmp(
+						    &net_sin6(local_addr)->sin6_addr,
+						    &net_sin6(&conn->local_addr)->
+									sin6_addr)) {
+						continue;
+					}
+				} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+					   local_addr->sa_family == NET_AF_INET &&
+					   local_addr->sa_family ==
+					   conn->local_addr.sa_family) {
+					if (!net_ipv4_addr_cmp(
+						    &net_sin(local_addr)->sin_addr,
+						    &net_sin(&conn->local_addr)->
+									sin_addr)) {
+						continue;
+					}
+				} else {
 					continue;
 				}
-			} else {
+			} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
 				continue;
 			}
-		} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-			continue;
-		}
 
-		if (net_sin(&conn->local_addr)->sin_port !=
-		    net_htons(local_port)) {
-			continue;
-		}
-
-		if (remote_addr) {
-			if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			if (net_sin(&conn->local_addr)->sin_port !=
+			    net_htons(local_port)) {
 				continue;
 			}
 
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    remote_addr->sa_family == NET_AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conn->remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conn->remote_addr)->
-								sin6_addr)) {
+			if (remote_addr) {
+				if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
 					continue;
 				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   remote_addr->sa_family == NET_AF_INET &&
-				   remote_addr->sa_family ==
-				   conn->remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conn->remote_addr)->
-								sin_addr)) {
+
+				if (IS_ENABLED(CONFIG_NET_IPV6) &&
+				    remote_addr->sa_family == NET_AF_INET6 &&
+				    remote_addr->sa_family ==
+				    conn->remote_addr.sa_family) {
+					if (!net_ipv6_addr_cmp(
+						    &net_sin6(remote_addr)->sin6_addr,
+						    &net_sin6(&conn->remote_addr)->
+									sin6_addr)) {
+						continue;
+					}
+				} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+					   remote_addr->sa_family == NET_AF_INET &&
+					   remote_addr->sa_family ==
+					   conn->remote_addr.sa_family) {
+					if (!net_ipv4_addr_cmp(
+						    &net_sin(remote_addr)->sin_addr,
+						    &net_sin(&conn->remote_addr)->
+									sin_addr)) {
+						continue;
+					}
+				} else {
 					continue;
 				}
-			} else {
+			} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+				continue;
+			} else if (reuseport_set && conn->context != NULL &&
+				   net_context_is_reuseport_set(conn->context)) {
 				continue;
 			}
-		} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-			continue;
-		} else if (reuseport_set && conn->context != NULL &&
-			   net_context_is_reuseport_set(conn->context)) {
-			continue;
-		}
 
-		if (net_sin(&conn->remote_addr)->sin_port !=
-		    net_htons(remote_port)) {
-			continue;
-		}
-
-		if (conn->context != NULL && iface != NULL &&
-		    net_context_is_bound_to_iface(conn->context)) {
-			if (iface != net_context_get_iface(conn->context)) {
+			if (net_sin(&conn->remote_addr)->sin_port !=
+			    net_htons(remote_port)) {
 				continue;
 			}
-		}
 
-		k_mutex_unlock(&conn_lock);
-		return conn;
+			if (conn->context != NULL && iface != NULL &&
+			    net_context_is_bound_to_iface(conn->context)) {
+				if (iface != net_context_get_iface(conn->context)) {
+					continue;
+				}
+			}
+
+			k_mutex_unlock(&conn_lock);
+			return conn;
+		}
 	}
 
 	k_mutex_unlock(&conn_lock);
@@ -463,6 +510,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_chain(conn), &conn->hash_node);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -479,6 +527,7 @@ int net_conn_update(struct net_conn_handle *handle,
 		    uint16_t local_port)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
+	sys_slist_t *chain;
 	int ret;
 
 	if (conn < &conns[0] || conn > &conns[CONFIG_NET_MAX_CONN]) {
@@ -491,11 +540,21 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	chain = conn_chain(conn);
+
 	ret = net_conn_change_local(conn, local_addr, local_port);
 	if (ret < 0) {
 		return ret;
 	}
 
+	/* A new local port moves the handler to another chain */
+	if (conn_chain(conn) != chain) {
+		k_mutex_lock(&conn_lock, K_FOREVER);
+		sys_slist_find_and_remove(chain, &conn->hash_node);
+		sys_slist_prepend(conn_chain(conn), &conn->hash_node);
+		k_mutex_unlock(&conn_lock);
+	}
+
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
 	return ret;
@@ -844,6 +903,92 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 }
 #endif /* defined(CONFIG_NET_SOCKETS_CAN) */
 
+/* Is the candidate connection matching the packet? */
+static bool conn_match(struct net_conn *conn, struct net_pkt *pkt,
+		       union net_ip_header *ip_hdr, uint8_t proto,
+		       uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return false; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
+			      !conn->v6only && conn->type != NET_SOCK_RAW)) {
+				return false;
+			}
+		} else {
+			return false; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	uint8_t conn_family = conn->family;
+
+	if (!(IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) ||
+	    !(conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
+	      conn_family == NET_AF_UNSPEC)) {
+		return false; /* not a TCP/UDP handler */
+	}
+
+	/* Is the candidate connection matching the packet's TCP/UDP
+	 * address and port?
+	 */
+	if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == NET_AF_INET6 &&
+			      pkt_family == NET_AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -884,6 +1029,15 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		" family %d", net_proto2str(net_pkt_family(pkt), proto), pkt,
 		net_ntohs(src_port), net_ntohs(dst_port), net_pkt_family(pkt));
 
+	/* Handlers bound to the destination port, then the unbound ones.
+	 * Ranks on both chains never tie, as NET_CONN_LOCAL_PORT_SPEC is
+	 * set on the first one only, so the best match is the same as when
+	 * scanning all handlers.
+	 */
+	sys_slist_t *chains[] = {
+		conn_is_port_hashed(proto) ? conn_port_chain(proto, dst_port) : NULL,
+		&conn_wildcard,
+	};
 	struct net_conn *best_match = NULL;
 	int16_t best_rank = -1;
 	bool is_mcast_pkt = false;
@@ -909,78 +1063,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
-		}
-
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != NET_AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == NET_AF_INET6 && pkt_family == NET_AF_INET &&
-				      !conn->v6only && conn->type != NET_SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
-
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
-
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
+	ARRAY_FOR_EACH(chains, i) {
+		if (chains[i] == NULL) {
+			continue;
 		}
 
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
-
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == NET_AF_INET || conn_family == NET_AF_INET6 ||
-		     conn_family == NET_AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if ((conn->flags & NET_CONN_REMOTE_PORT_SPEC) != 0 &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) != 0 &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) != 0 &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == NET_AF_INET6 &&
-					      pkt_family == NET_AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+		SYS_SLIST_FOR_EACH_CONTAINER(chains[i], conn, hash_node) {
+			if (!conn_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -1091,6 +1181,11 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < ARRAY_SIZE(conn_port_hash); i++) {
+		sys_slist_init(&conn_port_hash[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
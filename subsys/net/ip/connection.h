@@ -54,6 +54,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node for the port hash or wildcard chain */
+	sys_snode_t hash_node;
+
 	/** Remote socket address */
 	struct net_sockaddr remote_addr;
 
@@ -170,6 +170,12 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %u\tconnrst\t%u",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+		NET_INFO("TCP rto exp    %u\tpaws\t%u",
+			 GET_STAT(iface, tcp.rto_expired),
+			 GET_STAT(iface, tcp.paws_drop));
+		NET_INFO("TCP srtt ms    %u\trto ms\t%u",
+			 GET_STAT(iface, tcp.srtt),
+			 GET_STAT(iface, tcp.rto));
 #endif
 
 		NET_INFO("Bytes received %llu", GET_STAT(iface, bytes.received));
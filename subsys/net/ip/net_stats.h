@@ -348,6 +348,23 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+static inline void net_stats_update_tcp_seg_paws_drop(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.paws_drop++);
+}
+
+static inline void net_stats_update_tcp_rto_expired(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.rto_expired++);
+}
+
+static inline void net_stats_update_tcp_rtt(struct net_if *iface,
+					    uint32_t srtt, uint32_t rto)
+{
+	UPDATE_STAT(iface, stats.tcp.srtt = srtt);
+	UPDATE_STAT(iface, stats.tcp.rto = rto);
+}
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -363,6 +380,9 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_seg_paws_drop(iface)
+#define net_stats_update_tcp_rto_expired(iface)
+#define net_stats_update_tcp_rtt(iface, srtt, rto)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
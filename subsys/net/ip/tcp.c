@@ -32,7 +32,8 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define LAST_ACK_TIMEOUT_MS tcp_max_timeout_ms
 #define LAST_ACK_TIMEOUT K_MSEC(LAST_ACK_TIMEOUT_MS)
 #define FIN_TIMEOUT K_MSEC(tcp_max_timeout_ms)
-#define ACK_DELAY K_MSEC(100)
+#define ACK_DELAY_MS 100
+#define ACK_DELAY K_MSEC(ACK_DELAY_MS)
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
 
@@ -59,20 +60,21 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
-/* Define the number of MSS sections the congestion window is initialized at */
-#define TCP_CONGESTION_INITIAL_WIN 1
-#define TCP_CONGESTION_INITIAL_SSTHRESH 3
-
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+/* Connections indexed by their 4-tuple for the receive path. The tcp_conns
+ * list and tcp_lock above are only needed when walking all connections.
+ */
+static struct tcp_conn_bucket tcp_conn_hash[BIT(CONFIG_NET_TCP_CONN_HASH_BITS)];
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -212,6 +214,70 @@ static size_t tcp_endpoint_len(net_sa_family_t af)
 		sizeof(struct net_sockaddr_in6);
 }
 
+static struct tcp_conn_bucket *tcp_conn_bucket_get(const union tcp_endpoint *local,
+						   const union tcp_endpoint *remote)
+{
+	const uint32_t *addr;
+	size_t words;
+	uint32_t hash;
+
+	/* Only the remote address is hashed, local addresses are few. Ports
+	 * and addresses stay in network byte order, which is fine here.
+	 */
+	if (IS_ENABLED(CONFIG_NET_IPV6) && remote->sa.sa_family == NET_AF_INET6) {
+		hash = ((uint32_t)local->sin6.sin6_port << 16) | remote->sin6.sin6_port;
+		addr = remote->sin6.sin6_addr.s6_addr32;
+		words = ARRAY_SIZE(remote->sin6.sin6_addr.s6_addr32);
+	} else {
+		hash = ((uint32_t)local->sin.sin_port << 16) | remote->sin.sin_port;
+		addr = remote->sin.sin_addr.s4_addr32;
+		words = ARRAY_SIZE(remote->sin.sin_addr.s4_addr32);
+	}
+
+	for (size_t i = 0; i < words; i++) {
+		hash = (hash ^ addr[i]) * 0x9e3779b1U;
+	}
+
+	hash ^= hash >> 16;
+
+	return &tcp_conn_hash[hash & (ARRAY_SIZE(tcp_conn_hash) - 1)];
+}
+
+static void tcp_conn_hash_remove(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket = conn->bucket;
+	k_spinlock_key_t key;
+
+	if (bucket == NULL) {
+		return;
+	}
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_find_and_remove(&bucket->conns, &conn->hash_node);
+	k_spin_unlock(&bucket->lock, key);
+
+	conn->bucket = NULL;
+}
+
+/* Make the connection visible to tcp_conn_search(), conn->src and conn->dst
+ * must be final.
+ */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket;
+	k_spinlock_key_t key;
+
+	tcp_conn_hash_remove(conn);
+
+	bucket = tcp_conn_bucket_get(&conn->src, &conn->dst);
+
+	key = k_spin_lock(&bucket->lock);
+	sys_slist_append(&bucket->conns, &conn->hash_node);
+	k_spin_unlock(&bucket->lock, key);
+
+	conn->bucket = bucket;
+}
+
 static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 			    enum pkt_addr src)
 {
@@ -471,124 +537,335 @@ out:
 	tcp_pkt_unref(pkt);
 }
 
-static void tcp_derive_rto(struct tcp *conn)
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+
+/* Timestamps option according to RFC7323, RTT estimation according to RFC6298 */
+
+/* Upper bound of the RTO, RFC 6298 ch 2.5 */
+#define TCP_RTO_MAX_MS 60000
+
+static uint32_t tcp_ts_now(struct tcp *conn)
+{
+	return k_uptime_get_32() + conn->ts_offset;
+}
+
+static uint32_t tcp_rto_estimate(struct tcp *conn)
 {
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
-	uint32_t gain;
-	uint8_t gain8;
 	uint32_t rto;
 
-	/* Getting random is computational expensive, so only use 8 bits */
-	sys_rand_get(&gain8, sizeof(uint8_t));
+	if (conn->srtt == 0U) {
+		/* No RTT sample yet */
+		return (uint32_t)tcp_rto;
+	}
 
-	gain = (uint32_t)gain8;
-	gain += 1 << 9;
+	/* RTO = SRTT + max(G, 4 * RTTVAR), rttvar is already scaled by 4 */
+	rto = (conn->srtt >> 3) + MAX(conn->rttvar, 1U);
 
-	rto = (uint32_t)tcp_rto;
-	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+	return CLAMP(rto, CONFIG_NET_TCP_MIN_RETRANSMISSION_TIMEOUT, TCP_RTO_MAX_MS);
+}
+#else
+#define tcp_rto_estimate(conn) ((uint32_t)tcp_rto)
+#endif
+
+static void tcp_rto_update(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = tcp_rto_estimate(conn);
+
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	/* Between 1 and 1.5 times the estimate */
+	rto = (((uint32_t)conn->rto_gain + (1 << 9)) * rto) >> 9;
+#endif
+	conn->rto = (uint16_t)MIN(rto, UINT16_MAX);
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
-#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+static void tcp_derive_rto(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	/* Getting random is computational expensive, so only use 8 bits */
+	sys_rand_get(&conn->rto_gain, sizeof(uint8_t));
+#endif
+	tcp_rto_update(conn);
+}
 
-/* Implementation according to RFC6582 */
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+/* Without timestamps, one segment per window is timed for the RTT sample.
+ * Retransmitted segments are never timed (Karn's algorithm).
+ */
+static void tcp_rtt_start(struct tcp *conn, uint32_t seq, int len)
 {
-	NET_DBG("[%p] ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	if (conn->rtt_pending || conn->data_mode != TCP_DATA_MODE_SEND) {
+		return;
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		return;
+	}
+#endif
+
+	conn->rtt_seq = seq + len;
+	conn->rtt_start = k_uptime_get_32();
+	conn->rtt_pending = true;
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
+static void tcp_rtt_cancel(struct tcp *conn)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	conn->rtt_pending = false;
 }
 
-static void tcp_new_reno_fast_retransmit(struct tcp *conn)
+/* RTT sample in ms taken when acked_len new bytes are acknowledged, 0 if none */
+static uint32_t tcp_rtt_sample(struct tcp *conn, uint32_t acked_len)
 {
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-		/* Account for the lost segments */
-		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
-		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+	uint32_t rtt = 0U;
+
+	if (conn->rtt_pending &&
+	    net_tcp_seq_cmp(conn->seq + acked_len, conn->rtt_seq) >= 0) {
+		rtt = MAX(k_uptime_get_32() - conn->rtt_start, 1U);
+		conn->rtt_pending = false;
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* The echoed timestamp is unambiguous, also for retransmitted data.
+	 * A zero TSecr is what is sent before there is anything to echo.
+	 */
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    conn->recv_options.tsecr != 0U) {
+		int32_t ts_rtt = (int32_t)(tcp_ts_now(conn) - conn->recv_options.tsecr);
+
+		if (ts_rtt >= 0) {
+			rtt = MAX((uint32_t)ts_rtt, 1U);
+		}
 	}
+#endif
+
+	return rtt;
 }
+#else
+
+static void tcp_rtt_start(struct tcp *conn, uint32_t seq, int len) { }
+
+static void tcp_rtt_cancel(struct tcp *conn) { }
+
+#define tcp_rtt_sample(...) 0U
 
-static void tcp_new_reno_timeout(struct tcp *conn)
+#endif
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+
+/* The smoothed RTT is kept scaled by 8 and the variation by 4 */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
 {
-	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
-	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	int32_t delta;
+
+	if (rtt == 0U) {
+		return;
+	}
+
+	rtt = MIN(rtt, TCP_RTO_MAX_MS);
+
+	if (conn->srtt == 0U) {
+		/* First measurement, RFC 6298 ch 2.2 */
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		/* Subsequent measurements with alpha = 1/8 and beta = 1/4,
+		 * RFC 6298 ch 2.3
+		 */
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt = (uint32_t)((int32_t)conn->srtt + delta);
+		conn->rttvar = conn->rttvar - (conn->rttvar >> 2) + (uint32_t)abs(delta);
+	}
+
+	tcp_rto_update(conn);
+
+	NET_DBG("[%p] rtt=%u, srtt=%u, rttvar=%u, rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+
+	net_stats_update_tcp_rtt(conn->iface, conn->srtt >> 3, conn->rto);
 }
 
-/* For every duplicate ack increment the cwnd by mss */
-static void tcp_new_reno_dup_ack(struct tcp *conn)
+/* Old duplicates are rejected by the PAWS check, RFC 7323 ch 5.3. The
+ * TSval to be echoed is only taken from segments that are in order. A RST
+ * is exempt, as its timestamp may be stale.
+ */
+static bool tcp_ts_check(struct tcp *conn, struct tcphdr *th)
 {
-	int32_t new_win = conn->ca.cwnd;
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (!conn->ts_ok || !opts->ts_found || (th_flags(th) & RST) ||
+	    conn->state == TCP_LISTEN || conn->state == TCP_SYN_SENT) {
+		return true;
+	}
+
+	if ((int32_t)(opts->tsval - conn->ts_recent) < 0) {
+		NET_DBG("[%p] PAWS: TSval %u older than %u", conn, opts->tsval,
+			conn->ts_recent);
+		return false;
+	}
 
-	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	if (net_tcp_seq_cmp(th_seq(th), conn->last_ack_sent) <= 0) {
+		conn->ts_recent = opts->tsval;
+	}
+
+	return true;
 }
 
-static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
+/* Negotiated when the SYN of the peer carries the option */
+static void tcp_ts_syn_received(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	conn->ts_ok = conn->recv_options.ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+}
 
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
-		if (conn->ca.cwnd < conn->ca.ssthresh) {
-			new_win += win_inc;
-		} else {
-			/* Implement a div_ceil	to avoid rounding to 0 */
-			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
-		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
-		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
-		}
+static size_t tcp_ts_opts_len(struct tcp *conn, uint8_t flags)
+{
+	return (conn->ts_ok && !(flags & RST)) ? NET_TCP_TIMESTAMP_OPTS_SIZE : 0;
+}
+
+static int tcp_ts_opts_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags)
+{
+	if (tcp_ts_opts_len(conn, flags) == 0) {
+		return 0;
+	}
+
+	/* TSecr is only valid with ACK, there is nothing to echo in a SYN */
+	if (net_pkt_write_be32(pkt, (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+				    (NET_TCP_TIMESTAMP_OPT << 8) |
+				    NET_TCP_TIMESTAMP_SIZE) < 0 ||
+	    net_pkt_write_be32(pkt, tcp_ts_now(conn)) < 0 ||
+	    net_pkt_write_be32(pkt, (flags & ACK) ? conn->ts_recent : 0U) < 0) {
+		return -ENOBUFS;
+	}
+
+	if (flags & ACK) {
+		conn->last_ack_sent = conn->ack;
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+
+	return 0;
+}
+#else
+
+#define tcp_rtt_update(...)
+#define tcp_ts_check(...) true
+#define tcp_ts_syn_received(...)
+#define tcp_ts_opts_len(...) 0
+#define tcp_ts_opts_add(...) 0
+
+#endif
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+
+/* The congestion control algorithms are implemented in tcp_cc_*.c */
+
+static void tcp_ca_log(struct tcp *conn, const char *step)
+{
+	NET_DBG("[%p] ca %s %s, cwnd=%u, ssthresh=%u", conn, conn->ca.ops->name,
+		step, conn->ca.cwnd, conn->ca.ssthresh);
 }
 
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	if (conn->ca.ops == NULL) {
+		conn->ca.ops = tcp_cc_default();
+	}
+
+	conn->ca.mss = conn_mss(conn);
+	memset(conn->ca.priv, 0, sizeof(conn->ca.priv));
+	conn->ca.ops->init(&conn->ca);
+	tcp_ca_log(conn, "init");
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	if (conn->ca.ops->fast_retransmit != NULL) {
+		conn->ca.ops->fast_retransmit(&conn->ca, conn->unacked_len);
+		tcp_ca_log(conn, "fast_retransmit");
+	}
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(&conn->ca, conn->unacked_len);
+	tcp_ca_log(conn, "timeout");
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	if (conn->ca.ops->dup_ack != NULL) {
+		conn->ca.ops->dup_ack(&conn->ca);
+		tcp_ca_log(conn, "dup_ack");
+	}
 }
 
-static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
+static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_ms)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	struct tcp_cc_ack ack = {
+		.acked = acked_len,
+		.in_flight = conn->unacked_len,
+		.rtt_ms = rtt_ms,
+	};
+
+	conn->ca.ops->pkts_acked(&conn->ca, &ack);
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+/* Accepted connections inherit the algorithm of the listening socket */
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca.ops = from->ca.ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, uint32_t len)
+{
+	const struct tcp_cc_ops *ops;
+
+	if (conn == NULL || value == NULL) {
+		return -EINVAL;
+	}
+
+	ops = tcp_cc_find(value, strnlen(value, len));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	conn->ca.ops = ops;
+
+	/* Switching on an established connection restarts from the initial
+	 * window of the new algorithm.
+	 */
+	if (conn->ca.mss != 0) {
+		tcp_ca_init(conn);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, uint32_t *len)
+{
+	const struct tcp_cc_ops *ops;
+	uint32_t name_len;
+
+	if (conn == NULL || value == NULL || len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	ops = conn->ca.ops != NULL ? conn->ca.ops : tcp_cc_default();
+	name_len = strlen(ops->name);
+
+	/* Truncated to the buffer size, always NUL terminated */
+	name_len = MIN(name_len + 1, *len);
+	memcpy(value, ops->name, name_len);
+	((char *)value)[name_len - 1] = '\0';
+	*len = name_len;
+
+	return 0;
 }
 #else
 
@@ -600,10 +877,168 @@ static void tcp_ca_timeout(struct tcp *conn) { }
 
 static void tcp_ca_dup_ack(struct tcp *conn) { }
 
-static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
+static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len, uint32_t rtt_ms) { }
+
+#define tcp_ca_param_copy(...)
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
 
 #endif
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+/* Selective acknowledgment according to RFC2018, loss detection according
+ * to RFC8985 (RACK-TLP)
+ */
+
+#define tcp_sack_ok(conn) ((conn)->sack_ok)
+
+/* Both SACK options are padded with two NOPs to keep 32-bit alignment */
+#define TCP_SACK_PERM_OPTS_SIZE (2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE)
+#define TCP_SACK_BLOCK_OPT_SIZE (2 + NET_TCP_SACK_BLOCK_SIZE)
+#define TCP_SACK_BLOCK_OPTS_SIZE (2 * NET_TCP_NOP_SIZE + TCP_SACK_BLOCK_OPT_SIZE)
+
+/* The out-of-order queue is only reported in segments without payload,
+ * a SACK option in a full sized data segment would exceed the MSS.
+ */
+static bool tcp_sack_block_needed(struct tcp *conn, uint8_t flags,
+				  struct net_pkt *data)
+{
+	return conn->sack_ok && data == NULL && (flags & ACK) &&
+	       !(flags & (SYN | RST)) && conn->queue_recv_data != NULL;
+}
+
+static size_t tcp_sack_opts_len(struct tcp *conn, uint8_t flags,
+				struct net_pkt *data)
+{
+	size_t len = 0;
+
+	if (conn->send_options.sack_perm_found) {
+		len += TCP_SACK_PERM_OPTS_SIZE;
+	}
+
+	if (tcp_sack_block_needed(conn, flags, data)) {
+		len += TCP_SACK_BLOCK_OPTS_SIZE;
+	}
+
+	return len;
+}
+
+static int tcp_sack_opts_add(struct tcp *conn, struct net_pkt *pkt,
+			     uint8_t flags, struct net_pkt *data)
+{
+	uint32_t left;
+
+	if (conn->send_options.sack_perm_found &&
+	    net_pkt_write_be32(pkt, (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+				    (NET_TCP_SACK_PERM_OPT << 8) |
+				    NET_TCP_SACK_PERM_SIZE) < 0) {
+		return -ENOBUFS;
+	}
+
+	if (!tcp_sack_block_needed(conn, flags, data)) {
+		return 0;
+	}
+
+	left = tcp_get_seq(conn->queue_recv_data);
+
+	if (net_pkt_write_be32(pkt, (NET_TCP_NOP_OPT << 24) | (NET_TCP_NOP_OPT << 16) |
+				    (NET_TCP_SACK_OPT << 8) |
+				    TCP_SACK_BLOCK_OPT_SIZE) < 0 ||
+	    net_pkt_write_be32(pkt, left) < 0 ||
+	    net_pkt_write_be32(pkt, left + net_buf_frags_len(conn->queue_recv_data)) < 0) {
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+/* Is the transmission (t1, end1) more recent than (t2, end2), RFC 8985 ch 6.2 */
+static bool tcp_sack_sent_after(uint32_t t1, uint32_t end1, uint32_t t2, uint32_t end2)
+{
+	return (int32_t)(t1 - t2) > 0 ||
+	       (t1 == t2 && net_tcp_seq_cmp(end1, end2) > 0);
+}
+
+/* Tail loss probe timeout, RFC 8985 ch 7.2 */
+static uint32_t tcp_sack_pto(struct tcp *conn)
+{
+	uint32_t pto;
+
+	if (conn->sack.srtt == 0U) {
+		/* No RTT sample yet */
+		pto = MSEC_PER_SEC;
+	} else {
+		pto = 2U * conn->sack.srtt;
+
+		/* A single segment in flight may be acknowledged late */
+		if (conn->unacked_len <= conn_mss(conn)) {
+			pto += ACK_DELAY_MS;
+		}
+	}
+
+	return MIN(pto, (uint32_t)TCP_RTO_MS);
+}
+
+static void tcp_sack_arm_tlp(struct tcp *conn)
+{
+	conn->sack.tlp_armed = true;
+	k_work_reschedule_for_queue(&tcp_work_q, &conn->recovery_timer,
+				    K_MSEC(tcp_sack_pto(conn)));
+}
+
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack.count = 0U;
+	conn->sack.in_recovery = false;
+	conn->sack.tlp_armed = false;
+	conn->sack.tlp_sent = false;
+	(void)k_work_cancel_delayable(&conn->recovery_timer);
+}
+
+/* Track a segment in the scoreboard once it has been handed to the IP layer */
+static void tcp_sack_sent(struct tcp *conn, uint32_t seq, uint16_t len)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	/* Data sent again from an earlier sequence number, which happens
+	 * after a retransmission timeout, supersedes the segments beyond it.
+	 */
+	while (sb->count > 0U &&
+	       net_tcp_seq_cmp(sb->segs[sb->count - 1U].seq, seq) >= 0) {
+		sb->count--;
+	}
+
+	if (sb->count < ARRAY_SIZE(sb->segs)) {
+		sb->segs[sb->count++] = (struct tcp_sack_seg) {
+			.seq = seq,
+			.xmit_time = k_uptime_get_32(),
+			.len = len,
+			.flags = conn->data_mode == TCP_DATA_MODE_RESEND ?
+				 TCP_SACK_SEG_RETRANS : 0U,
+		};
+	}
+
+	if (conn->data_mode == TCP_DATA_MODE_SEND && !sb->in_recovery && !sb->tlp_sent &&
+	    !k_work_delayable_is_pending(&conn->recovery_timer)) {
+		tcp_sack_arm_tlp(conn);
+	}
+}
+
+#else /* CONFIG_NET_TCP_SACK */
+
+#define tcp_sack_ok(...) false
+#define tcp_sack_opts_len(...) 0
+#define tcp_sack_opts_add(...) 0
+#define tcp_sack_reset(...)
+#define tcp_sack_sent(...)
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 
 static void tcp_send_keepalive_probe(struct k_work *work);
@@ -902,12 +1337,15 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
 	keep_alive_timer_stop(conn);
+	tcp_sack_reset(conn);
 
 	k_mutex_unlock(&conn->lock);
 
 	net_context_unref(conn->context);
 	conn->context = NULL;
 
+	tcp_conn_hash_remove(conn);
+
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 	k_mutex_unlock(&tcp_lock);
@@ -1097,7 +1535,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, uint8_t flags)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1107,8 +1545,20 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* The options of the SYN stay valid for the whole connection, they
+	 * must not be reset by the options carried in later segments.
+	 */
+	if (flags & SYN) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_blocks = 0;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	recv_options->ts_found = false;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1157,6 +1607,45 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_blocks < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_blocks++];
+
+				block->left = net_ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->right = net_ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
+			break;
+#endif /* CONFIG_NET_TCP_SACK */
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = net_ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr = net_ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
 		default:
 			continue;
 		}
@@ -1347,7 +1836,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1361,11 +1850,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / sizeof(uint32_t);
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(net_htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
@@ -1557,15 +2042,16 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	size_t opts_len = tcp_sack_opts_len(conn, flags, data) +
+			  tcp_ts_opts_len(conn, flags);
 	struct net_pkt *pkt;
 	int ret = 0;
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += NET_TCP_MSS_SIZE;
 	}
 
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -1583,7 +2069,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1597,6 +2083,18 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	ret = tcp_sack_opts_add(conn, pkt, flags, data);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
+	ret = tcp_ts_opts_add(conn, pkt, flags);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1847,6 +2345,8 @@ static int tcp_send_data(struct tcp *conn)
 
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
+		tcp_sack_sent(conn, conn->seq + conn->unacked_len, len);
+		tcp_rtt_start(conn, conn->seq + conn->unacked_len, len);
 		conn->unacked_len += len;
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
@@ -1933,6 +2433,266 @@ static void tcp_cleanup_recv_queue(struct k_work *work)
 	k_mutex_unlock(&conn->lock);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+static bool tcp_sack_covered(struct tcp_options *opts, uint32_t seq, uint32_t end)
+{
+	for (uint8_t i = 0U; i < opts->sack_blocks; i++) {
+		if (net_tcp_seq_cmp(opts->sack[i].left, seq) <= 0 &&
+		    net_tcp_seq_cmp(end, opts->sack[i].right) <= 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Update the RACK state with a newly delivered segment, RFC 8985 ch 6.2 */
+static void tcp_sack_delivered(struct tcp_sack_scoreboard *sb,
+			       struct tcp_sack_seg *seg, uint32_t now)
+{
+	uint32_t rtt = MAX(now - seg->xmit_time, 1U);
+	uint32_t end = seg->seq + seg->len;
+	bool first = (sb->rack_rtt == 0U);
+
+	/* An acknowledgment received sooner than the minimum RTT after a
+	 * retransmission was most likely sent for the original transmission.
+	 */
+	if ((seg->flags & TCP_SACK_SEG_RETRANS) && rtt < sb->min_rtt) {
+		return;
+	}
+
+	if (!(seg->flags & TCP_SACK_SEG_RETRANS)) {
+		sb->min_rtt = (sb->min_rtt == 0U) ? rtt : MIN(sb->min_rtt, rtt);
+		sb->srtt = (sb->srtt == 0U) ? rtt : (7U * sb->srtt + rtt) / 8U;
+	}
+
+	sb->rack_rtt = rtt;
+
+	if (first || tcp_sack_sent_after(seg->xmit_time, end,
+					 sb->rack_xmit_time, sb->rack_end_seq)) {
+		sb->rack_xmit_time = seg->xmit_time;
+		sb->rack_end_seq = end;
+	}
+}
+
+/* Mark as lost the segments sent sufficiently long before the most recently
+ * delivered one. Returns the time in ms until the next segment would be
+ * marked lost, or 0 if none is pending.
+ */
+static uint32_t tcp_sack_detect_loss(struct tcp_sack_scoreboard *sb)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t reo_wnd = MIN(sb->min_rtt / 4U, sb->srtt);
+	uint32_t timeout = 0U;
+
+	if (sb->rack_rtt == 0U) {
+		/* Nothing delivered yet */
+		return 0U;
+	}
+
+	for (uint8_t i = 0U; i < sb->count; i++) {
+		struct tcp_sack_seg *seg = &sb->segs[i];
+		int32_t remaining;
+
+		if ((seg->flags & (TCP_SACK_SEG_SACKED | TCP_SACK_SEG_LOST)) ||
+		    !tcp_sack_sent_after(sb->rack_xmit_time, sb->rack_end_seq,
+					 seg->xmit_time, seg->seq + seg->len)) {
+			continue;
+		}
+
+		remaining = (int32_t)(seg->xmit_time + sb->rack_rtt + reo_wnd - now);
+		if (remaining <= 0) {
+			seg->flags |= TCP_SACK_SEG_LOST;
+		} else {
+			timeout = MAX(timeout, (uint32_t)remaining);
+		}
+	}
+
+	return timeout;
+}
+
+static int tcp_sack_resend(struct tcp *conn, struct tcp_sack_seg *seg)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_pkt_alloc(conn, seg->len);
+	if (!pkt) {
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, &conn->send_data, seg->seq - conn->seq, seg->len);
+	if (ret == 0) {
+		ret = tcp_out_ext(conn, PSH | ACK, pkt, seg->seq);
+	}
+
+	tcp_pkt_unref(pkt);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	tcp_rtt_cancel(conn);
+	seg->xmit_time = k_uptime_get_32();
+	seg->flags = (seg->flags | TCP_SACK_SEG_RETRANS) & ~TCP_SACK_SEG_LOST;
+
+	net_stats_update_tcp_resent(conn->iface, seg->len);
+	net_stats_update_tcp_seg_rexmit(conn->iface);
+
+	return 0;
+}
+
+/* Retransmit the segments RACK deems lost and schedule the next timeout */
+static void tcp_sack_recover(struct tcp *conn)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+	uint32_t timeout = tcp_sack_detect_loss(sb);
+
+	for (uint8_t i = 0U; i < sb->count; i++) {
+		struct tcp_sack_seg *seg = &sb->segs[i];
+
+		if (!(seg->flags & TCP_SACK_SEG_LOST)) {
+			continue;
+		}
+
+		if (!sb->in_recovery) {
+			sb->in_recovery = true;
+			sb->recovery_point = conn->seq + conn->unacked_len;
+
+			tcp_ca_fast_retransmit(conn);
+			if (tcp_window_full(conn)) {
+				(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+			}
+		}
+
+		if (tcp_sack_resend(conn, seg) < 0) {
+			break;
+		}
+	}
+
+	if (timeout > 0U) {
+		sb->tlp_armed = false;
+		k_work_reschedule_for_queue(&tcp_work_q, &conn->recovery_timer,
+					    K_MSEC(timeout));
+	} else if (!sb->in_recovery && !sb->tlp_sent) {
+		tcp_sack_arm_tlp(conn);
+	} else {
+		sb->tlp_armed = false;
+		(void)k_work_cancel_delayable(&conn->recovery_timer);
+	}
+}
+
+/* Process the cumulative acknowledgment and the SACK blocks of a segment
+ * received in the ESTABLISHED state.
+ */
+static void tcp_sack_ack(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+	uint32_t now = k_uptime_get_32();
+	uint8_t acked = 0U;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	sb->tlp_sent = false;
+
+	for (uint8_t i = 0U; i < sb->count; i++) {
+		struct tcp_sack_seg *seg = &sb->segs[i];
+		uint32_t end = seg->seq + seg->len;
+
+		if (net_tcp_seq_cmp(end, ack) <= 0) {
+			/* Segments are in sequence order, so these come first */
+			acked++;
+		} else if (net_tcp_seq_cmp(seg->seq, ack) < 0) {
+			/* Partially acknowledged, track only the remainder */
+			seg->len = end - ack;
+			seg->seq = ack;
+			continue;
+		} else if (!tcp_sack_covered(&conn->recv_options, seg->seq, end)) {
+			continue;
+		}
+
+		if (!(seg->flags & TCP_SACK_SEG_SACKED)) {
+			seg->flags = (seg->flags | TCP_SACK_SEG_SACKED) & ~TCP_SACK_SEG_LOST;
+			tcp_sack_delivered(sb, seg, now);
+		}
+	}
+
+	/* The blocks have been consumed, segments without options carry none */
+	conn->recv_options.sack_blocks = 0U;
+
+	if (acked > 0U) {
+		sb->count -= acked;
+		memmove(&sb->segs[0], &sb->segs[acked], sb->count * sizeof(sb->segs[0]));
+	}
+
+	if (sb->in_recovery && net_tcp_seq_cmp(ack, sb->recovery_point) >= 0) {
+		sb->in_recovery = false;
+	}
+
+	if (sb->count == 0U || conn->data_mode == TCP_DATA_MODE_RESEND) {
+		sb->tlp_armed = false;
+		(void)k_work_cancel_delayable(&conn->recovery_timer);
+		return;
+	}
+
+	tcp_sack_recover(conn);
+}
+
+/* Send a tail loss probe, RFC 8985 ch 7.3: new data if the window allows,
+ * otherwise the last segment sent.
+ */
+static void tcp_sack_probe(struct tcp *conn)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+
+	sb->tlp_sent = true;
+
+	if (tcp_unsent_len(conn) > 0 && tcp_send_data(conn) == 0) {
+		return;
+	}
+
+	for (int i = sb->count - 1; i >= 0; i--) {
+		if (!(sb->segs[i].flags & TCP_SACK_SEG_SACKED)) {
+			(void)tcp_sack_resend(conn, &sb->segs[i]);
+			break;
+		}
+	}
+}
+
+static void tcp_sack_recovery_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, recovery_timer);
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_ESTABLISHED || sb->count == 0U ||
+	    conn->data_mode == TCP_DATA_MODE_RESEND) {
+		sb->tlp_armed = false;
+		goto out;
+	}
+
+	if (sb->tlp_armed) {
+		sb->tlp_armed = false;
+		tcp_sack_probe(conn);
+	} else {
+		tcp_sack_recover(conn);
+	}
+
+out:
+	k_mutex_unlock(&conn->lock);
+}
+
+#else /* CONFIG_NET_TCP_SACK */
+
+#define tcp_sack_ack(...)
+
+#endif /* CONFIG_NET_TCP_SACK */
+
 static void tcp_resend_data(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1961,6 +2721,8 @@ static void tcp_resend_data(struct k_work *work)
 		break;
 	case TCP_ESTABLISHED:
 	case TCP_CLOSE_WAIT:
+		tcp_rtt_cancel(conn);
+
 		if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) &&
 		    (conn->send_data_retries == 0)) {
 			tcp_ca_timeout(conn);
@@ -1969,6 +2731,7 @@ static void tcp_resend_data(struct k_work *work)
 			}
 		}
 
+		tcp_sack_reset(conn);
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
 
@@ -1991,6 +2754,7 @@ static void tcp_resend_data(struct k_work *work)
 	}
 
 	conn->send_data_retries++;
+	net_stats_update_tcp_rto_expired(conn->iface);
 
 	exp_tcp_rto = TCP_RTO_MS;
 	/* The last retransmit does not need to wait that long */
@@ -2205,6 +2969,10 @@ static struct tcp *tcp_conn_alloc(void)
 	 */
 	conn->ca.cwnd = UINT16_MAX;
 #endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* The sent timestamps do not reveal the uptime */
+	conn->ts_offset = sys_rand32_get();
+#endif
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -2220,6 +2988,9 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
+#if defined(CONFIG_NET_TCP_SACK)
+	k_work_init_delayable(&conn->recovery_timer, tcp_sack_recovery_timeout);
+#endif
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
 
@@ -2252,42 +3023,35 @@ int net_tcp_get(struct net_context *context)
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	union tcp_endpoint ep_tmp;
+	struct tcp_conn_bucket *bucket;
+	union tcp_endpoint local;
+	union tcp_endpoint remote;
+	k_spinlock_key_t key;
+	struct tcp *conn;
+	size_t len;
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
+	if (tcp_endpoint_set(&local, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&remote, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
 	}
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
-}
-
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
-{
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
-}
-
-static struct tcp *tcp_conn_search(struct net_pkt *pkt)
-{
-	bool found = false;
-	struct tcp *conn;
-	struct tcp *tmp;
+	len = tcp_endpoint_len(local.sa.sa_family);
+	bucket = tcp_conn_bucket_get(&local, &remote);
 
-	k_mutex_lock(&tcp_lock, K_FOREVER);
+	key = k_spin_lock(&bucket->lock);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
+	SYS_SLIST_FOR_EACH_CONTAINER(&bucket->conns, conn, hash_node) {
+		if (!memcmp(&conn->src, &local, len) &&
+		    !memcmp(&conn->dst, &remote, len)) {
 			break;
 		}
 	}
 
-	k_mutex_unlock(&tcp_lock);
+	k_spin_unlock(&bucket->lock, key);
 
-	return found ? conn : NULL;
+	return conn;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -2562,6 +3326,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	net_if_addr_ref(conn->iface, conn->dst.sa.sa_family,
 			conn->src.sa.sa_family == NET_AF_INET ?
 			(const void *)&conn->src.sin.sin_addr :
@@ -2999,8 +3765,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->recv_options.ts_found = false;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len, fl)) {
 		NET_DBG("[%p] DROP: Invalid TCP option list", conn);
 		net_tcp_reply_rst(pkt);
 		do_close = true;
@@ -3022,6 +3792,14 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (!tcp_ts_check(conn, th)) {
+		net_stats_update_tcp_seg_paws_drop(conn->iface);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		k_mutex_unlock(&conn->lock);
+		return NET_DROP;
+	}
+
 	/* Now validate the ACK flag and ACKnum */
 	if ((conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT)) {
 		uint32_t snduna = conn->seq;
@@ -3094,10 +3872,17 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_SACK)
+			/* Only permit SACK if the peer offered it */
+			conn->sack_ok = conn->recv_options.sack_perm_found;
+			conn->send_options.sack_perm_found = conn->sack_ok;
+#endif
+			tcp_ts_syn_received(conn);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
+			conn->send_options.sack_perm_found = false;
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -3123,10 +3908,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
 			k_work_cancel_delayable(&conn->send_data_timer);
+			/* The ACK echoes the timestamp of our SYN | ACK */
+			tcp_rtt_update(conn, tcp_rtt_sample(conn, 0U));
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -3209,6 +3997,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			k_work_cancel_delayable(&conn->send_data_timer);
 			conn->isn_peer = th_seq(th);
 			conn_ack(conn, th_seq(th) + 1);
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+			tcp_ts_syn_received(conn);
+			/* The SYN | ACK echoes the timestamp of our SYN */
+			tcp_rtt_update(conn, tcp_rtt_sample(conn, 0U));
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
 				if (verdict == NET_OK) {
@@ -3270,7 +4064,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			}
 
 			/* Only do fast retransmit when not already in a resend state */
-			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			/* With SACK, RACK detects the losses from the scoreboard */
+			if ((conn->data_mode == TCP_DATA_MODE_SEND) && !tcp_sack_ok(conn) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
 				int temp_unacked_len = conn->unacked_len;
@@ -3282,6 +4077,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				/* Restore the current transmission */
 				conn->unacked_len = temp_unacked_len;
 
+				tcp_rtt_cancel(conn);
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
@@ -3296,6 +4092,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
+			uint32_t rtt;
 
 			NET_DBG("[%p] len_acked=%u", conn, len_acked);
 
@@ -3316,7 +4113,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			/* New segment, reset duplicate ack counter */
 			conn->dup_ack_cnt = 0;
 #endif
-			tcp_ca_pkts_acked(conn, len_acked);
+			rtt = tcp_rtt_sample(conn, len_acked);
+			tcp_rtt_update(conn, rtt);
+			tcp_ca_pkts_acked(conn, len_acked, rtt);
 
 			conn->send_data_total -= len_acked;
 			if (conn->unacked_len < len_acked) {
@@ -3389,6 +4188,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			}
 		}
 
+		tcp_sack_ack(conn, th_ack(th));
+
 		if (th_seq(th) == conn->ack) {
 			if (len > 0) {
 				bool psh;
@@ -3913,7 +4714,15 @@ static int tcp_start_handshake(struct tcp *conn)
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
 	conn->send_options.mss_found = true;
+	conn->send_options.sack_perm_found = IS_ENABLED(CONFIG_NET_TCP_SACK);
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Offer the timestamps option, it is dropped if the SYN | ACK of the
+	 * peer does not carry it.
+	 */
+	conn->ts_ok = true;
+#endif
 	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
+	conn->send_options.sack_perm_found = false;
 	if (ret < 0) {
 		k_mutex_unlock(&conn->lock);
 		return ret;
@@ -4048,6 +4857,8 @@ int net_tcp_connect(struct net_context *context,
 		goto out;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	net_if_addr_ref(conn->iface, conn->src.sa.sa_family,
 			conn->src.sa.sa_family == NET_AF_INET ?
 			(const void *)&conn->src.sin.sin_addr :
@@ -4271,6 +5082,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -4395,6 +5207,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -4683,6 +5496,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4720,6 +5536,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -0,0 +1,42 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control module registry */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+#include "tcp_cc.h"
+
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len)
+{
+	if (name == NULL || len == 0 || len > TCP_CC_NAME_MAX) {
+		return NULL;
+	}
+
+	STRUCT_SECTION_FOREACH(tcp_cc_ops, ops) {
+		if (strncmp(ops->name, name, len) == 0 && ops->name[len] == '\0') {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+const struct tcp_cc_ops *tcp_cc_default(void)
+{
+	static const struct tcp_cc_ops *ops;
+
+	if (ops == NULL) {
+		ops = tcp_cc_find(CONFIG_NET_TCP_CC_DEFAULT,
+				  sizeof(CONFIG_NET_TCP_CC_DEFAULT) - 1);
+		__ASSERT(ops != NULL, "TCP congestion control \"%s\" not found",
+			 CONFIG_NET_TCP_CC_DEFAULT);
+	}
+
+	return ops;
+}
@@ -0,0 +1,141 @@
+/** @file
+ * @brief TCP congestion control modules
+ *
+ * The TCP stack calls the congestion control module selected for a
+ * connection through the callbacks of struct tcp_cc_ops. Modules are
+ * registered at build time with TCP_CC_DEFINE() and looked up by name,
+ * either from CONFIG_NET_TCP_CC_DEFAULT or from the TCP_CONGESTION socket
+ * option.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TCP_CC_H
+#define __TCP_CC_H
+
+#include <zephyr/types.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum length of a congestion control module name, without the NUL */
+#define TCP_CC_NAME_MAX 15
+
+/** Size of the per-connection state reserved for the module */
+#define TCP_CC_PRIV_SIZE 48
+
+/** The send window is at most 16 bits wide, a larger cwnd has no effect */
+#define TCP_CC_CWND_MAX UINT16_MAX
+
+/** Initial congestion window and slow start threshold, in segments */
+#define TCP_CC_INITIAL_WIN 1
+#define TCP_CC_INITIAL_SSTHRESH 3
+
+struct tcp_cc_ops;
+
+/** Congestion control state of a TCP connection */
+struct tcp_cc {
+	const struct tcp_cc_ops *ops;
+	/** Congestion window, in bytes */
+	uint32_t cwnd;
+	/** Slow start threshold, in bytes */
+	uint32_t ssthresh;
+	/** Sender MSS, set before the init callback is called */
+	uint16_t mss;
+	/** Algorithm specific state, see tcp_cc_priv() */
+	uint64_t priv[TCP_CC_PRIV_SIZE / sizeof(uint64_t)];
+};
+
+/** Information passed with an acknowledgment of new data */
+struct tcp_cc_ack {
+	/** Number of newly acknowledged bytes */
+	uint32_t acked;
+	/** Bytes in flight before this acknowledgment */
+	uint32_t in_flight;
+	/** RTT sample taken with this acknowledgment in ms, 0 if none */
+	uint32_t rtt_ms;
+};
+
+/** Congestion control module */
+struct tcp_cc_ops {
+	/** Name used to select the module */
+	const char *name;
+	/** Connection established, set the initial cwnd and ssthresh */
+	void (*init)(struct tcp_cc *cc);
+	/** New data has been acknowledged */
+	void (*pkts_acked)(struct tcp_cc *cc, const struct tcp_cc_ack *ack);
+	/** A duplicate acknowledgment has been received, optional */
+	void (*dup_ack)(struct tcp_cc *cc);
+	/** A segment is retransmitted before the RTO, @p in_flight bytes are
+	 * outstanding. Called for every retransmission, optional.
+	 */
+	void (*fast_retransmit)(struct tcp_cc *cc, uint32_t in_flight);
+	/** The retransmission timer expired with @p in_flight bytes outstanding */
+	void (*timeout)(struct tcp_cc *cc, uint32_t in_flight);
+};
+
+/**
+ * @brief Register a congestion control module
+ *
+ * @param _sym Symbol name of the module
+ * @param _name Name used to select the module, at most TCP_CC_NAME_MAX characters
+ * @param _init Init callback
+ * @param _pkts_acked Acknowledgment callback
+ * @param _dup_ack Duplicate acknowledgment callback, can be NULL
+ * @param _fast_retransmit Fast retransmit callback, can be NULL
+ * @param _timeout Retransmission timeout callback
+ */
+#define TCP_CC_DEFINE(_sym, _name, _init, _pkts_acked, _dup_ack,		\
+		      _fast_retransmit, _timeout)				\
+	BUILD_ASSERT(sizeof(_name) <= TCP_CC_NAME_MAX + 1,			\
+		     "TCP congestion control name too long");			\
+	static const STRUCT_SECTION_ITERABLE(tcp_cc_ops, _sym) = {		\
+		.name = _name,							\
+		.init = _init,							\
+		.pkts_acked = _pkts_acked,					\
+		.dup_ack = _dup_ack,						\
+		.fast_retransmit = _fast_retransmit,				\
+		.timeout = _timeout,						\
+	}
+
+/**
+ * @brief Access the algorithm specific state of a connection
+ *
+ * @param cc Congestion control state
+ * @param type Type of the algorithm state, at most TCP_CC_PRIV_SIZE bytes
+ */
+#define tcp_cc_priv(cc, type)							\
+	({									\
+		BUILD_ASSERT(sizeof(type) <= TCP_CC_PRIV_SIZE,			\
+			     #type " does not fit in the TCP CC state");	\
+		(type *)(cc)->priv;						\
+	})
+
+/**
+ * @brief Find a congestion control module by name
+ *
+ * @param name Module name, not necessarily NUL terminated
+ * @param len Length of the name
+ *
+ * @return Module, or NULL if there is none with that name
+ */
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len);
+
+/**
+ * @brief Get the module configured with CONFIG_NET_TCP_CC_DEFAULT
+ *
+ * @return Default module
+ */
+const struct tcp_cc_ops *tcp_cc_default(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TCP_CC_H */
@@ -0,0 +1,221 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Lightweight model-based congestion control after BBR (draft-ietf-ccwg-bbr).
+ *
+ * The bottleneck bandwidth is estimated once per round trip from the amount
+ * of data delivered during the round, the propagation delay from the minimum
+ * RTT sample. The congestion window follows the estimated bandwidth-delay
+ * product scaled by the gain of the current state. The stack does not pace
+ * its transmissions, so unlike full BBR the window is the only control.
+ * Losses do not reduce the window, only a retransmission timeout does.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "tcp_cc.h"
+
+/* Gains in percent */
+#define BBR_STARTUP_GAIN    289 /* 2 / ln(2) */
+#define BBR_UNIT_GAIN       100
+
+/* Number of rounds the bandwidth estimate is kept, split in two halves */
+#define BBR_BW_WIN_ROUNDS   10
+/* Rounds without 25% bandwidth growth before the pipe is deemed full */
+#define BBR_FULL_BW_ROUNDS  3
+
+#define BBR_MIN_RTT_WIN_MS  10000
+#define BBR_PROBE_RTT_MS    200
+#define BBR_MIN_CWND_SEGS   4
+
+enum bbr_state {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+struct bbr {
+	/* Maximum delivery rate in bytes/s of the current and previous half
+	 * of the window
+	 */
+	uint32_t bw[2];
+	uint32_t min_rtt;
+	uint32_t min_rtt_stamp;
+	uint32_t delivered;
+	/* Delivered count and time at the start of the round */
+	uint32_t round_delivered;
+	uint32_t round_start;
+	/* Bytes to deliver for the round to end */
+	uint32_t round_len;
+	uint32_t full_bw;
+	uint32_t probe_rtt_done;
+	uint32_t prior_cwnd;
+	uint8_t state;
+	uint8_t cycle_idx;
+	uint8_t full_bw_cnt;
+	uint8_t round_cnt;
+};
+
+static const uint8_t bbr_probe_bw_gain[] = { 125, 75, 100, 100, 100, 100, 100, 100 };
+
+static uint32_t bbr_max_bw(struct bbr *bbr)
+{
+	return MAX(bbr->bw[0], bbr->bw[1]);
+}
+
+static uint32_t bbr_bdp(struct tcp_cc *cc, struct bbr *bbr, uint32_t gain)
+{
+	uint64_t bdp = (uint64_t)bbr_max_bw(bbr) * bbr->min_rtt * gain /
+		       (MSEC_PER_SEC * BBR_UNIT_GAIN);
+
+	return (uint32_t)CLAMP(bdp, (uint64_t)cc->mss * BBR_MIN_CWND_SEGS,
+			       (uint64_t)TCP_CC_CWND_MAX);
+}
+
+static void bbr_init(struct tcp_cc *cc)
+{
+	struct bbr *bbr = tcp_cc_priv(cc, struct bbr);
+	uint32_t now = k_uptime_get_32();
+
+	*bbr = (struct bbr){
+		.state = BBR_STARTUP,
+		.round_start = now,
+		.round_len = cc->mss,
+		.min_rtt_stamp = now,
+	};
+
+	cc->cwnd = cc->mss * TCP_CC_INITIAL_WIN;
+	cc->ssthresh = TCP_CC_CWND_MAX;
+}
+
+/* Called at the end of every round trip */
+static void bbr_round(struct tcp_cc *cc, struct bbr *bbr, uint32_t now,
+		      uint32_t in_flight)
+{
+	uint32_t elapsed = MAX(now - bbr->round_start, 1U);
+	uint32_t bw = (uint64_t)(bbr->delivered - bbr->round_delivered) *
+		      MSEC_PER_SEC / elapsed;
+
+	if (bbr->round_cnt++ % (BBR_BW_WIN_ROUNDS / 2) == 0) {
+		bbr->bw[1] = bbr->bw[0];
+		bbr->bw[0] = 0;
+	}
+
+	bbr->bw[0] = MAX(bbr->bw[0], bw);
+
+	bbr->round_delivered = bbr->delivered;
+	bbr->round_start = now;
+	bbr->round_len = MAX(in_flight, cc->mss);
+
+	switch (bbr->state) {
+	case BBR_STARTUP:
+		if (bbr_max_bw(bbr) >= bbr->full_bw + bbr->full_bw / 4) {
+			bbr->full_bw = bbr_max_bw(bbr);
+			bbr->full_bw_cnt = 0;
+		} else if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+			bbr->state = BBR_DRAIN;
+		}
+		break;
+	case BBR_DRAIN:
+		if (in_flight <= bbr_bdp(cc, bbr, BBR_UNIT_GAIN)) {
+			bbr->state = BBR_PROBE_BW;
+			bbr->cycle_idx = 2;
+		}
+		break;
+	case BBR_PROBE_BW:
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(bbr_probe_bw_gain);
+		break;
+	default:
+		break;
+	}
+}
+
+static void bbr_update_min_rtt(struct tcp_cc *cc, struct bbr *bbr, uint32_t now,
+			       uint32_t rtt_ms)
+{
+	bool expired = (now - bbr->min_rtt_stamp) > BBR_MIN_RTT_WIN_MS;
+
+	if (rtt_ms != 0 && (bbr->min_rtt == 0 || rtt_ms <= bbr->min_rtt || expired)) {
+		bbr->min_rtt = rtt_ms;
+		bbr->min_rtt_stamp = now;
+	}
+
+	if (expired && bbr->state != BBR_PROBE_RTT) {
+		/* Drain the queue for a while to see the propagation delay */
+		bbr->prior_cwnd = cc->cwnd;
+		bbr->probe_rtt_done = now + BBR_PROBE_RTT_MS + bbr->min_rtt;
+		bbr->state = BBR_PROBE_RTT;
+	} else if (bbr->state == BBR_PROBE_RTT &&
+		   (int32_t)(now - bbr->probe_rtt_done) >= 0) {
+		bbr->min_rtt_stamp = now;
+		bbr->state = bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS ? BBR_PROBE_BW :
+								      BBR_STARTUP;
+		cc->cwnd = MAX(cc->cwnd, bbr->prior_cwnd);
+	}
+}
+
+static void bbr_pkts_acked(struct tcp_cc *cc, const struct tcp_cc_ack *ack)
+{
+	struct bbr *bbr = tcp_cc_priv(cc, struct bbr);
+	uint32_t in_flight = ack->in_flight - MIN(ack->acked, ack->in_flight);
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+
+	bbr->delivered += ack->acked;
+
+	bbr_update_min_rtt(cc, bbr, now, ack->rtt_ms);
+
+	if (bbr->delivered - bbr->round_delivered >= bbr->round_len) {
+		bbr_round(cc, bbr, now, in_flight);
+	}
+
+	switch (bbr->state) {
+	case BBR_STARTUP:
+		/* Double the window every round until the bandwidth stalls */
+		target = TCP_CC_CWND_MAX;
+		break;
+	case BBR_DRAIN:
+		target = bbr_bdp(cc, bbr, BBR_UNIT_GAIN);
+		break;
+	case BBR_PROBE_BW:
+		target = bbr_bdp(cc, bbr, bbr_probe_bw_gain[bbr->cycle_idx]);
+		break;
+	case BBR_PROBE_RTT:
+	default:
+		target = cc->mss * BBR_MIN_CWND_SEGS;
+		break;
+	}
+
+	if (bbr->min_rtt == 0 || bbr_max_bw(bbr) == 0) {
+		/* No model yet, keep growing */
+		target = MAX(target, cc->cwnd + ack->acked);
+	}
+
+	if (cc->cwnd < target) {
+		cc->cwnd = MIN(cc->cwnd + ack->acked, target);
+	} else {
+		cc->cwnd = target;
+	}
+
+	cc->cwnd = MIN(cc->cwnd, TCP_CC_CWND_MAX);
+}
+
+static void bbr_timeout(struct tcp_cc *cc, uint32_t in_flight)
+{
+	struct bbr *bbr = tcp_cc_priv(cc, struct bbr);
+
+	ARG_UNUSED(in_flight);
+
+	/* Restart from one segment, the window grows back to the model */
+	bbr->prior_cwnd = cc->cwnd;
+	bbr->round_delivered = bbr->delivered;
+	bbr->round_start = k_uptime_get_32();
+	bbr->round_len = cc->mss;
+	cc->cwnd = cc->mss;
+}
+
+TCP_CC_DEFINE(tcp_cc_bbr, "bbr", bbr_init, bbr_pkts_acked, NULL, NULL, bbr_timeout);
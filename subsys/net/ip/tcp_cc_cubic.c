@@ -0,0 +1,205 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control according to RFC9438, in integer arithmetic with
+ * times in milliseconds and windows in bytes.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "tcp_cc.h"
+
+/* Multiplicative decrease factor beta_cubic = 0.7 */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+
+/* alpha_cubic = 3 * (1 - beta_cubic) / (1 + beta_cubic) = 9 / 17 */
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+
+/* With C = 0.4 segments/s^3, C * t^3 with t in ms is t^3 * 2 / (5 * 10^9) */
+#define CUBIC_C_NUM 2ULL
+#define CUBIC_C_DEN 5000000000ULL
+
+/* Larger distances from K saturate the window anyway, the limit keeps
+ * C * t^3 * mss within 64 bits.
+ */
+#define CUBIC_MAX_T_MS 10000
+
+struct cubic {
+	/* Window before the last reduction */
+	uint32_t w_max;
+	/* Reno-friendly window estimate */
+	uint32_t w_est;
+	/* Time to grow back to w_max from the start of the epoch */
+	uint32_t k_ms;
+	/* Start of the congestion avoidance epoch, 0 if not started */
+	uint32_t epoch_start;
+	uint32_t min_rtt;
+	/* Bytes outstanding when fast recovery was entered, 0 otherwise */
+	uint32_t pending_fast_retransmit_bytes;
+};
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+/* W_cubic(t) of RFC9438 section 4.2 */
+static uint32_t cubic_window(struct tcp_cc *cc, struct cubic *cu, uint32_t t_ms)
+{
+	int64_t d = (int64_t)t_ms - cu->k_ms;
+	uint64_t offs;
+
+	d = CLAMP(d, -CUBIC_MAX_T_MS, CUBIC_MAX_T_MS);
+	offs = (uint64_t)(d < 0 ? -d : d);
+	offs = offs * offs * offs * cc->mss * CUBIC_C_NUM / CUBIC_C_DEN;
+
+	if (d < 0) {
+		return offs >= cu->w_max ? 0 : cu->w_max - (uint32_t)offs;
+	}
+
+	return (uint32_t)MIN(cu->w_max + offs, (uint64_t)UINT32_MAX);
+}
+
+static void cubic_reduce(struct tcp_cc *cc, struct cubic *cu, uint32_t in_flight)
+{
+	/* Fast convergence, release bandwidth to flows that just started */
+	if (cc->cwnd < cu->w_max) {
+		cu->w_max = cc->cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			    (2 * CUBIC_BETA_DEN);
+	} else {
+		cu->w_max = cc->cwnd;
+	}
+
+	cc->ssthresh = MAX(cc->mss * 2, in_flight * CUBIC_BETA_NUM / CUBIC_BETA_DEN);
+	cu->epoch_start = 0;
+}
+
+static void cubic_init(struct tcp_cc *cc)
+{
+	struct cubic *cu = tcp_cc_priv(cc, struct cubic);
+
+	*cu = (struct cubic){ 0 };
+	cc->cwnd = cc->mss * TCP_CC_INITIAL_WIN;
+	/* Slow start until the first congestion event, CUBIC has no use for
+	 * the small initial threshold of NewReno on high-BDP paths.
+	 */
+	cc->ssthresh = TCP_CC_CWND_MAX;
+}
+
+static void cubic_fast_retransmit(struct tcp_cc *cc, uint32_t in_flight)
+{
+	struct cubic *cu = tcp_cc_priv(cc, struct cubic);
+
+	if (cu->pending_fast_retransmit_bytes == 0) {
+		cubic_reduce(cc, cu, in_flight);
+		cc->cwnd = MIN(cc->mss * 3 + cc->ssthresh, TCP_CC_CWND_MAX);
+		cu->pending_fast_retransmit_bytes = in_flight;
+	}
+}
+
+static void cubic_timeout(struct tcp_cc *cc, uint32_t in_flight)
+{
+	struct cubic *cu = tcp_cc_priv(cc, struct cubic);
+
+	cubic_reduce(cc, cu, in_flight);
+	cc->cwnd = cc->mss;
+	cu->pending_fast_retransmit_bytes = 0;
+}
+
+static void cubic_dup_ack(struct tcp_cc *cc)
+{
+	struct cubic *cu = tcp_cc_priv(cc, struct cubic);
+
+	if (cu->pending_fast_retransmit_bytes != 0) {
+		cc->cwnd = MIN(cc->cwnd + cc->mss, TCP_CC_CWND_MAX);
+	}
+}
+
+static void cubic_congestion_avoidance(struct tcp_cc *cc, struct cubic *cu,
+				       uint32_t acked)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+	uint32_t inc;
+
+	if (cu->epoch_start == 0) {
+		cu->epoch_start = now;
+		cu->w_est = cc->cwnd;
+
+		if (cc->cwnd < cu->w_max) {
+			uint64_t k3 = (uint64_t)(cu->w_max - cc->cwnd) * CUBIC_C_DEN /
+				      (CUBIC_C_NUM * cc->mss);
+
+			cu->k_ms = cubic_cbrt(k3);
+		} else {
+			cu->k_ms = 0;
+			cu->w_max = cc->cwnd;
+		}
+	}
+
+	/* Aim at the window one RTT ahead, limited to 1.5 * cwnd */
+	target = cubic_window(cc, cu, now - cu->epoch_start + cu->min_rtt);
+	target = CLAMP(target, cc->cwnd, cc->cwnd + cc->cwnd / 2);
+
+	cu->w_est += MAX(1U, (uint32_t)((uint64_t)acked * cc->mss * CUBIC_ALPHA_NUM /
+					 ((uint64_t)cc->cwnd * CUBIC_ALPHA_DEN)));
+
+	if (cu->w_est > target) {
+		/* Reno-friendly region */
+		cc->cwnd = cu->w_est;
+	} else {
+		inc = (uint64_t)(target - cc->cwnd) * acked / cc->cwnd;
+		cc->cwnd += MAX(inc, 1U);
+	}
+}
+
+static void cubic_pkts_acked(struct tcp_cc *cc, const struct tcp_cc_ack *ack)
+{
+	struct cubic *cu = tcp_cc_priv(cc, struct cubic);
+
+	if (ack->rtt_ms != 0 && (cu->min_rtt == 0 || ack->rtt_ms < cu->min_rtt)) {
+		cu->min_rtt = ack->rtt_ms;
+	}
+
+	if (cu->pending_fast_retransmit_bytes != 0) {
+		if (cu->pending_fast_retransmit_bytes <= ack->acked) {
+			cu->pending_fast_retransmit_bytes = 0;
+			cc->cwnd = cc->ssthresh;
+		} else {
+			cu->pending_fast_retransmit_bytes -= ack->acked;
+			cc->cwnd -= MIN(ack->acked, cc->cwnd - cc->mss);
+		}
+
+		return;
+	}
+
+	if (cc->cwnd < cc->ssthresh) {
+		cc->cwnd += MIN(ack->acked, cc->mss);
+	} else {
+		cubic_congestion_avoidance(cc, cu, ack->acked);
+	}
+
+	cc->cwnd = MIN(cc->cwnd, TCP_CC_CWND_MAX);
+	cu->w_est = MIN(cu->w_est, TCP_CC_CWND_MAX);
+}
+
+TCP_CC_DEFINE(tcp_cc_cubic, "cubic", cubic_init, cubic_pkts_acked, cubic_dup_ack,
+	      cubic_fast_retransmit, cubic_timeout);
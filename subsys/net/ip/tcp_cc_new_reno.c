@@ -0,0 +1,81 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* NewReno congestion control according to RFC6582 */
+
+#include <zephyr/kernel.h>
+
+#include "tcp_cc.h"
+
+struct new_reno {
+	/* Bytes outstanding when fast recovery was entered, 0 otherwise */
+	uint32_t pending_fast_retransmit_bytes;
+};
+
+static void new_reno_init(struct tcp_cc *cc)
+{
+	struct new_reno *nr = tcp_cc_priv(cc, struct new_reno);
+
+	cc->cwnd = cc->mss * TCP_CC_INITIAL_WIN;
+	cc->ssthresh = cc->mss * TCP_CC_INITIAL_SSTHRESH;
+	nr->pending_fast_retransmit_bytes = 0;
+}
+
+static void new_reno_fast_retransmit(struct tcp_cc *cc, uint32_t in_flight)
+{
+	struct new_reno *nr = tcp_cc_priv(cc, struct new_reno);
+
+	if (nr->pending_fast_retransmit_bytes == 0) {
+		cc->ssthresh = MAX(cc->mss * 2, in_flight / 2);
+		/* Account for the lost segments */
+		cc->cwnd = MIN(cc->mss * 3 + cc->ssthresh, TCP_CC_CWND_MAX);
+		nr->pending_fast_retransmit_bytes = in_flight;
+	}
+}
+
+static void new_reno_timeout(struct tcp_cc *cc, uint32_t in_flight)
+{
+	struct new_reno *nr = tcp_cc_priv(cc, struct new_reno);
+
+	cc->ssthresh = MAX(cc->mss * 2, in_flight / 2);
+	cc->cwnd = cc->mss;
+	nr->pending_fast_retransmit_bytes = 0;
+}
+
+/* For every duplicate ack increment the cwnd by mss */
+static void new_reno_dup_ack(struct tcp_cc *cc)
+{
+	cc->cwnd = MIN(cc->cwnd + cc->mss, TCP_CC_CWND_MAX);
+}
+
+static void new_reno_pkts_acked(struct tcp_cc *cc, const struct tcp_cc_ack *ack)
+{
+	struct new_reno *nr = tcp_cc_priv(cc, struct new_reno);
+	uint32_t win_inc = MIN(ack->acked, cc->mss);
+	uint32_t new_win = cc->cwnd;
+
+	if (nr->pending_fast_retransmit_bytes == 0) {
+		if (cc->cwnd < cc->ssthresh) {
+			new_win += win_inc;
+		} else {
+			/* Implement a div_ceil to avoid rounding to 0 */
+			new_win += ((win_inc * win_inc) + cc->cwnd - 1) / cc->cwnd;
+		}
+		cc->cwnd = MIN(new_win, TCP_CC_CWND_MAX);
+	} else {
+		/* Check if it is still in fast recovery mode */
+		if (nr->pending_fast_retransmit_bytes <= ack->acked) {
+			nr->pending_fast_retransmit_bytes = 0;
+			cc->cwnd = cc->ssthresh;
+		} else {
+			nr->pending_fast_retransmit_bytes -= ack->acked;
+			cc->cwnd -= MIN(ack->acked, cc->cwnd - cc->mss);
+		}
+	}
+}
+
+TCP_CC_DEFINE(tcp_cc_new_reno, "newreno", new_reno_init, new_reno_pkts_acked,
+	      new_reno_dup_ack, new_reno_fast_retransmit, new_reno_timeout);
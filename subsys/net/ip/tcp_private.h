@@ -6,6 +6,7 @@
  */
 
 #include "tp.h"
+#include "tcp_cc.h"
 #include <zephyr/toolchain/gcc.h>
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
@@ -132,10 +133,18 @@
 
 #define NET_TCP_DEFAULT_MSS 536
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Once negotiated, the timestamps option is sent in every segment */
+#define conn_opts_len(_conn)						\
+	((_conn)->ts_ok ? NET_TCP_TIMESTAMP_OPTS_SIZE : 0)
+#else
+#define conn_opts_len(_conn) 0
+#endif
+
 #define conn_mss(_conn)							\
-	MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss	\
-					    : NET_TCP_DEFAULT_MSS,	\
-	    net_tcp_get_supported_mss(_conn))
+	(MIN((_conn)->recv_options.mss_found ? (_conn)->recv_options.mss \
+					     : NET_TCP_DEFAULT_MSS,	\
+	     net_tcp_get_supported_mss(_conn)) - conn_opts_len(_conn))
 
 #define conn_state(_conn, _s)						\
 ({									\
@@ -229,32 +238,89 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* The timestamps option is padded with two NOPs to keep 32-bit alignment */
+#define NET_TCP_TIMESTAMP_OPTS_SIZE (2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE)
+
+/* Maximum number of SACK blocks that fit in the options space */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool ts_found : 1;
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	uint8_t sack_blocks;
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+#endif
 };
 
-#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+#if defined(CONFIG_NET_TCP_SACK)
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+enum tcp_sack_seg_flags {
+	TCP_SACK_SEG_SACKED  = BIT(0), /* Reported received by the peer */
+	TCP_SACK_SEG_LOST    = BIT(1), /* Marked lost, to be retransmitted */
+	TCP_SACK_SEG_RETRANS = BIT(2), /* Has been retransmitted */
+};
+
+/* One transmitted segment, as seen by the RACK-TLP sender (RFC 8985) */
+struct tcp_sack_seg {
+	uint32_t seq;
+	uint32_t xmit_time; /* k_uptime_get_32() of the latest transmission */
+	uint16_t len;
+	uint8_t flags;
 };
-#endif
+
+struct tcp_sack_scoreboard {
+	struct tcp_sack_seg segs[CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE];
+	/* Most recently sent segment known to be delivered */
+	uint32_t rack_xmit_time;
+	uint32_t rack_end_seq;
+	uint32_t rack_rtt;
+	uint32_t min_rtt;
+	uint32_t srtt;
+	/* Fast recovery ends when this sequence number is acknowledged */
+	uint32_t recovery_point;
+	uint8_t count;
+	bool in_recovery : 1;
+	bool tlp_armed : 1;
+	bool tlp_sent : 1;
+};
+#endif /* CONFIG_NET_TCP_SACK */
 
 struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
+/* One chain of the connection lookup hash table */
+struct tcp_conn_bucket {
+	sys_slist_t conns;
+	struct k_spinlock lock;
+};
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -295,6 +361,10 @@ struct tcp { /* TCP connection */
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
+#if defined(CONFIG_NET_TCP_SACK)
+	/* RACK reordering timeout and tail loss probe timeout */
+	struct k_work_delayable recovery_timer;
+#endif /* CONFIG_NET_TCP_SACK */
 	struct k_work conn_release;
 
 	union {
@@ -307,6 +377,9 @@ struct tcp { /* TCP connection */
 	};
 	union tcp_endpoint src;
 	union tcp_endpoint dst;
+	/* Lookup hash chain linkage, bucket is NULL until src/dst are set */
+	sys_snode_t hash_node;
+	struct tcp_conn_bucket *bucket;
 #if defined(CONFIG_NET_TCP_IPV6_ND_REACHABILITY_HINT)
 	int64_t last_nd_hint_time;
 #endif
@@ -331,11 +404,33 @@ struct tcp { /* TCP connection */
 	uint16_t recv_win;
 	uint16_t send_win_max;
 	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint8_t rto_gain;
+#endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_cc ca;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Segment timed for the RTT sample when no timestamp is echoed */
+	uint32_t rtt_seq;
+	uint32_t rtt_start;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Smoothed RTT scaled by 8 and RTT variation scaled by 4, in ms */
+	uint32_t srtt;
+	uint32_t rttvar;
+	/* Added to the uptime to get the TSval of sent segments */
+	uint32_t ts_offset;
+	/* Latest TSval of the peer to be echoed, RFC 7323 ch 4.3 */
+	uint32_t ts_recent;
+	/* Acknowledgment number of the latest segment sent */
+	uint32_t last_ack_sent;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_scoreboard sack;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -350,6 +445,15 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool rtt_pending : 1;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	bool ts_ok : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
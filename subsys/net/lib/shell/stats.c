@@ -605,6 +605,12 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
 	PR("TCP pkt drop   %u\n", GET_STAT(iface, tcp.drop));
+	PR("TCP rto exp    %u\tpaws\t%u\n",
+	   GET_STAT(iface, tcp.rto_expired),
+	   GET_STAT(iface, tcp.paws_drop));
+	PR("TCP srtt ms    %u\trto ms\t%u\n",
+	   GET_STAT(iface, tcp.srtt),
+	   GET_STAT(iface, tcp.rto));
 #endif
 #if defined(CONFIG_NET_STATISTICS_DNS)
 	PR("DNS recv       %u\tsent\t%u\tdrop\t%u\n",
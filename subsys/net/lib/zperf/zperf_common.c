@@ -168,7 +168,8 @@ int zperf_get_ipv4_addr(char *host, struct net_in_addr *addr)
 }
 
 int zperf_prepare_upload_sock(const struct net_sockaddr *peer_addr, uint8_t tos,
-			      int priority, int tcp_nodelay, int proto)
+			      int priority, int tcp_nodelay, const char *tcp_congestion,
+			      int proto)
 {
 	net_socklen_t addrlen = peer_addr->sa_family == NET_AF_INET6 ?
 			    sizeof(struct net_sockaddr_in6) :
@@ -258,6 +259,14 @@ int zperf_prepare_upload_sock(const struct net_sockaddr *peer_addr, uint8_t tos,
 		goto error;
 	}
 
+	if (proto == NET_IPPROTO_TCP && tcp_congestion != NULL && tcp_congestion[0] != '\0' &&
+	    zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			     tcp_congestion, strlen(tcp_congestion)) != 0) {
+		NET_WARN("Failed to set NET_IPPROTO_TCP - TCP_CONGESTION socket option.");
+		ret = -errno;
+		goto error;
+	}
+
 	ret = zsock_connect(sock, peer_addr, addrlen);
 	if (ret < 0) {
 		NET_ERR("Connect failed (%d)", errno);
@@ -1018,6 +1018,27 @@ static int shell_cmd_upload(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		case 'C':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -C option\n");
+				return -ENOEXEC;
+			}
+			i++;
+			if (i >= argc) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-C <congestion control>\n");
+				return -ENOEXEC;
+			}
+			(void)memset(param.options.tcp_congestion, 0x0,
+				     sizeof(param.options.tcp_congestion));
+			strncpy(param.options.tcp_congestion, argv[i],
+				sizeof(param.options.tcp_congestion) - 1);
+			opt_cnt += 2;
+			break;
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1271,6 +1292,27 @@ static int shell_cmd_upload2(const struct shell *sh, size_t argc,
 			opt_cnt += 1;
 			break;
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		case 'C':
+			if (is_udp) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "UDP does not support -C option\n");
+				return -ENOEXEC;
+			}
+			i++;
+			if (i >= argc) {
+				shell_fprintf(sh, SHELL_WARNING,
+					      "-C <congestion control>\n");
+				return -ENOEXEC;
+			}
+			(void)memset(param.options.tcp_congestion, 0x0,
+				     sizeof(param.options.tcp_congestion));
+			strncpy(param.options.tcp_congestion, argv[i],
+				sizeof(param.options.tcp_congestion) - 1);
+			opt_cnt += 2;
+			break;
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		case 't':
 			param.options.thread_priority = parse_arg(&i, argc, argv);
@@ -1922,6 +1964,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		  "-C name: Congestion control algorithm (newreno, cubic, bbr)\n"
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
@@ -1946,6 +1991,9 @@ SHELL_STATIC_SUBCMD_SET_CREATE(zperf_cmd_tcp,
 		  "-a: Asynchronous call (shell will not block for the upload)\n"
 		  "-i sec: Periodic reporting interval in seconds (async only)\n"
 		  "-n: Disable Nagle's algorithm\n"
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		  "-C name: Congestion control algorithm (newreno, cubic, bbr)\n"
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
 #ifdef CONFIG_ZPERF_SESSION_PER_THREAD
 		  "-t: Specify custom thread priority\n"
 		  "-w: Wait for start signal before starting the tests\n"
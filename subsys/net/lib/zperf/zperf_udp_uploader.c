@@ -425,7 +425,7 @@ int zperf_udp_upload(const struct zperf_upload_params *param,
 	}
 
 	sock = zperf_prepare_upload_sock(&param->peer_addr, param->options.tos,
-					 param->options.priority, 0,
+					 param->options.priority, 0, NULL,
 					 NET_IPPROTO_UDP);
 	if (sock < 0) {
 		return sock;
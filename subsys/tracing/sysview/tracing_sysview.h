@@ -296,6 +296,9 @@ void sys_trace_thread_info(struct k_thread *thread);
 
 #define sys_port_trace_k_sem_give_exit(sem) SEGGER_SYSVIEW_RecordEndCall(TID_SEMA_GIVE)
 
+#define sys_port_trace_k_sem_give_many_enter(sem, count)
+#define sys_port_trace_k_sem_give_many_exit(sem, count)
+
 #define sys_port_trace_k_sem_take_enter(sem, timeout)                                              \
 	SEGGER_SYSVIEW_RecordU32x2(TID_SEMA_TAKE, (uint32_t)(uintptr_t)sem, (uint32_t)timeout.ticks)
 
@@ -570,6 +573,20 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_msgq_purge(msgq)                                                          \
 	SEGGER_SYSVIEW_RecordU32(TID_MSGQ_PURGE, (uint32_t)(uintptr_t)msgq)
 
+#define sys_port_trace_k_vmsgq_init(vmsgq)
+#define sys_port_trace_k_vmsgq_alloc_enter(vmsgq, len, timeout)
+#define sys_port_trace_k_vmsgq_alloc_blocking(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_alloc_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_commit(vmsgq, msg)
+#define sys_port_trace_k_vmsgq_claim_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_claim_blocking(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_claim_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_free(vmsgq, msg)
+#define sys_port_trace_k_vmsgq_put_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_put_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_get_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_get_exit(vmsgq, timeout, ret)
+
 #define sys_port_trace_k_mbox_init(mbox)                                                           \
 	SEGGER_SYSVIEW_RecordU32(TID_MBOX_INIT, (uint32_t)(uintptr_t)mbox)
 
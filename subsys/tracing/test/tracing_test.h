@@ -126,6 +126,8 @@
 #define sys_port_trace_k_sem_init(sem, ret) sys_trace_k_sem_init(sem, ret)
 #define sys_port_trace_k_sem_give_enter(sem) sys_trace_k_sem_give_enter(sem)
 #define sys_port_trace_k_sem_give_exit(sem)
+#define sys_port_trace_k_sem_give_many_enter(sem, count)
+#define sys_port_trace_k_sem_give_many_exit(sem, count)
 #define sys_port_trace_k_sem_take_enter(sem, timeout) sys_trace_k_sem_take_enter(sem, timeout)
 #define sys_port_trace_k_sem_take_blocking(sem, timeout) sys_trace_k_sem_take_blocking(sem, timeout)
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)                                          \
@@ -329,6 +331,20 @@
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, data, ret)
 #define sys_port_trace_k_msgq_purge(msgq) sys_trace_k_msgq_purge(msgq)
 
+#define sys_port_trace_k_vmsgq_init(vmsgq)
+#define sys_port_trace_k_vmsgq_alloc_enter(vmsgq, len, timeout)
+#define sys_port_trace_k_vmsgq_alloc_blocking(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_alloc_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_commit(vmsgq, msg)
+#define sys_port_trace_k_vmsgq_claim_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_claim_blocking(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_claim_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_free(vmsgq, msg)
+#define sys_port_trace_k_vmsgq_put_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_put_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_get_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_get_exit(vmsgq, timeout, ret)
+
 #define sys_port_trace_k_mbox_init(mbox) sys_trace_k_mbox_init(mbox)
 #define sys_port_trace_k_mbox_message_put_enter(mbox, timeout)                                     \
 	sys_trace_k_mbox_message_put_enter(mbox, tx_msg, timeout)
@@ -237,6 +237,8 @@ void sys_trace_rtio_chain_next_exit(const struct rtio *r, const struct rtio_iode
 #define sys_port_trace_k_sem_init(sem, ret)
 #define sys_port_trace_k_sem_give_enter(sem)
 #define sys_port_trace_k_sem_give_exit(sem)
+#define sys_port_trace_k_sem_give_many_enter(sem, count)
+#define sys_port_trace_k_sem_give_many_exit(sem, count)
 #define sys_port_trace_k_sem_take_enter(sem, timeout)
 #define sys_port_trace_k_sem_take_blocking(sem, timeout)
 #define sys_port_trace_k_sem_take_exit(sem, timeout, ret)
@@ -344,6 +346,20 @@ void sys_trace_rtio_chain_next_exit(const struct rtio *r, const struct rtio_iode
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
+#define sys_port_trace_k_vmsgq_init(vmsgq)
+#define sys_port_trace_k_vmsgq_alloc_enter(vmsgq, len, timeout)
+#define sys_port_trace_k_vmsgq_alloc_blocking(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_alloc_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_commit(vmsgq, msg)
+#define sys_port_trace_k_vmsgq_claim_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_claim_blocking(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_claim_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_free(vmsgq, msg)
+#define sys_port_trace_k_vmsgq_put_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_put_exit(vmsgq, timeout, ret)
+#define sys_port_trace_k_vmsgq_get_enter(vmsgq, timeout)
+#define sys_port_trace_k_vmsgq_get_exit(vmsgq, timeout, ret)
+
 #define sys_port_trace_k_mbox_init(mbox)
 #define sys_port_trace_k_mbox_message_put_enter(mbox, timeout)
 #define sys_port_trace_k_mbox_message_put_blocking(mbox, timeout)
@@ -0,0 +1,199 @@
+/* fifo_b.c */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#ifdef CONFIG_IRQ_OFFLOAD
+#include <zephyr/irq_offload.h>
+#endif
+
+#define PRODUCER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Above the receiver task, so the items pile up until all are put */
+#define PRODUCER_PRIO 4
+
+BUILD_ASSERT(NR_OF_FIFO_RUNS % NR_OF_FIFO_PRODUCERS == 0);
+
+static struct fifo_item fifo_items[NR_OF_FIFO_RUNS];
+
+static struct k_thread producer_threads[NR_OF_FIFO_PRODUCERS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, NR_OF_FIFO_PRODUCERS,
+				   PRODUCER_STACK_SIZE);
+
+K_FIFO_DEFINE(DEMO_FIFO);
+
+#ifdef CONFIG_FIFO_MPSC
+/* Only one thread may get from a k_fifo_mpsc, so the receiver task has its own */
+K_FIFO_MPSC_DEFINE(DEMO_FIFO_MPSC);
+K_FIFO_MPSC_DEFINE(DEMO_FIFO_MPSC_RCV);
+#endif
+
+static void fifo_put(bool mpsc, void *item)
+{
+#ifdef CONFIG_FIFO_MPSC
+	if (mpsc) {
+		k_fifo_mpsc_put(&DEMO_FIFO_MPSC_RCV, item);
+		return;
+	}
+#endif
+	k_fifo_put(&DEMO_FIFO, item);
+}
+
+#ifdef CONFIG_IRQ_OFFLOAD
+static bool isr_mpsc;
+
+static void fifo_isr_put(const void *item)
+{
+	fifo_put(isr_mpsc, (void *)item);
+}
+#endif
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	bool mpsc = (bool)(uintptr_t)p1;
+	struct fifo_item *items = p2;
+	int i;
+
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < NR_OF_FIFO_RUNS / NR_OF_FIFO_PRODUCERS; i++) {
+		fifo_put(mpsc, &items[i]);
+		/* Interleave with the other producers */
+		k_yield();
+	}
+}
+
+/**
+ * @brief FIFO transfer to a waiting task
+ *
+ * The receiver task is blocked in the get of the FIFO: every item put by
+ * this task or by an ISR wakes it up. With several producers, the items
+ * pile up while the producers take turns and the receiver drains them.
+ */
+static void fifo_wait_test(bool mpsc, const char *fifo)
+{
+	char name[80];
+	uint64_t et; /* elapsed time */
+	int i;
+	timing_t  start;
+	timing_t  end;
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		fifo_put(mpsc, &fifo_items[i]);
+	}
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	snprintk(name, sizeof(name), "put item in %s to waiting high pri task", fifo);
+	PRINT_F(FORMAT, name, timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+
+#ifdef CONFIG_IRQ_OFFLOAD
+	isr_mpsc = mpsc;
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		irq_offload(fifo_isr_put, &fifo_items[i]);
+	}
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	snprintk(name, sizeof(name), "put item in %s from ISR to waiting task", fifo);
+	PRINT_F(FORMAT, name, timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+#endif
+
+	for (i = 0; i < NR_OF_FIFO_PRODUCERS; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				K_THREAD_STACK_SIZEOF(producer_stacks[i]), producer,
+				(void *)(uintptr_t)mpsc,
+				&fifo_items[i * NR_OF_FIFO_RUNS / NR_OF_FIFO_PRODUCERS],
+				NULL, PRODUCER_PRIO, 0, K_FOREVER);
+	}
+
+	/* This task only runs again when the receiver has got all items */
+	start = timing_timestamp_get();
+	k_sched_lock();
+	for (i = 0; i < NR_OF_FIFO_PRODUCERS; i++) {
+		k_thread_start(&producer_threads[i]);
+	}
+	k_sched_unlock();
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	for (i = 0; i < NR_OF_FIFO_PRODUCERS; i++) {
+		k_thread_join(&producer_threads[i], K_FOREVER);
+	}
+
+	snprintk(name, sizeof(name), "put item in %s from %d tasks, then get",
+		 fifo, NR_OF_FIFO_PRODUCERS);
+	PRINT_F(FORMAT, name, timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+}
+
+/**
+ * @brief FIFO throughput test
+ *
+ * Compares the regular k_fifo against the lock-free multi-producer,
+ * single-consumer k_fifo_mpsc when it is enabled.
+ */
+void fifo_test(void)
+{
+	uint64_t et; /* elapsed time */
+	int i;
+	timing_t  start;
+	timing_t  end;
+
+	PRINT_STRING(dashline);
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&DEMO_FIFO, &fifo_items[i]);
+	}
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "put item in FIFO",
+		timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_get(&DEMO_FIFO, K_NO_WAIT);
+	}
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "get item from FIFO",
+		timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+
+#ifdef CONFIG_FIFO_MPSC
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_mpsc_put(&DEMO_FIFO_MPSC, &fifo_items[i]);
+	}
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "put item in lock-free MPSC FIFO",
+		timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_mpsc_get(&DEMO_FIFO_MPSC, K_NO_WAIT);
+	}
+	end = timing_timestamp_get();
+	et = timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "get item from lock-free MPSC FIFO",
+		timing_cycles_to_ns_avg(et, NR_OF_FIFO_RUNS));
+#endif /* CONFIG_FIFO_MPSC */
+
+	k_sem_give(&STARTRCV);
+
+	fifo_wait_test(false, "FIFO");
+#ifdef CONFIG_FIFO_MPSC
+	fifo_wait_test(true, "lock-free MPSC FIFO");
+#endif
+}
@@ -0,0 +1,45 @@
+/* fifo_r.c */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "receiver.h"
+#include "master.h"
+
+static void fifo_get(bool mpsc)
+{
+#ifdef CONFIG_FIFO_MPSC
+	if (mpsc) {
+		k_fifo_mpsc_get(&DEMO_FIFO_MPSC_RCV, K_FOREVER);
+		return;
+	}
+#endif
+	k_fifo_get(&DEMO_FIFO, K_FOREVER);
+}
+
+/* Items put by the master task, an ISR and the producer tasks */
+static void fifo_wait(bool mpsc)
+{
+	int rounds = IS_ENABLED(CONFIG_IRQ_OFFLOAD) ? 3 : 2;
+	int i;
+
+	for (i = 0; i < rounds * NR_OF_FIFO_RUNS; i++) {
+		fifo_get(mpsc);
+	}
+}
+
+/* FIFO transfer to a waiting task */
+
+/**
+ * @brief Receive task
+ */
+void fiforecvtask(void)
+{
+	fifo_wait(false);
+#ifdef CONFIG_FIFO_MPSC
+	fifo_wait(true);
+#endif
+}
@@ -127,6 +127,7 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	if (!skip_mem_and_mbox) {
 		memorymap_test();
 		mailbox_test();
+		fifo_test();
 	}
 
 	pipe_test();
@@ -37,6 +37,8 @@
 #define NR_OF_MAP_RUNS 1000
 #define NR_OF_MBOX_RUNS 128
 #define NR_OF_PIPE_RUNS 256
+#define NR_OF_FIFO_RUNS 500
+#define NR_OF_FIFO_PRODUCERS 4
 #define SEMA_WAIT_TIME (5000)
 
 #ifdef CONFIG_USERSPACE
@@ -81,6 +83,7 @@ extern void message_queue_test(void);
 extern void mutex_test(void);
 extern void memorymap_test(void);
 extern void pipe_test(void);
+extern void fifo_test(void);
 
 /* kernel objects needed for benchmarking */
 extern struct k_mutex DEMO_MUTEX;
@@ -107,6 +110,17 @@ extern struct k_pipe PIPE_BIGBUFF;
 
 extern struct k_mem_slab MAP1;
 
+/* The first word of every item is reserved for the kernel */
+struct fifo_item {
+	void *reserved;
+	uint32_t data;
+};
+
+extern struct k_fifo DEMO_FIFO;
+#ifdef CONFIG_FIFO_MPSC
+extern struct k_fifo_mpsc DEMO_FIFO_MPSC_RCV;
+#endif
+
 /* PRINT_STRING
  * Macro to print an ASCII NULL terminated string.
  */
@@ -22,6 +22,7 @@ BENCH_DMEM char data_recv[MESSAGE_SIZE] = { 0 };
 void dequtask(void);
 void waittask(void);
 void mailrecvtask(void);
+void fiforecvtask(void);
 void piperecvtask(void);
 
 /**
@@ -45,6 +46,9 @@ void recvtask(void *p1, void *p2, void *p3)
 	if (!skip_mbox) {
 		k_sem_take(&STARTRCV, K_FOREVER);
 		mailrecvtask();
+
+		k_sem_take(&STARTRCV, K_FOREVER);
+		fiforecvtask();
 	}
 
 	k_sem_take(&STARTRCV, K_FOREVER);
@@ -0,0 +1,133 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the time and number of page faults needed to reach main(), to
+ * read a table larger than physical memory sequentially, and to keep a
+ * working set resident while streaming through the rest of that table.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define TABLE_PAGES  CONFIG_BENCHMARK_TABLE_PAGES
+#define HOT_PAGES    8
+
+BUILD_ASSERT(TABLE_PAGES > HOT_PAGES);
+
+/* Read-only data, so paged in from the backing store when accessed */
+static const uint8_t __aligned(CONFIG_MMU_PAGE_SIZE)
+	table[TABLE_PAGES][CONFIG_MMU_PAGE_SIZE] = { { 1 } };
+
+static volatile uint8_t sink;
+
+static void report(const char *tag, const char *str, uint64_t cycles, uint64_t ns,
+		   const struct k_mem_paging_stats_t *before)
+{
+	struct k_mem_paging_stats_t after;
+	unsigned long faults;
+	unsigned long prefetched;
+
+	k_mem_paging_stats_get(&after);
+	faults = after.pagefaults.cnt - before->pagefaults.cnt;
+	prefetched = after.prefetch.pages - before->prefetch.pages;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s, %lu faults, %lu read ahead : %7llu cycles , %7u ns :\n", tag,
+	       str, faults, prefetched, cycles, (uint32_t)ns);
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s : %7llu cycles (%7u nsec), %lu faults, %lu read ahead\n", str,
+	       cycles, (uint32_t)ns, faults, prefetched);
+#endif
+}
+
+static void table_page_out(void)
+{
+	int ret = k_mem_page_out((void *)table, sizeof(table));
+
+	if (ret != 0) {
+		printk("k_mem_page_out() failed: %d\n", ret);
+	}
+}
+
+static uint64_t run_sequential(void)
+{
+	timing_t start;
+	timing_t finish;
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < TABLE_PAGES; i++) {
+		sink = table[i][0];
+	}
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+static uint64_t run_working_set(void)
+{
+	timing_t start;
+	timing_t finish;
+
+	start = timing_counter_get();
+	for (unsigned int i = HOT_PAGES; i < TABLE_PAGES; i++) {
+		for (unsigned int j = 0; j < HOT_PAGES; j++) {
+			sink = table[j][0];
+		}
+		sink = table[i][0];
+	}
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+static void measure(const char *tag, const char *str, uint64_t (*run)(void))
+{
+	struct k_mem_paging_stats_t before;
+	uint64_t cycles = 0;
+	uint64_t average;
+
+	k_mem_paging_stats_get(&before);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		table_page_out();
+		cycles += run();
+	}
+
+	average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	report(tag, str, average, timing_cycles_to_ns(average), &before);
+}
+
+int main(void)
+{
+	uint32_t boot_cycles = k_cycle_get_32();
+	struct k_mem_paging_stats_t boot = { 0 };
+
+	report("paging.boot", "Reach main()", boot_cycles,
+	       k_cyc_to_ns_floor64(boot_cycles), &boot);
+
+	timing_init();
+
+	printk("Time Measurements for a %u page table\n", TABLE_PAGES);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	measure("paging.sequential", "Read each page of the table", run_sequential);
+	measure("paging.working_set", "Read a working set while streaming",
+		run_working_set);
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -12,7 +12,11 @@
 
 #define IPI_TEST_INTERVAL_DURATION 30
 
+#if CONFIG_IPI_METRIC_NUM_WORK_THREADS > 0
+#define NUM_WORK_THREADS CONFIG_IPI_METRIC_NUM_WORK_THREADS
+#else
 #define NUM_WORK_THREADS (CONFIG_MP_MAX_NUM_CPUS - 1)
+#endif
 #define WORK_STACK_SIZE  4096
 
 #define NUM_PREEMPTIVE_THREADS 5
@@ -130,7 +134,9 @@ void report(void)
 
 		printf("  IPI Count: %u\n", tmp_ipi_counter);
 
-		printf("  Total Work: %lu\n", total_work);
+		printf("  Total Work: %lu (%u work threads, %s run queues)\n", total_work,
+		       NUM_WORK_THREADS,
+		       IS_ENABLED(CONFIG_SCHED_WORK_STEALING) ? "per-CPU" : "global");
 
 		for (i = 0; i < NUM_WORK_THREADS; i++) {
 			printf("    - Work Counter #%u: %lu\n",
@@ -48,8 +48,10 @@ extern void thread_switch_yield(uint32_t num_iterations, bool is_cooperative);
 extern void int_to_thread(uint32_t num_iterations);
 extern void sema_test_signal(uint32_t num_iterations, uint32_t options);
 extern void mutex_lock_unlock(uint32_t num_iterations, uint32_t options);
+extern int rwlock_lock_unlock(uint32_t num_iterations, uint32_t options);
 extern void sema_context_switch(uint32_t num_iterations,
 				uint32_t start_options, uint32_t alt_options);
+extern void sema_give_many(uint32_t num_iterations, uint32_t options);
 extern int thread_ops(uint32_t num_iterations, uint32_t start_options,
 		      uint32_t alt_options);
 extern int fifo_ops(uint32_t num_iterations, uint32_t options);
@@ -177,6 +179,11 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	sema_context_switch(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER, K_USER);
 #endif
 
+	sema_give_many(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
+#ifdef CONFIG_USERSPACE
+	sema_give_many(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
+#endif
+
 	condvar_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 0, 0);
 #ifdef CONFIG_USERSPACE
 	condvar_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 0, K_USER);
@@ -201,6 +208,11 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	mutex_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
 #endif
 
+	rwlock_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
+#ifdef CONFIG_USERSPACE
+	rwlock_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
+#endif
+
 	heap_malloc_free();
 
 	TC_END_REPORT(error_count);
@@ -0,0 +1,144 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for reader-writer lock lock and unlock
+ *
+ * This file contains the test that measures reader-writer lock lock and
+ * unlock times in the kernel, for both readers and writers. There is no
+ * contention on the lock being tested; compare with the mutex results.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+static K_RWLOCK_DEFINE(test_rwlock);
+
+static void start_lock_unlock(void *p1, void *p2, void *p3)
+{
+	uint32_t  i;
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t  start;
+	timing_t  mid;
+	timing_t  finish;
+	uint64_t  read_lock_cycles;
+	uint64_t  read_unlock_cycles;
+	uint64_t  write_lock_cycles = 0ull;
+	uint64_t  write_unlock_cycles = 0ull;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* 1. Take the lock for reading many times over */
+
+	start = timing_timestamp_get();
+
+	for (i = 0; i < num_iterations; i++) {
+		k_rwlock_read_lock(&test_rwlock, K_NO_WAIT);
+	}
+
+	finish = timing_timestamp_get();
+
+	read_lock_cycles = timing_cycles_get(&start, &finish);
+
+	start = timing_timestamp_get();
+
+	for (i = 0; i < num_iterations; i++) {
+		k_rwlock_read_unlock(&test_rwlock);
+	}
+
+	finish = timing_timestamp_get();
+
+	read_unlock_cycles = timing_cycles_get(&start, &finish);
+
+	/* 2. Write locks do not nest, so time each lock/unlock pair */
+
+	for (i = 0; i < num_iterations; i++) {
+		start = timing_timestamp_get();
+		k_rwlock_write_lock(&test_rwlock, K_NO_WAIT);
+		mid = timing_timestamp_get();
+		k_rwlock_write_unlock(&test_rwlock);
+		finish = timing_timestamp_get();
+
+		write_lock_cycles += timing_cycles_get(&start, &mid);
+		write_unlock_cycles += timing_cycles_get(&mid, &finish);
+	}
+
+	/* 3. Share the results with the main thread, one at a time */
+
+	timestamp.cycles = read_lock_cycles;
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	timestamp.cycles = read_unlock_cycles;
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	timestamp.cycles = write_lock_cycles;
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	timestamp.cycles = write_unlock_cycles;
+}
+
+static void report(const char *op, const char *str, uint32_t num_iterations,
+		   uint32_t options)
+{
+	char tag[50];
+	char description[120];
+
+	snprintf(tag, sizeof(tag), "rwlock.%s.immediate.%s", op,
+		 (options & K_USER) == K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description), "%-40s - %s", tag, str);
+	PRINT_STATS_AVG(description, (uint32_t)timestamp.cycles,
+			num_iterations, false, "");
+}
+
+/**
+ *
+ * @brief Test for the reader-writer lock lock/unlock time
+ *
+ * The routine performs multiple read locks then multiple read unlocks,
+ * followed by multiple write lock/unlock pairs, to measure the necessary
+ * time.
+ *
+ * @return 0 on success
+ */
+int rwlock_lock_unlock(uint32_t num_iterations, uint32_t options)
+{
+	int  priority;
+
+	timing_start();
+
+	priority = k_thread_priority_get(k_current_get());
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			start_lock_unlock,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, options, K_FOREVER);
+
+	k_thread_access_grant(&start_thread, &test_rwlock, &pause_sem);
+	k_thread_start(&start_thread);
+
+	report("read_lock", "Lock a rwlock for reading", num_iterations, options);
+	k_sem_give(&pause_sem);
+
+	report("read_unlock", "Unlock a rwlock held for reading", num_iterations,
+	       options);
+	k_sem_give(&pause_sem);
+
+	report("write_lock", "Lock a rwlock for writing", num_iterations,
+	       options);
+	k_sem_give(&pause_sem);
+
+	report("write_unlock", "Unlock a rwlock held for writing",
+	       num_iterations, options);
+
+	k_thread_join(&start_thread, K_FOREVER);
+
+	timing_stop();
+	return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time to wake several threads waiting on a semaphore
+ *
+ * This file contains the test that measures the time it takes to hand a
+ * semaphore to NUM_WAITERS pending threads, either by giving it once per
+ * waiter with k_sem_give() or all at once with k_sem_give_many(). The
+ * waiters have a higher priority than the giving thread, so each measured
+ * interval also covers the waiters running and pending again.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#define NUM_WAITERS         4
+#define WAITER_STACK_SIZE   (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stack, NUM_WAITERS,
+				   WAITER_STACK_SIZE);
+static struct k_thread waiter_thread[NUM_WAITERS];
+
+static struct k_sem  sem;
+
+static BENCH_BMEM uint64_t  give_one_cycles;
+static BENCH_BMEM uint64_t  give_many_cycles;
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t   num_iterations = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Each waiter is woken once per iteration of both passes */
+
+	for (uint32_t i = 0; i < 2 * num_iterations; i++) {
+		k_sem_take(&sem, K_FOREVER);
+	}
+}
+
+static void giver_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t   num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t   start;
+	timing_t   finish;
+	uint64_t   sum = 0ull;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* 1. Wake the waiters one give at a time */
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		start = timing_timestamp_get();
+		for (uint32_t j = 0; j < NUM_WAITERS; j++) {
+			k_sem_give(&sem);
+		}
+		finish = timing_timestamp_get();
+
+		sum += timing_cycles_get(&start, &finish);
+	}
+
+	give_one_cycles = sum;
+	sum = 0ull;
+
+	/* 2. Wake the waiters with a single batched give */
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		start = timing_timestamp_get();
+		k_sem_give_many(&sem, NUM_WAITERS);
+		finish = timing_timestamp_get();
+
+		sum += timing_cycles_get(&start, &finish);
+	}
+
+	give_many_cycles = sum;
+}
+
+void sema_give_many(uint32_t num_iterations, uint32_t options)
+{
+	char tag[50];
+	char description[120];
+	int  priority;
+
+	timing_start();
+
+	k_sem_init(&sem, 0, NUM_WAITERS);
+
+	priority = k_thread_priority_get(k_current_get());
+
+	/* Start the waiters first so that they are all pending on <sem> */
+
+	for (uint32_t i = 0; i < NUM_WAITERS; i++) {
+		k_thread_create(&waiter_thread[i], waiter_stack[i],
+				K_THREAD_STACK_SIZEOF(waiter_stack[i]),
+				waiter_entry,
+				(void *)(uintptr_t)num_iterations, NULL, NULL,
+				priority - 2, options, K_FOREVER);
+		k_thread_access_grant(&waiter_thread[i], &sem);
+		k_thread_start(&waiter_thread[i]);
+	}
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			giver_entry,
+			(void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority - 1, options, K_FOREVER);
+	k_thread_access_grant(&start_thread, &sem);
+	k_thread_start(&start_thread);
+
+	k_thread_join(&start_thread, K_FOREVER);
+	for (uint32_t i = 0; i < NUM_WAITERS; i++) {
+		k_thread_join(&waiter_thread[i], K_FOREVER);
+	}
+
+	snprintf(tag, sizeof(tag),
+		 "semaphore.give.wake_%u.%s", NUM_WAITERS,
+		 (options & K_USER) == K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Give a semaphore once per waiter", tag);
+	PRINT_STATS_AVG(description, (uint32_t)give_one_cycles,
+			num_iterations, false, "");
+
+	snprintf(tag, sizeof(tag),
+		 "semaphore.give_many.wake_%u.%s", NUM_WAITERS,
+		 (options & K_USER) == K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Give a semaphore to all waiters at once", tag);
+	PRINT_STATS_AVG(description, (uint32_t)give_many_cycles,
+			num_iterations, false, "");
+
+	timing_stop();
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures malloc() and free() when several threads keep allocating and
+ * freeing bursts of blocks of the same size at the same time.
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/libc-hooks.h>
+
+#define NUM_THREADS  CONFIG_BENCHMARK_NUM_THREADS
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BURST        8
+
+static const size_t block_sizes[] = { 16, 64, 256, 1024 };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static uint64_t malloc_cycles[NUM_THREADS];
+static uint64_t free_cycles[NUM_THREADS];
+static atomic_t failures;
+
+static void burst_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	size_t block_size = POINTER_TO_UINT(p2);
+	void *blocks[BURST];
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+
+	ARG_UNUSED(p3);
+
+	malloc_cycles[id] = 0U;
+	free_cycles[id] = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_timestamp_get();
+		for (unsigned int j = 0; j < BURST; j++) {
+			blocks[j] = malloc(block_size);
+		}
+		mid = timing_timestamp_get();
+		for (unsigned int j = 0; j < BURST; j++) {
+			if (blocks[j] == NULL) {
+				atomic_inc(&failures);
+			}
+			free(blocks[j]);
+		}
+		finish = timing_timestamp_get();
+
+		malloc_cycles[id] += timing_cycles_get(&start, &mid);
+		free_cycles[id] += timing_cycles_get(&mid, &finish);
+	}
+}
+
+static void report(const char *tag, const char *str, size_t block_size,
+		   const uint64_t *cycles)
+{
+	uint64_t total = 0U;
+	uint64_t average;
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		total += cycles[i];
+	}
+	average = total / ((uint64_t)CONFIG_BENCHMARK_NUM_ITERATIONS *
+			   NUM_THREADS * BURST);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%04zu - %s of %4zu bytes : %7llu cycles , %7u ns :\n",
+	       tag, block_size, str, block_size, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%4zu bytes) : %7llu cycles (%7u nsec)\n", str, block_size,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_block_size(size_t block_size)
+{
+	int priority = k_thread_priority_get(k_current_get());
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, burst_entry,
+				UINT_TO_POINTER(i), UINT_TO_POINTER(block_size), NULL,
+				priority + 1, 0, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	report("malloc", "Allocate a block with malloc()", block_size, malloc_cycles);
+	report("free", "Free a block with free()", block_size, free_cycles);
+}
+
+static void report_cache_stats(void)
+{
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	struct malloc_class_stats stats;
+
+	for (unsigned int i = 0; malloc_runtime_class_stats_get(i, &stats) == 0; i++) {
+		printk("Size class %4zu bytes : %8zu hits, %8zu misses, %4zu cached\n",
+		       stats.block_size, stats.hits, stats.misses, stats.cached_blocks);
+	}
+#endif
+}
+
+int main(void)
+{
+	struct sys_memory_stats stats;
+
+	timing_init();
+
+	printk("Time Measurements for malloc %s with %u threads\n",
+	       IS_ENABLED(CONFIG_COMMON_LIBC_MALLOC_CACHE) ? "with per-CPU caches" :
+							     "under one mutex",
+	       NUM_THREADS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(block_sizes); i++) {
+		test_block_size(block_sizes[i]);
+	}
+
+	timing_stop();
+
+	report_cache_stats();
+
+	if (malloc_runtime_stats_get(&stats) == 0) {
+		printk("Heap: %zu bytes allocated, %zu bytes free\n",
+		       stats.allocated_bytes, stats.free_bytes);
+	}
+
+	if (atomic_get(&failures) != 0) {
+		printk("%ld allocations failed\n", (long)atomic_get(&failures));
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the average and worst-case times of allocating and freeing
+ * single, scattered and contiguous sets of blocks from a sys_mem_blocks
+ * allocator whose lower half is fragmented.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/mem_blocks.h>
+#include <zephyr/tc_util.h>
+
+#define BLK_SZ       32
+#define NUM_BLOCKS   256
+#define MAX_COUNT    16
+
+static const unsigned int counts[] = { 1, 4, MAX_COUNT };
+
+SYS_MEM_BLOCKS_DEFINE_STATIC(blocks, BLK_SZ, NUM_BLOCKS, 4);
+
+struct op_stats {
+	uint64_t total;
+	uint64_t max;
+};
+
+static bool failed;
+
+static void record(struct op_stats *stats, timing_t *start, timing_t *finish)
+{
+	uint64_t cycles = timing_cycles_get(start, finish);
+
+	stats->total += cycles;
+	stats->max = MAX(stats->max, cycles);
+}
+
+static void report(const char *tag, const char *str, unsigned int count,
+		   const struct op_stats *stats)
+{
+	uint64_t average = stats->total / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%02u.average - %s %2u blocks, average : %7llu cycles , %7u ns :\n",
+	       tag, count, str, count, average, (uint32_t)timing_cycles_to_ns(average));
+	printk("REC: %s.%02u.max - %s %2u blocks, worst case : %7llu cycles , %7u ns :\n",
+	       tag, count, str, count, stats->max,
+	       (uint32_t)timing_cycles_to_ns(stats->max));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-30s %2u blocks : %7llu cycles (%7u nsec), worst %7llu cycles (%7u nsec)\n",
+	       str, count, average, (uint32_t)timing_cycles_to_ns(average),
+	       stats->max, (uint32_t)timing_cycles_to_ns(stats->max));
+#endif
+}
+
+static void test_scattered(unsigned int count)
+{
+	struct op_stats alloc_stats = { 0 };
+	struct op_stats free_stats = { 0 };
+	void *ptrs[MAX_COUNT];
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_timestamp_get();
+		if (sys_mem_blocks_alloc(&blocks, count, ptrs) != 0) {
+			failed = true;
+			return;
+		}
+		mid = timing_timestamp_get();
+		(void)sys_mem_blocks_free(&blocks, count, ptrs);
+		finish = timing_timestamp_get();
+
+		record(&alloc_stats, &start, &mid);
+		record(&free_stats, &mid, &finish);
+	}
+
+	report("mem_blocks.alloc", "Allocate", count, &alloc_stats);
+	report("mem_blocks.free", "Free", count, &free_stats);
+}
+
+static void test_contiguous(unsigned int count)
+{
+	struct op_stats alloc_stats = { 0 };
+	struct op_stats free_stats = { 0 };
+	void *ptr;
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_timestamp_get();
+		if (sys_mem_blocks_alloc_contiguous(&blocks, count, &ptr) != 0) {
+			failed = true;
+			return;
+		}
+		mid = timing_timestamp_get();
+		(void)sys_mem_blocks_free_contiguous(&blocks, ptr, count);
+		finish = timing_timestamp_get();
+
+		record(&alloc_stats, &start, &mid);
+		record(&free_stats, &mid, &finish);
+	}
+
+	report("mem_blocks.alloc_contiguous", "Allocate contiguous", count, &alloc_stats);
+	report("mem_blocks.free_contiguous", "Free contiguous", count, &free_stats);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s memory blocks allocator\n",
+	       IS_ENABLED(CONFIG_SYS_MEM_BLOCKS_LOCK_FREE) ? "lock-free" : "spinlock");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	/* Keep every other block of the lower half allocated */
+	for (unsigned int i = 0; i < NUM_BLOCKS / 2; i += 2) {
+		(void)sys_mem_blocks_get(&blocks, blocks.buffer + i * BLK_SZ, 1);
+	}
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(counts); i++) {
+		test_scattered(counts[i]);
+		test_contiguous(counts[i]);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("Allocation failed\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
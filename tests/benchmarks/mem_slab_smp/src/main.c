@@ -0,0 +1,131 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures k_mem_slab_alloc() and k_mem_slab_free() when one thread per CPU
+ * keeps allocating and freeing bursts of blocks from the same slab.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_THREADS  CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_BURST    16
+#define BLOCK_SIZE   64
+
+static const unsigned int burst_lengths[] = { 1, 4, MAX_BURST };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+/* Enough blocks for every thread's largest burst, so nobody waits */
+K_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, NUM_THREADS * MAX_BURST * 2, 4);
+
+static uint64_t alloc_cycles[NUM_THREADS];
+static uint64_t free_cycles[NUM_THREADS];
+
+static void burst_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	unsigned int burst_length = POINTER_TO_UINT(p2);
+	void *blocks[MAX_BURST];
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+
+	ARG_UNUSED(p3);
+
+	alloc_cycles[id] = 0U;
+	free_cycles[id] = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_timestamp_get();
+		for (unsigned int j = 0; j < burst_length; j++) {
+			(void)k_mem_slab_alloc(&slab, &blocks[j], K_FOREVER);
+		}
+		mid = timing_timestamp_get();
+		for (unsigned int j = 0; j < burst_length; j++) {
+			k_mem_slab_free(&slab, blocks[j]);
+		}
+		finish = timing_timestamp_get();
+
+		alloc_cycles[id] += timing_cycles_get(&start, &mid);
+		free_cycles[id] += timing_cycles_get(&mid, &finish);
+	}
+}
+
+static void report(const char *tag, const char *str, unsigned int burst_length,
+		   const uint64_t *cycles)
+{
+	uint64_t total = 0U;
+	uint64_t average;
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		total += cycles[i];
+	}
+	average = total / ((uint64_t)CONFIG_BENCHMARK_NUM_ITERATIONS *
+			   NUM_THREADS * burst_length);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%02u - %s in bursts of %2u blocks : %7llu cycles , %7u ns :\n",
+	       tag, burst_length, str, burst_length, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%2u blocks) : %7llu cycles (%7u nsec)\n", str, burst_length,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_burst_length(unsigned int burst_length)
+{
+	int priority = k_thread_priority_get(k_current_get());
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, burst_entry,
+				UINT_TO_POINTER(i), UINT_TO_POINTER(burst_length), NULL,
+				priority + 1, 0, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	report("mem_slab.alloc", "Allocate a block from a shared slab",
+	       burst_length, alloc_cycles);
+	report("mem_slab.free", "Free a block to a shared slab",
+	       burst_length, free_cycles);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s memory slab with %u threads\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_PER_CPU_CACHE) ? "per-CPU cached" : "shared",
+	       NUM_THREADS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(burst_lengths); i++) {
+		test_burst_length(burst_lengths[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
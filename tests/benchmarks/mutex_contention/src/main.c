@@ -0,0 +1,163 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the cost of a contended k_mutex when one thread per CPU keeps
+ * locking it around critical sections of various lengths, and compares it
+ * with the same threads only reading under a k_rwlock.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_THREADS  CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static const unsigned int section_lengths[] = { 0, 100, 1000, 10000 };
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+K_MUTEX_DEFINE(mutex);
+K_RWLOCK_DEFINE(rwlock);
+
+static volatile uint32_t shared_counter;
+
+static void contender_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int section_length = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		for (unsigned int j = 0; j < section_length; j++) {
+			shared_counter++;
+		}
+		k_mutex_unlock(&mutex);
+	}
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int section_length = POINTER_TO_UINT(p1);
+	uint32_t sum = 0U;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_rwlock_read_lock(&rwlock, K_FOREVER);
+		for (unsigned int j = 0; j < section_length; j++) {
+			sum += shared_counter;
+		}
+		k_rwlock_read_unlock(&rwlock);
+	}
+
+	ARG_UNUSED(sum);
+}
+
+static void report(const char *tag, const char *str, unsigned int section_length,
+		   uint64_t cycles)
+{
+	uint64_t average = cycles / (CONFIG_BENCHMARK_NUM_ITERATIONS * NUM_THREADS);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%05u - %s with %5u loop critical section : %7llu cycles , %7u ns :\n",
+	       tag, section_length, str, section_length, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%5u loops) : %7llu cycles (%7u nsec)\n", str, section_length,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void report_mutex_stats(unsigned int section_length)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	struct k_mutex_stats stats;
+
+	if (k_obj_core_stats_raw(K_OBJ_CORE(&mutex), &stats, sizeof(stats)) == 0) {
+		printk("%-40s (%5u loops) : %7u spun, %7u blocked\n",
+		       "Contended locks", section_length,
+		       stats.spin_acquired, stats.blocked);
+	}
+#else
+	ARG_UNUSED(section_length);
+#endif
+}
+
+static uint64_t run_contenders(k_thread_entry_t entry, unsigned int section_length)
+{
+	timing_t start;
+	timing_t finish;
+	int priority = k_thread_priority_get(k_current_get());
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+				UINT_TO_POINTER(section_length), NULL, NULL,
+				priority + 1, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+static void test_section_length(unsigned int section_length)
+{
+	uint64_t cycles;
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_core_stats_reset(K_OBJ_CORE(&mutex));
+#endif
+
+	cycles = run_contenders(contender_entry, section_length);
+	report("mutex.contended", "Lock and unlock contended mutex",
+	       section_length, cycles);
+	report_mutex_stats(section_length);
+
+	cycles = run_contenders(reader_entry, section_length);
+	report("rwlock.read_contended", "Read lock and unlock shared rwlock",
+	       section_length, cycles);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s mutex with %u contending threads\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "adaptive" : "blocking",
+	       NUM_THREADS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(section_lengths); i++) {
+		test_section_length(section_lengths[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
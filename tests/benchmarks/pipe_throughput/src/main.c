@@ -0,0 +1,220 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the time needed to pass frames from a producer to a consumer
+ * thread through a pipe, copying them in and out of the pipe, gathering
+ * them from separate buffers, and accessing them in place.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define FRAME_SIZE   CONFIG_BENCHMARK_FRAME_SIZE
+#define HEADER_SIZE  16
+#define PIPE_SIZE    (4 * FRAME_SIZE)
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+BUILD_ASSERT(FRAME_SIZE > HEADER_SIZE);
+
+enum transfer_method {
+	TRANSFER_COPY,
+	TRANSFER_WRITEV,
+	TRANSFER_CLAIM,
+};
+
+K_PIPE_DEFINE(pipe, PIPE_SIZE, 4);
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+
+static uint8_t producer_frame[FRAME_SIZE];
+static uint8_t producer_header[HEADER_SIZE];
+static uint8_t consumer_frame[FRAME_SIZE];
+
+static atomic_t failures;
+
+static void fill(uint8_t *data, size_t len, uint8_t pattern)
+{
+	memset(data, pattern, len);
+}
+
+/* Writes a frame in place, in as many claims as the ring buffer wrap requires */
+static void produce_in_place(uint8_t pattern)
+{
+	uint8_t *data;
+	size_t done = 0;
+	int rc;
+
+	while (done < FRAME_SIZE) {
+		rc = k_pipe_write_claim(&pipe, &data, FRAME_SIZE - done, K_FOREVER);
+		if (rc <= 0) {
+			atomic_inc(&failures);
+			return;
+		}
+		fill(data, rc, pattern);
+		(void)k_pipe_write_finish(&pipe, rc);
+		done += rc;
+	}
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	enum transfer_method method = POINTER_TO_UINT(p1);
+	const struct k_pipe_iovec iov[] = {
+		{ producer_header, HEADER_SIZE },
+		{ producer_frame, FRAME_SIZE - HEADER_SIZE },
+	};
+	int rc = FRAME_SIZE;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		switch (method) {
+		case TRANSFER_COPY:
+			fill(producer_frame, FRAME_SIZE, (uint8_t)i);
+			rc = k_pipe_write(&pipe, producer_frame, FRAME_SIZE, K_FOREVER);
+			break;
+		case TRANSFER_WRITEV:
+			fill(producer_header, HEADER_SIZE, (uint8_t)i);
+			fill(producer_frame, FRAME_SIZE - HEADER_SIZE, (uint8_t)i);
+			rc = k_pipe_writev(&pipe, iov, ARRAY_SIZE(iov), K_FOREVER);
+			break;
+		case TRANSFER_CLAIM:
+			produce_in_place((uint8_t)i);
+			break;
+		}
+
+		if (rc != FRAME_SIZE) {
+			atomic_inc(&failures);
+		}
+	}
+}
+
+static void check(const uint8_t *first, const uint8_t *last, uint8_t pattern)
+{
+	if (*first != pattern || *last != pattern) {
+		atomic_inc(&failures);
+	}
+}
+
+/* Reads a frame in place, in as many claims as the ring buffer wrap requires */
+static void consume_in_place(uint8_t pattern)
+{
+	const uint8_t *data;
+	size_t done = 0;
+	int rc;
+
+	while (done < FRAME_SIZE) {
+		rc = k_pipe_read_claim(&pipe, &data, FRAME_SIZE - done, K_FOREVER);
+		if (rc <= 0) {
+			atomic_inc(&failures);
+			return;
+		}
+		check(&data[0], &data[rc - 1], pattern);
+		(void)k_pipe_read_finish(&pipe, rc);
+		done += rc;
+	}
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	enum transfer_method method = POINTER_TO_UINT(p1);
+	int rc;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		if (method == TRANSFER_CLAIM) {
+			consume_in_place((uint8_t)i);
+			continue;
+		}
+
+		rc = k_pipe_read(&pipe, consumer_frame, FRAME_SIZE, K_FOREVER);
+		if (rc != FRAME_SIZE) {
+			atomic_inc(&failures);
+			continue;
+		}
+		check(&consumer_frame[0], &consumer_frame[FRAME_SIZE - 1], (uint8_t)i);
+	}
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s, %u bytes per frame : %7llu cycles , %7u ns :\n", tag, str,
+	       FRAME_SIZE, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s : %7llu cycles (%7u nsec) per frame\n", str, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static uint64_t run_transfer(enum transfer_method method)
+{
+	timing_t start;
+	timing_t finish;
+	int priority = k_thread_priority_get(k_current_get());
+
+	k_pipe_reset(&pipe);
+
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE, consumer_entry,
+			UINT_TO_POINTER(method), NULL, NULL, priority + 1, 0, K_FOREVER);
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE, producer_entry,
+			UINT_TO_POINTER(method), NULL, NULL, priority + 1, 0, K_FOREVER);
+
+	start = timing_counter_get();
+
+	k_thread_start(&consumer_thread);
+	k_thread_start(&producer_thread);
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %u byte frames through a pipe\n", FRAME_SIZE);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	report("pipe.copy", "Write and read copies of a frame",
+	       run_transfer(TRANSFER_COPY));
+	report("pipe.writev", "Write a frame from two segments",
+	       run_transfer(TRANSFER_WRITEV));
+	report("pipe.claim", "Write and read a frame in place",
+	       run_transfer(TRANSFER_CLAIM));
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0) {
+		printk("%ld transfers failed\n", (long)atomic_get(&failures));
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
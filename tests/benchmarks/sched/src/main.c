@@ -117,6 +117,9 @@ int main(void)
 	}
 #endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
 
+	printk("%u CPUs, %s run queues\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_SCHED_WORK_STEALING) ? "per-CPU" : "global");
+
 	z_waitq_init(&waitq);
 
 	int main_prio = k_thread_priority_get(k_current_get());
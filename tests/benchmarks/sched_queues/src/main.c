@@ -84,6 +84,12 @@ static void start_threads(unsigned int num_threads)
 		k_thread_create(&test_thread[i], test_stack, TEST_STACK_SIZE,
 				test_entry, (void *)(uintptr_t)i, NULL, NULL,
 				i / bucket_size, 0, K_NO_WAIT);
+#ifdef CONFIG_SCHED_DEADLINE
+		/* Scatter the deadlines so that threads sharing a
+		 * priority must be sorted against each other.
+		 */
+		k_thread_deadline_set(&test_thread[i], (int)((i * 7919U) % 100000U) + 1000);
+#endif
 	}
 }
 
@@ -238,9 +244,12 @@ int main(void)
 
 	freq = timing_freq_get_mhz();
 
-	printk("Time Measurements for %s sched queues\n",
+	printk("Time Measurements for %s sched queues%s (%u threads)\n",
 	       IS_ENABLED(CONFIG_SCHED_SIMPLE) ? "simple" :
-	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
+	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" :
+	       IS_ENABLED(CONFIG_SCHED_BITMAP) ? "bitmap" : "multiq",
+	       IS_ENABLED(CONFIG_SCHED_DEADLINE) ? " with deadlines" : "",
+	       CONFIG_BENCHMARK_NUM_THREADS);
 	printk("Timing results: Clock frequency: %u MHz\n", freq);
 
 	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
@@ -0,0 +1,160 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the read throughput of one thread per CPU reading a few words of
+ * shared data under a k_spinlock, under a sys_seqlock and through
+ * k_uptime_ticks(), while a timer keeps updating the data every tick.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/seqlock.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_THREADS  CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+enum read_method {
+	READ_SPINLOCK,
+	READ_SEQLOCK,
+	READ_UPTIME,
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static struct k_spinlock lock;
+static SYS_SEQLOCK_DEFINE(seqlock);
+
+static struct {
+	uint32_t low;
+	uint32_t high;
+} shared;
+
+static void writer_fn(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	K_SPINLOCK(&lock) {
+		sys_seqlock_write_begin(&seqlock);
+		if (++shared.low == 0U) {
+			shared.high++;
+		}
+		sys_seqlock_write_end(&seqlock);
+	}
+}
+
+K_TIMER_DEFINE(writer_timer, writer_fn, NULL);
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	enum read_method method = POINTER_TO_UINT(p1);
+	uint64_t sum = 0U;
+	unsigned int seq;
+	uint32_t low = 0U;
+	uint32_t high = 0U;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		switch (method) {
+		case READ_SPINLOCK:
+			K_SPINLOCK(&lock) {
+				low = shared.low;
+				high = shared.high;
+			}
+			break;
+		case READ_SEQLOCK:
+			do {
+				seq = sys_seqlock_read_begin(&seqlock);
+				low = shared.low;
+				high = shared.high;
+			} while (sys_seqlock_read_retry(&seqlock, seq));
+			break;
+		case READ_UPTIME:
+			sum += k_uptime_ticks();
+			break;
+		}
+
+		sum += ((uint64_t)high << 32) | low;
+	}
+
+	ARG_UNUSED(sum);
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+	uint64_t average = cycles / (CONFIG_BENCHMARK_NUM_ITERATIONS * NUM_THREADS);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", tag, str, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s : %7llu cycles (%7u nsec)\n", str, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static uint64_t run_readers(enum read_method method)
+{
+	timing_t start;
+	timing_t finish;
+	int priority = k_thread_priority_get(k_current_get());
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, reader_entry,
+				UINT_TO_POINTER(method), NULL, NULL,
+				priority + 1, 0, K_FOREVER);
+	}
+
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (unsigned int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %u concurrent readers, uptime read with %s\n",
+	       NUM_THREADS,
+	       IS_ENABLED(CONFIG_TIMEOUT_TICK_SEQLOCK) ? "seqlock" : "spinlock");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	k_timer_start(&writer_timer, K_TICKS(1), K_TICKS(1));
+
+	report("read.spinlock", "Read two words under a spinlock",
+	       run_readers(READ_SPINLOCK));
+	report("read.seqlock", "Read two words under a seqlock",
+	       run_readers(READ_SEQLOCK));
+	report("read.uptime", "Read the uptime in ticks",
+	       run_readers(READ_UPTIME));
+
+	k_timer_stop(&writer_timer);
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures memcpy(), memset(), memcmp(), memchr() and strlen() on buffers of
+ * several sizes, with word-aligned and with misaligned buffers.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define MAX_SIZE     1024
+#define SLACK        8
+
+static const size_t sizes[] = { 16, 64, 256, MAX_SIZE };
+
+static uint8_t __aligned(8) buf_a[MAX_SIZE + SLACK];
+static uint8_t __aligned(8) buf_b[MAX_SIZE + SLACK];
+
+/* Keeps the compiler from discarding the calls being measured */
+static volatile uintptr_t sink;
+
+enum string_func {
+	FUNC_MEMCPY,
+	FUNC_MEMSET,
+	FUNC_MEMCMP,
+	FUNC_MEMCHR,
+	FUNC_STRLEN,
+};
+
+static const struct {
+	const char *tag;
+	const char *str;
+} funcs[] = {
+	[FUNC_MEMCPY] = { "memcpy", "Copy with memcpy()" },
+	[FUNC_MEMSET] = { "memset", "Fill with memset()" },
+	[FUNC_MEMCMP] = { "memcmp", "Compare equal buffers with memcmp()" },
+	[FUNC_MEMCHR] = { "memchr", "Find the last byte with memchr()" },
+	[FUNC_STRLEN] = { "strlen", "Get the length with strlen()" },
+};
+
+static uint64_t run(enum string_func func, uint8_t *dst, const uint8_t *src, size_t size)
+{
+	timing_t start;
+	timing_t finish;
+
+	start = timing_timestamp_get();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		switch (func) {
+		case FUNC_MEMCPY:
+			sink = (uintptr_t)memcpy(dst, src, size);
+			break;
+		case FUNC_MEMSET:
+			sink = (uintptr_t)memset(dst, i, size);
+			break;
+		case FUNC_MEMCMP:
+			sink = memcmp(dst, src, size);
+			break;
+		case FUNC_MEMCHR:
+			sink = (uintptr_t)memchr(src, 0xff, size);
+			break;
+		case FUNC_STRLEN:
+			sink = strlen((const char *)src);
+			break;
+		}
+	}
+
+	finish = timing_timestamp_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+static void report(enum string_func func, const char *alignment, size_t size,
+		   uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%s.%04zu - %s, %s, %4zu bytes : %7llu cycles , %7u ns :\n",
+	       funcs[func].tag, alignment, size, funcs[func].str, alignment, size,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("%-36s %-10s (%4zu bytes) : %7llu cycles (%7u nsec)\n",
+	       funcs[func].str, alignment, size, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_size(size_t size, size_t dst_off, size_t src_off, const char *alignment)
+{
+	uint8_t *dst = buf_a + dst_off;
+	uint8_t *src = buf_b + src_off;
+
+	for (unsigned int func = 0; func < ARRAY_SIZE(funcs); func++) {
+		/* Equal non-zero contents, terminated by 0xff then 0 */
+		memset(buf_a, 'a', sizeof(buf_a));
+		memset(buf_b, 'a', sizeof(buf_b));
+		src[size - 1] = 0xff;
+		dst[size - 1] = 0xff;
+		src[size] = '\0';
+
+		report(func, alignment, size, run(func, dst, src, size));
+	}
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s string functions\n",
+	       IS_ENABLED(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE) ? "size optimized" :
+									  "word-at-a-time");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		test_size(sizes[i], 0, 0, "aligned");
+		test_size(sizes[i], 1, 3, "misaligned");
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
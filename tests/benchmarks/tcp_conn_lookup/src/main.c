@@ -0,0 +1,354 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the time needed by the network stack to process a TCP segment
+ * received on an established connection, as the number of open connections
+ * grows.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "tcp_internal.h"
+
+#define MAX_CONNS      CONFIG_BENCHMARK_MAX_CONNECTIONS
+#define NUM_SEGMENTS   CONFIG_BENCHMARK_NUM_SEGMENTS
+#define LOCAL_PORT     4242
+#define PEER_PORT_BASE 10000
+#define PEER_ISN       1000U
+
+BUILD_ASSERT(CONFIG_NET_MAX_CONTEXTS > MAX_CONNS);
+BUILD_ASSERT(CONFIG_NET_MAX_CONN > MAX_CONNS);
+
+static struct net_in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct net_in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_if *net_iface;
+static struct net_context *listener;
+static struct net_context *conns[MAX_CONNS];
+static uint32_t local_isn[MAX_CONNS];
+static unsigned int num_conns;
+
+static K_SEM_DEFINE(syn_ack_sem, 0, 1);
+static K_SEM_DEFINE(accept_sem, 0, 1);
+
+static atomic_t resets;
+static atomic_t failures;
+
+static int tester_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	unsigned int idx;
+
+	ARG_UNUSED(dev);
+
+	if (net_pkt_family(pkt) != NET_AF_INET ||
+	    NET_IPV4_HDR(pkt)->proto != NET_IPPROTO_TCP) {
+		return 0;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt)) < 0 ||
+	    net_pkt_read(pkt, &th, sizeof(th)) < 0) {
+		atomic_inc(&failures);
+		return 0;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (th.th_flags & RST) {
+		atomic_inc(&resets);
+		return 0;
+	}
+
+	idx = net_ntohs(th.th_dport) - PEER_PORT_BASE;
+	if (th.th_flags == (SYN | ACK) && idx < MAX_CONNS) {
+		local_isn[idx] = net_ntohl(th.th_seq);
+		k_sem_give(&syn_ack_sem);
+	}
+
+	return 0;
+}
+
+struct bench_context {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+static struct bench_context bench_context_data;
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	struct bench_context *context = net_if_get_device(iface)->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	net_if_set_link_addr(iface, context->mac_addr, sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(tcp_bench, "tcp_bench", bench_dev_init, NULL,
+		&bench_context_data, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static struct net_pkt *prepare_segment(unsigned int idx, uint8_t flags,
+				       uint32_t seq, uint32_t ack)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+
+	pkt = net_pkt_rx_alloc_with_buffer(net_iface, sizeof(struct tcphdr),
+					   NET_AF_INET, NET_IPPROTO_TCP, K_NO_WAIT);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &local_addr) < 0) {
+		goto fail;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (th == NULL) {
+		goto fail;
+	}
+
+	memset(th, 0, sizeof(*th));
+
+	th->th_sport = net_htons(PEER_PORT_BASE + idx);
+	th->th_dport = net_htons(LOCAL_PORT);
+	th->th_off = 5U;
+	th->th_flags = flags;
+	th->th_win = net_htons(NET_IPV6_MTU);
+	th->th_seq = net_htonl(seq);
+	th->th_ack = net_htonl(ack);
+
+	if (net_pkt_set_data(pkt, &tcp_access) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv4_finalize(pkt, NET_IPPROTO_TCP) < 0) {
+		goto fail;
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static int inject(struct net_pkt *pkt)
+{
+	if (pkt == NULL) {
+		return -ENOMEM;
+	}
+
+	if (net_recv_data(net_iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void accept_cb(struct net_context *ctx, struct net_sockaddr *addr,
+		      net_socklen_t addrlen, int status, void *user_data)
+{
+	ARG_UNUSED(addr);
+	ARG_UNUSED(addrlen);
+	ARG_UNUSED(user_data);
+
+	if (status < 0 || num_conns >= MAX_CONNS) {
+		atomic_inc(&failures);
+		return;
+	}
+
+	/* Keep the connection on the application behalf and free its
+	 * listener backlog slot, as accept() would.
+	 */
+	net_context_ref(ctx);
+	net_tcp_conn_accepted(ctx);
+	conns[num_conns++] = ctx;
+
+	k_sem_give(&accept_sem);
+}
+
+static int open_connection(unsigned int idx)
+{
+	int ret;
+
+	ret = inject(prepare_segment(idx, SYN, PEER_ISN, 0U));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (k_sem_take(&syn_ack_sem, K_MSEC(100)) != 0) {
+		return -ETIMEDOUT;
+	}
+
+	ret = inject(prepare_segment(idx, ACK, PEER_ISN + 1U, local_isn[idx] + 1U));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (k_sem_take(&accept_sem, K_MSEC(100)) != 0) {
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+static uint64_t run_segments(unsigned int count)
+{
+	uint64_t cycles = 0U;
+	struct net_pkt *pkt;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < NUM_SEGMENTS; i++) {
+		unsigned int idx = i % count;
+
+		pkt = prepare_segment(idx, ACK, PEER_ISN + 1U, local_isn[idx] + 1U);
+		if (pkt == NULL) {
+			atomic_inc(&failures);
+			continue;
+		}
+
+		start = timing_counter_get();
+
+		if (net_recv_data(net_iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+			atomic_inc(&failures);
+		}
+
+		finish = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	return cycles;
+}
+
+static void report(unsigned int count, uint64_t cycles)
+{
+	uint64_t average = cycles / NUM_SEGMENTS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: tcp.lookup.%u - Process ACK segment, %u connections : "
+	       "%7llu cycles , %7u ns :\n", count, count, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("Process ACK segment, %4u connections : %7llu cycles (%7u nsec) per segment\n",
+	       count, average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static int setup(void)
+{
+	struct net_sockaddr_in addr = {
+		.sin_family = NET_AF_INET,
+		.sin_port = net_htons(LOCAL_PORT),
+		.sin_addr = local_addr,
+	};
+
+	net_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (net_iface == NULL) {
+		return -ENODEV;
+	}
+
+	if (net_if_ipv4_addr_add(net_iface, &local_addr, NET_ADDR_MANUAL, 0) == NULL) {
+		return -EINVAL;
+	}
+
+	if (net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &listener) < 0 ||
+	    net_context_bind(listener, (struct net_sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    net_context_listen(listener, 1) < 0 ||
+	    net_context_accept(listener, accept_cb, K_NO_WAIT, NULL) < 0) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	static const unsigned int steps[] = { 10, 100, 1000 };
+	int ret;
+
+	ret = setup();
+	if (ret < 0) {
+		printk("Cannot set up the listener: %d\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+
+	printk("Time Measurements for TCP segment processing\n");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int s = 0; s < ARRAY_SIZE(steps) && steps[s] <= MAX_CONNS; s++) {
+		while (num_conns < steps[s]) {
+			ret = open_connection(num_conns);
+			if (ret < 0) {
+				printk("Cannot open connection %u: %d\n", num_conns, ret);
+				atomic_inc(&failures);
+				break;
+			}
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		report(steps[s], run_segments(steps[s]));
+	}
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0 || atomic_get(&resets) != 0) {
+		printk("%ld failures, %ld resets\n", (long)atomic_get(&failures),
+		       (long)atomic_get(&resets));
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
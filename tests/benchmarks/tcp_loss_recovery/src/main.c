@@ -0,0 +1,203 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the TCP goodput over the loopback interface while a fixed share
+ * of the packets is dropped.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include <zephyr/net/socket.h>
+#include <zephyr/net/loopback.h>
+
+#define TRANSFER_SIZE    CONFIG_BENCHMARK_TRANSFER_SIZE
+#define TRANSFER_TIMEOUT K_SECONDS(CONFIG_BENCHMARK_TRANSFER_TIMEOUT)
+#define SERVER_PORT      4242
+#define STACK_SIZE       (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static const struct net_sockaddr_in server_addr = {
+	.sin_family = NET_AF_INET,
+	.sin_port = net_htons(SERVER_PORT),
+	.sin_addr = NET_INADDR_LOOPBACK_INIT,
+};
+
+static uint8_t tx_buf[1024];
+static uint8_t rx_buf[1024];
+
+static int listen_sock = -1;
+
+static K_SEM_DEFINE(received_sem, 0, 1);
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+static struct k_thread server_thread;
+
+static atomic_t failures;
+
+/* Receive the transfers one connection after the other */
+static void server_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		size_t received = 0;
+		ssize_t len;
+		int sock;
+
+		sock = zsock_accept(listen_sock, NULL, NULL);
+		if (sock < 0) {
+			atomic_inc(&failures);
+			return;
+		}
+
+		while ((len = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0)) > 0) {
+			received += len;
+
+			if (received == TRANSFER_SIZE) {
+				k_sem_give(&received_sem);
+			}
+		}
+
+		if (len < 0 || received != TRANSFER_SIZE) {
+			atomic_inc(&failures);
+		}
+
+		zsock_close(sock);
+	}
+}
+
+static int setup(void)
+{
+	listen_sock = zsock_socket(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP);
+	if (listen_sock < 0) {
+		return -errno;
+	}
+
+	if (zsock_bind(listen_sock, (struct net_sockaddr *)&server_addr,
+		       sizeof(server_addr)) < 0 ||
+	    zsock_listen(listen_sock, 1) < 0) {
+		return -errno;
+	}
+
+	k_thread_create(&server_thread, server_stack, K_THREAD_STACK_SIZEOF(server_stack),
+			server_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	return 0;
+}
+
+static int run_transfer(float drop_ratio, uint64_t *cycles)
+{
+	size_t sent = 0;
+	timing_t start;
+	timing_t finish;
+	ssize_t len;
+	int sock;
+	int ret;
+
+	k_sem_reset(&received_sem);
+
+	sock = zsock_socket(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	/* Losses are only injected once the connection is established */
+	if (zsock_connect(sock, (struct net_sockaddr *)&server_addr, sizeof(server_addr)) < 0) {
+		ret = -errno;
+		goto out;
+	}
+
+	(void)loopback_set_packet_drop_ratio(drop_ratio);
+
+	start = timing_counter_get();
+
+	while (sent < TRANSFER_SIZE) {
+		len = zsock_send(sock, tx_buf, MIN(sizeof(tx_buf), TRANSFER_SIZE - sent), 0);
+		if (len < 0) {
+			ret = -errno;
+			goto out;
+		}
+
+		sent += len;
+	}
+
+	ret = k_sem_take(&received_sem, TRANSFER_TIMEOUT);
+
+	finish = timing_counter_get();
+
+	*cycles = timing_cycles_get(&start, &finish);
+
+out:
+	(void)loopback_set_packet_drop_ratio(0.0f);
+	zsock_close(sock);
+
+	return ret;
+}
+
+static void report(unsigned int loss_pct, uint64_t cycles)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+	uint32_t kbps = (uint32_t)(((uint64_t)TRANSFER_SIZE * 8U * NSEC_PER_USEC) /
+				   MAX(ns, 1U));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: tcp.loss.%u - Transfer %u bytes, %u%% loss, %u kbit/s : "
+	       "%7llu cycles , %7llu ns :\n", loss_pct, TRANSFER_SIZE, loss_pct, kbps,
+	       cycles, ns);
+#else
+	printk("Transfer %u bytes, %u%% loss : %7llu cycles (%7llu nsec), %7u kbit/s\n",
+	       TRANSFER_SIZE, loss_pct, cycles, ns, kbps);
+#endif
+}
+
+int main(void)
+{
+	static const unsigned int loss_pct[] = { 0, 1, 3, 5 };
+	uint64_t cycles;
+	int ret;
+
+	ret = setup();
+	if (ret < 0) {
+		printk("Cannot set up the server: %d\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+
+	printk("Time Measurements for TCP transfers with packet loss\n");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(loss_pct); i++) {
+		ret = run_transfer(loss_pct[i] / 100.0f, &cycles);
+		if (ret < 0) {
+			printk("Transfer with %u%% loss failed: %d\n", loss_pct[i], ret);
+			atomic_inc(&failures);
+			continue;
+		}
+
+		report(loss_pct[i], cycles);
+	}
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0) {
+		printk("%ld failures, %d packets dropped\n", (long)atomic_get(&failures),
+		       loopback_get_num_dropped_packets());
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the cost of adding and aborting a kernel timeout while a growing
+ * number of other timeouts are pending in the timeout queue.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+/* Keep every timeout far enough away that none expires while measuring */
+#define BASE_DELAY  k_ms_to_ticks_ceil64(60 * MSEC_PER_SEC)
+#define DELAY_SPAN  BIT(16)
+
+static const unsigned int queue_sizes[] = { 10, 100, 1000, 10000 };
+
+static struct _timeout pending[CONFIG_BENCHMARK_MAX_TIMEOUTS];
+static struct _timeout probe;
+
+static uint32_t lcg_state = 1U;
+
+static k_timeout_t random_delay(void)
+{
+	/* Numerical Recipes LCG, good enough to scatter the expiry ticks */
+	lcg_state = (lcg_state * 1664525U) + 1013904223U;
+
+	return K_TICKS(BASE_DELAY + ((lcg_state >> 8) % DELAY_SPAN));
+}
+
+static void timeout_handler(struct _timeout *t)
+{
+	printk("Timeout %p unexpectedly expired\n", t);
+}
+
+static void report(const char *tag, const char *str, unsigned int num_pending,
+		   uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%05u - %s with %5u pending : %7llu cycles , %7u ns :\n", tag,
+	       num_pending, str, num_pending, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s (%5u pending) : %7llu cycles (%7u nsec)\n", str, num_pending,
+	       average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_queue_size(unsigned int num_pending)
+{
+	uint64_t add_cycles = 0ULL;
+	uint64_t abort_cycles = 0ULL;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	for (i = 0; i < num_pending; i++) {
+		z_init_timeout(&pending[i]);
+		z_add_timeout(&pending[i], timeout_handler, random_delay());
+	}
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_timeout_t delay = random_delay();
+
+		z_init_timeout(&probe);
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, timeout_handler, delay);
+		finish = timing_counter_get();
+		add_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		z_abort_timeout(&probe);
+		finish = timing_counter_get();
+		abort_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	for (i = 0; i < num_pending; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+
+	report("timeout_q.add", "Add timeout", num_pending, add_cycles);
+	report("timeout_q.abort", "Abort timeout", num_pending, abort_cycles);
+}
+
+int main(void)
+{
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dlist");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(queue_sizes); i++) {
+		if (queue_sizes[i] <= CONFIG_BENCHMARK_MAX_TIMEOUTS) {
+			test_queue_size(queue_sizes[i]);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
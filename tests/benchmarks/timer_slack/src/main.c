@@ -0,0 +1,133 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Counts how often the system wakes up to serve periodic timers and
+ * self-rescheduling delayable work items with slightly different periods,
+ * with and without timer slack.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_TIMERS      CONFIG_BENCHMARK_NUM_TIMERS
+#define NUM_WORK_ITEMS  CONFIG_BENCHMARK_NUM_WORK_ITEMS
+#define DURATION_MS     CONFIG_BENCHMARK_DURATION_MS
+
+/* Periods spread over a few ticks each, as for unrelated housekeeping */
+#define TIMER_PERIOD_MS(i)  (100 + 3 * (i))
+#define WORK_PERIOD_MS(i)   (200 + 7 * (i))
+
+static struct k_timer timers[NUM_TIMERS];
+static struct k_work_delayable work_items[NUM_WORK_ITEMS];
+static struct k_work_sync work_sync;
+
+static struct k_spinlock lock;
+static int64_t last_wakeup;
+static uint32_t wakeups;
+static bool running;
+
+static void count_wakeup(void)
+{
+	int64_t now = k_uptime_ticks();
+
+	K_SPINLOCK(&lock) {
+		if (now != last_wakeup) {
+			last_wakeup = now;
+			wakeups++;
+		}
+	}
+}
+
+static void timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	count_wakeup();
+}
+
+static void work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	size_t i = dwork - work_items;
+
+	count_wakeup();
+
+	if (running) {
+		(void)k_work_schedule(dwork, K_MSEC(WORK_PERIOD_MS(i)));
+	}
+}
+
+static void report(const char *tag, const char *str, uint32_t count)
+{
+	uint32_t per_second = (uint32_t)(((uint64_t)count * MSEC_PER_SEC) / DURATION_MS);
+	uint64_t ns = (count != 0U) ? (((uint64_t)DURATION_MS * NSEC_PER_MSEC) / count) : 0U;
+	uint64_t cycles = k_ns_to_cyc_floor64(ns);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s, %u wakeups per second : %7llu cycles , %7u ns :\n", tag, str,
+	       per_second, cycles, (uint32_t)ns);
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-40s : %5u wakeups per second, %7llu cycles (%7u nsec) apart\n", str,
+	       per_second, cycles, (uint32_t)ns);
+#endif
+}
+
+static uint32_t run(k_timeout_t slack)
+{
+	K_SPINLOCK(&lock) {
+		last_wakeup = -1;
+		wakeups = 0U;
+	}
+	running = true;
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		k_timer_slack_set(&timers[i], slack);
+		k_timer_start(&timers[i], K_MSEC(TIMER_PERIOD_MS(i)),
+			      K_MSEC(TIMER_PERIOD_MS(i)));
+	}
+
+	for (int i = 0; i < NUM_WORK_ITEMS; i++) {
+		k_work_delayable_slack_set(&work_items[i], slack);
+		(void)k_work_schedule(&work_items[i], K_MSEC(WORK_PERIOD_MS(i)));
+	}
+
+	k_msleep(DURATION_MS);
+
+	running = false;
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		k_timer_stop(&timers[i]);
+	}
+	for (int i = 0; i < NUM_WORK_ITEMS; i++) {
+		(void)k_work_cancel_delayable_sync(&work_items[i], &work_sync);
+	}
+
+	return wakeups;
+}
+
+int main(void)
+{
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		k_timer_init(&timers[i], timer_expiry, NULL);
+	}
+
+	for (int i = 0; i < NUM_WORK_ITEMS; i++) {
+		k_work_init_delayable(&work_items[i], work_handler);
+	}
+
+	printk("Wakeups for %u timers and %u work items over %u ms, %u ticks per second\n",
+	       NUM_TIMERS, NUM_WORK_ITEMS, DURATION_MS, CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+
+	report("timer_slack.none", "Without slack", run(K_NO_WAIT));
+	report("timer_slack.slack", "With slack", run(K_MSEC(CONFIG_BENCHMARK_SLACK_MS)));
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the time needed by the network stack to deliver a received UDP
+ * datagram to its socket, as the number of bound sockets grows.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_context.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define MAX_SOCKETS     CONFIG_BENCHMARK_NUM_SOCKETS
+#define NUM_DATAGRAMS   CONFIG_BENCHMARK_NUM_DATAGRAMS
+#define LOCAL_PORT_BASE 5000
+#define PEER_PORT       53
+
+BUILD_ASSERT(CONFIG_NET_MAX_CONTEXTS >= MAX_SOCKETS);
+BUILD_ASSERT(CONFIG_NET_MAX_CONN >= MAX_SOCKETS);
+
+static struct net_in_addr local_addr = { { { 192, 0, 2, 1 } } };
+static struct net_in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static const uint8_t payload[32];
+
+static struct net_if *net_iface;
+static struct net_context *sockets[MAX_SOCKETS];
+static unsigned int num_sockets;
+static unsigned int expected;
+
+static atomic_t sent;
+static atomic_t failures;
+
+static int tester_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	/* Only an ICMP error may be sent back */
+	atomic_inc(&sent);
+
+	return 0;
+}
+
+struct bench_context {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+static struct bench_context bench_context_data;
+
+static int bench_dev_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static void bench_iface_init(struct net_if *iface)
+{
+	struct bench_context *context = net_if_get_device(iface)->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = 0x01;
+
+	net_if_set_link_addr(iface, context->mac_addr, sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = tester_send,
+};
+
+NET_DEVICE_INIT(udp_bench, "udp_bench", bench_dev_init, NULL,
+		&bench_context_data, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static void recv_cb(struct net_context *ctx, struct net_pkt *pkt,
+		    union net_ip_header *ip_hdr, union net_proto_header *proto_hdr,
+		    int status, void *user_data)
+{
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+
+	if (status < 0 || POINTER_TO_UINT(user_data) != expected) {
+		atomic_inc(&failures);
+	}
+
+	if (pkt != NULL) {
+		net_pkt_unref(pkt);
+	}
+}
+
+static struct net_pkt *prepare_datagram(unsigned int idx)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(net_iface, sizeof(payload),
+					   NET_AF_INET, NET_IPPROTO_UDP, K_NO_WAIT);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_ipv4_create(pkt, &peer_addr, &local_addr) < 0 ||
+	    net_udp_create(pkt, net_htons(PEER_PORT), net_htons(LOCAL_PORT_BASE + idx)) < 0 ||
+	    net_pkt_write(pkt, payload, sizeof(payload)) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_ipv4_finalize(pkt, NET_IPPROTO_UDP) < 0) {
+		goto fail;
+	}
+
+	return pkt;
+
+fail:
+	net_pkt_unref(pkt);
+	return NULL;
+}
+
+static int bind_socket(unsigned int idx)
+{
+	struct net_sockaddr_in addr = {
+		.sin_family = NET_AF_INET,
+		.sin_port = net_htons(LOCAL_PORT_BASE + idx),
+		.sin_addr = local_addr,
+	};
+	struct net_context *ctx;
+	int ret;
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_DGRAM, NET_IPPROTO_UDP, &ctx);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_context_bind(ctx, (struct net_sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = net_context_recv(ctx, recv_cb, K_NO_WAIT, UINT_TO_POINTER(idx));
+	if (ret < 0) {
+		return ret;
+	}
+
+	sockets[idx] = ctx;
+
+	return 0;
+}
+
+static uint64_t run_datagrams(unsigned int count)
+{
+	uint64_t cycles = 0U;
+	struct net_pkt *pkt;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < NUM_DATAGRAMS; i++) {
+		expected = i % count;
+
+		pkt = prepare_datagram(expected);
+		if (pkt == NULL) {
+			atomic_inc(&failures);
+			continue;
+		}
+
+		start = timing_counter_get();
+
+		if (net_recv_data(net_iface, pkt) < 0) {
+			net_pkt_unref(pkt);
+			atomic_inc(&failures);
+		}
+
+		finish = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	return cycles;
+}
+
+static void report(unsigned int count, uint64_t cycles)
+{
+	uint64_t average = cycles / NUM_DATAGRAMS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: udp.demux.%u - Receive datagram, %u bound sockets : "
+	       "%7llu cycles , %7u ns :\n", count, count, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	printk("Receive datagram, %3u bound sockets : %7llu cycles (%7u nsec) per datagram\n",
+	       count, average, (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+int main(void)
+{
+	static const unsigned int steps[] = { 1, 16, 256 };
+	int ret = 0;
+
+	net_iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (net_iface == NULL ||
+	    net_if_ipv4_addr_add(net_iface, &local_addr, NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot set up the interface\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+
+	printk("Time Measurements for UDP datagram reception\n");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int s = 0; s < ARRAY_SIZE(steps) && steps[s] <= MAX_SOCKETS; s++) {
+		while (num_sockets < steps[s]) {
+			ret = bind_socket(num_sockets);
+			if (ret < 0) {
+				printk("Cannot bind socket %u: %d\n", num_sockets, ret);
+				atomic_inc(&failures);
+				break;
+			}
+
+			num_sockets++;
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		report(steps[s], run_datagrams(steps[s]));
+	}
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0 || atomic_get(&sent) != 0) {
+		printk("%ld failures, %ld packets sent back\n", (long)atomic_get(&failures),
+		       (long)atomic_get(&sent));
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measures the time needed to process batches of work items with a work
+ * queue animated by a single thread and with one animated by several
+ * worker threads.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_ITEMS    CONFIG_BENCHMARK_NUM_ITEMS
+#define NUM_WORKERS  CONFIG_BENCHMARK_NUM_WORKERS
+#define ITEM_SIZE    CONFIG_BENCHMARK_ITEM_SIZE
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+BUILD_ASSERT(NUM_WORKERS > 0);
+
+struct bench_item {
+	struct k_work work;
+	uint32_t sum;
+};
+
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_thread workers[NUM_WORKERS];
+static struct k_work_q single_q;
+static struct k_work_q workers_q;
+
+static struct bench_item items[NUM_ITEMS];
+static uint8_t data[ITEM_SIZE];
+static uint32_t expected_sum;
+
+static atomic_t failures;
+
+static uint32_t checksum(void)
+{
+	uint32_t sum = 0;
+
+	for (unsigned int i = 0; i < ITEM_SIZE; i++) {
+		sum = (sum * 31U) + data[i];
+	}
+
+	return sum;
+}
+
+static void item_handler(struct k_work *work)
+{
+	struct bench_item *item = CONTAINER_OF(work, struct bench_item, work);
+
+	item->sum = checksum();
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+	uint64_t average = cycles / ((uint64_t)CONFIG_BENCHMARK_NUM_ITERATIONS * NUM_ITEMS);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s, %u bytes per item : %7llu cycles , %7u ns :\n", tag, str,
+	       ITEM_SIZE, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s : %7llu cycles (%7u nsec) per item\n", str, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static uint64_t run_batches(struct k_work_q *queue)
+{
+	timing_t start;
+	timing_t finish;
+
+	start = timing_counter_get();
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < NUM_ITEMS; j++) {
+			items[j].sum = 0;
+			if (k_work_submit_to_queue(queue, &items[j].work) < 0) {
+				atomic_inc(&failures);
+			}
+		}
+
+		(void)k_work_queue_drain(queue, false);
+
+		for (unsigned int j = 0; j < NUM_ITEMS; j++) {
+			if (items[j].sum != expected_sum) {
+				atomic_inc(&failures);
+			}
+		}
+	}
+
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+int main(void)
+{
+	int priority = k_thread_priority_get(k_current_get());
+	struct k_work_queue_config cfg = {
+		.name = "workers",
+		.pin_workers = IS_ENABLED(CONFIG_BENCHMARK_PIN_WORKERS),
+	};
+
+	for (unsigned int i = 0; i < ITEM_SIZE; i++) {
+		data[i] = (uint8_t)i;
+	}
+	expected_sum = checksum();
+
+	for (unsigned int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i].work, item_handler);
+	}
+
+	k_work_queue_start(&single_q, single_stack, K_THREAD_STACK_SIZEOF(single_stack),
+			   priority + 1, NULL);
+	k_work_queue_start_workers(&workers_q, workers, &worker_stacks[0][0], NUM_WORKERS,
+				   STACK_SIZE, priority + 1, &cfg);
+
+	timing_init();
+
+	printk("Time Measurements for batches of %u work items on %u CPUs\n", NUM_ITEMS,
+	       arch_num_cpus());
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	report("workq.single", "Process items with one thread",
+	       run_batches(&single_q));
+	report("workq.workers", "Process items with worker threads",
+	       run_batches(&workers_q));
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0) {
+		printk("%ld work items failed\n", (long)atomic_get(&failures));
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
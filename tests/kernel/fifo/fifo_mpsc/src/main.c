@@ -0,0 +1,179 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define LIST_LEN       8
+#define NUM_PRODUCERS  3
+#define ITEMS_PER_PROD 200
+
+struct fdata {
+	void *reserved;
+	uint32_t producer;
+	uint32_t seq;
+};
+
+static struct fdata data[LIST_LEN];
+static struct fdata prod_data[NUM_PRODUCERS][ITEMS_PER_PROD];
+
+K_FIFO_MPSC_DEFINE(kfifo);
+static struct k_fifo_mpsc fifo;
+
+static K_THREAD_STACK_ARRAY_DEFINE(prod_stack, NUM_PRODUCERS, STACK_SIZE);
+static struct k_thread prod_thread[NUM_PRODUCERS];
+
+static K_THREAD_STACK_DEFINE(isr_stack, STACK_SIZE);
+static struct k_thread isr_thread;
+
+static void put_list(struct k_fifo_mpsc *pfifo)
+{
+	for (int i = 0; i < LIST_LEN; i++) {
+		k_fifo_mpsc_put(pfifo, &data[i]);
+	}
+}
+
+static void get_list(struct k_fifo_mpsc *pfifo, k_timeout_t timeout)
+{
+	for (int i = 0; i < LIST_LEN; i++) {
+		zassert_equal_ptr(k_fifo_mpsc_get(pfifo, timeout), &data[i]);
+	}
+}
+
+/**
+ * @brief Items come out in the order they were put
+ *
+ * @ingroup kernel_fifo_tests
+ */
+ZTEST(fifo_mpsc, test_fifo_mpsc_order)
+{
+	k_fifo_mpsc_init(&fifo);
+
+	zassert_true(k_fifo_mpsc_is_empty(&fifo));
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_NO_WAIT));
+
+	put_list(&fifo);
+	zassert_false(k_fifo_mpsc_is_empty(&fifo));
+	get_list(&fifo, K_NO_WAIT);
+
+	zassert_true(k_fifo_mpsc_is_empty(&fifo));
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_NO_WAIT));
+
+	/* Statically defined FIFO behaves the same */
+	put_list(&kfifo);
+	get_list(&kfifo, K_NO_WAIT);
+	zassert_true(k_fifo_mpsc_is_empty(&kfifo));
+}
+
+/**
+ * @brief A get with a timeout expires when nothing is put
+ *
+ * @ingroup kernel_fifo_tests
+ */
+ZTEST(fifo_mpsc, test_fifo_mpsc_get_timeout)
+{
+	int64_t start;
+
+	k_fifo_mpsc_init(&fifo);
+
+	start = k_uptime_get();
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_MSEC(50)));
+	zassert_true(k_uptime_get() - start >= 50);
+
+	/* The FIFO is still usable after a timed out wait */
+	put_list(&fifo);
+	get_list(&fifo, K_NO_WAIT);
+}
+
+static void isr_put(const void *p)
+{
+	put_list((struct k_fifo_mpsc *)p);
+}
+
+static void isr_producer_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(10);
+	irq_offload(isr_put, p1);
+}
+
+/**
+ * @brief Puts from an ISR wake a consumer pended on an empty FIFO
+ *
+ * @ingroup kernel_fifo_tests
+ */
+ZTEST(fifo_mpsc, test_fifo_mpsc_isr_wakeup)
+{
+	k_fifo_mpsc_init(&fifo);
+
+	k_thread_create(&isr_thread, isr_stack, STACK_SIZE,
+			isr_producer_entry, &fifo, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	get_list(&fifo, K_FOREVER);
+	zassert_true(k_fifo_mpsc_is_empty(&fifo));
+
+	k_thread_join(&isr_thread, K_FOREVER);
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < ITEMS_PER_PROD; i++) {
+		prod_data[id][i].producer = id;
+		prod_data[id][i].seq = i;
+		k_fifo_mpsc_put(p1, &prod_data[id][i]);
+
+		if ((i % 16) == 0) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Several producers feed one consumer without losing items
+ *
+ * Each producer's items must come out in the order that producer put
+ * them, and all of them must arrive.
+ *
+ * @ingroup kernel_fifo_tests
+ */
+ZTEST(fifo_mpsc, test_fifo_mpsc_multi_producer)
+{
+	uint32_t next_seq[NUM_PRODUCERS] = { 0 };
+	struct fdata *item;
+
+	k_fifo_mpsc_init(&fifo);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&prod_thread[i], prod_stack[i], STACK_SIZE,
+				producer_entry, &fifo, UINT_TO_POINTER(i), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int n = 0; n < NUM_PRODUCERS * ITEMS_PER_PROD; n++) {
+		item = k_fifo_mpsc_get(&fifo, K_SECONDS(5));
+		zassert_not_null(item, "item %d never arrived", n);
+		zassert_true(item->producer < NUM_PRODUCERS);
+		zassert_equal(item->seq, next_seq[item->producer],
+			      "producer %u out of order", item->producer);
+		next_seq[item->producer]++;
+	}
+
+	zassert_is_null(k_fifo_mpsc_get(&fifo, K_NO_WAIT));
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&prod_thread[i], K_FOREVER);
+	}
+}
+
+ZTEST_SUITE(fifo_mpsc, NULL, NULL, NULL, NULL, NULL);
@@ -11,6 +11,10 @@ SYS_MEM_BLOCKS_DEFINE(mem_block, 32, 4, 16);  /* Four 32 byte blocks */
 
 K_MEM_SLAB_DEFINE(mem_slab, 32, 4, 16);       /* Four 32 byte blocks */
 
+K_MUTEX_DEFINE(mutex);
+K_THREAD_STACK_DEFINE(mutex_thread_stack, 512 + CONFIG_TEST_EXTRA_STACK_SIZE);
+struct k_thread mutex_thread;
+
 #if !defined(CONFIG_ARCH_POSIX) && !defined(CONFIG_SPARC) && !defined(CONFIG_MIPS)
 static void test_thread_entry(void *, void *, void *);
 K_THREAD_DEFINE(test_thread, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE,
@@ -693,6 +697,70 @@ ZTEST(obj_core_stats_mem_slab, test_obj_core_stats_mem_slab)
 	k_mem_slab_free(&mem_slab, mem2);
 }
 
+/***************** MUTEXES *********************/
+
+static void test_mutex_raw(const char *str, struct k_mutex_stats *expected)
+{
+	int  status;
+	struct k_mutex_stats  raw;
+
+	status = k_obj_core_stats_raw(K_OBJ_CORE(&mutex), &raw, sizeof(raw));
+	zassert_equal(status, 0,
+		      "%s: Failed to get raw stats (%d)\n", str, status);
+
+	zassert_equal(raw.spin_acquired, expected->spin_acquired,
+		      "%s: Expected %u spin acquisitions, got %u\n",
+		      str, expected->spin_acquired, raw.spin_acquired);
+	zassert_equal(raw.blocked, expected->blocked,
+		      "%s: Expected %u blocked, got %u\n",
+		      str, expected->blocked, raw.blocked);
+}
+
+static void mutex_thread_entry(void *p1, void *p2, void *p3)
+{
+	int  status;
+
+	/* The main thread holds the mutex, so this has to pend */
+
+	status = k_mutex_lock(&mutex, K_MSEC(10));
+	zassert_equal(status, -EAGAIN, "Expected %d, got %d\n",
+		      -EAGAIN, status);
+}
+
+ZTEST(obj_core_stats_mutex, test_obj_core_stats_mutex)
+{
+	struct k_mutex_stats  raw = { .spin_acquired = 0, .blocked = 0 };
+	int  status;
+
+	test_mutex_raw("Initial", &raw);
+
+	/* Uncontended locks are not counted */
+
+	k_mutex_lock(&mutex, K_FOREVER);
+	test_mutex_raw("Uncontended", &raw);
+
+	/* A higher priority thread trying to take it pends */
+
+	k_thread_create(&mutex_thread, mutex_thread_stack,
+			K_THREAD_STACK_SIZEOF(mutex_thread_stack),
+			mutex_thread_entry, NULL, NULL, NULL,
+			K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_join(&mutex_thread, K_FOREVER);
+
+	raw.blocked++;
+	test_mutex_raw("Contended", &raw);
+
+	k_mutex_unlock(&mutex);
+
+	/* Reset the mutex stats */
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&mutex));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	raw.blocked = 0;
+	test_mutex_raw("Reset", &raw);
+}
+
 ZTEST_SUITE(obj_core_stats_system, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
 
@@ -704,3 +772,6 @@ ZTEST_SUITE(obj_core_stats_mem_block, NULL, NULL,
 
 ZTEST_SUITE(obj_core_stats_mem_slab, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+
+ZTEST_SUITE(obj_core_stats_mutex, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -0,0 +1,300 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+ZTEST_SUITE(k_pipe_claim, NULL, NULL, NULL, NULL, NULL);
+
+#define DUMMY_DATA_SIZE 16
+
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_pipe pipe;
+
+static void mkrandom(uint8_t *buffer, size_t size)
+{
+	sys_rand_get(buffer, size);
+}
+
+ZTEST(k_pipe_claim, test_write_claim_read)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE / 2];
+	uint8_t res[DUMMY_DATA_SIZE / 2];
+	uint8_t *data;
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write_claim(&pipe, &data, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to claim space in pipe");
+	memcpy(data, input, sizeof(input));
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == -EAGAIN,
+		"Claimed data should not be readable before it is finished");
+	zassert_ok(k_pipe_write_finish(&pipe, sizeof(input)), "Failed to finish write claim");
+
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to read from pipe");
+	zassert_true(memcmp(input, res, sizeof(input)) == 0,
+		"Unexpected data received from pipe");
+}
+
+ZTEST(k_pipe_claim, test_read_claim_write)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE / 2];
+	const uint8_t *data;
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &data, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to claim data in pipe");
+	zassert_true(memcmp(input, data, sizeof(input)) == 0,
+		"Unexpected data claimed from pipe");
+
+	/* Release half of it, the rest must be claimed again */
+	zassert_ok(k_pipe_read_finish(&pipe, sizeof(input) / 2), "Failed to finish read claim");
+	zassert_true(k_pipe_read_claim(&pipe, &data, sizeof(input), K_NO_WAIT) ==
+		sizeof(input) / 2, "Failed to claim remaining data in pipe");
+	zassert_true(memcmp(&input[sizeof(input) / 2], data, sizeof(input) / 2) == 0,
+		"Unexpected data claimed from pipe");
+	zassert_ok(k_pipe_read_finish(&pipe, sizeof(input) / 2), "Failed to finish read claim");
+
+	zassert_true(k_pipe_read_claim(&pipe, &data, 1, K_MSEC(100)) == -EAGAIN,
+		"Should not be able to claim data from empty pipe");
+}
+
+ZTEST(k_pipe_claim, test_claim_wrap_around)
+{
+	uint8_t buffer[12];
+	uint8_t input[8];
+	uint8_t res[8];
+	uint8_t *data;
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to read from pipe");
+
+	/* Only the 4 bytes up to the end of the ring buffer are contiguous */
+	zassert_true(k_pipe_write_claim(&pipe, &data, sizeof(input), K_NO_WAIT) == 4,
+		"Claim should stop at the end of the ring buffer");
+	memcpy(data, input, 4);
+	zassert_ok(k_pipe_write_finish(&pipe, 4), "Failed to finish write claim");
+	zassert_true(k_pipe_write_claim(&pipe, &data, sizeof(input) - 4, K_NO_WAIT) ==
+		sizeof(input) - 4, "Failed to claim space at the start of the ring buffer");
+	memcpy(data, &input[4], sizeof(input) - 4);
+	zassert_ok(k_pipe_write_finish(&pipe, sizeof(input) - 4), "Failed to finish write claim");
+
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to read from pipe");
+	zassert_true(memcmp(input, res, sizeof(input)) == 0,
+		"Unexpected data received from pipe");
+}
+
+ZTEST(k_pipe_claim, test_claim_busy)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[4] = { 1, 2, 3, 4 };
+	uint8_t res[4];
+	uint8_t *wdata;
+	const uint8_t *rdata;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write_claim(&pipe, &wdata, 2, K_NO_WAIT) == 2,
+		"Failed to claim space in pipe");
+	zassert_true(k_pipe_write_claim(&pipe, &wdata, 2, K_NO_WAIT) == -EBUSY,
+		"Only one write claim should be allowed");
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == -EBUSY,
+		"Writes should not be allowed while a write claim is outstanding");
+	zassert_true(k_pipe_write_finish(&pipe, 3) == -EINVAL,
+		"Finishing more than claimed should fail");
+	zassert_ok(k_pipe_write_finish(&pipe, 0), "Failed to release write claim");
+
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to write to pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &rdata, 2, K_NO_WAIT) == 2,
+		"Failed to claim data in pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &rdata, 2, K_NO_WAIT) == -EBUSY,
+		"Only one read claim should be allowed");
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == -EBUSY,
+		"Reads should not be allowed while a read claim is outstanding");
+	zassert_ok(k_pipe_read_finish(&pipe, 0), "Failed to release read claim");
+
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to read from pipe");
+	zassert_true(memcmp(input, res, sizeof(input)) == 0,
+		"Unexpected data received from pipe");
+
+	/* Reset discards outstanding claims */
+	zassert_true(k_pipe_write_claim(&pipe, &wdata, 2, K_NO_WAIT) == 2,
+		"Failed to claim space in pipe");
+	k_pipe_reset(&pipe);
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to write to reset pipe");
+}
+
+ZTEST(k_pipe_claim, test_writev)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE];
+	uint8_t res[DUMMY_DATA_SIZE];
+	const struct k_pipe_iovec iov[] = {
+		{ &input[0], 3 },
+		{ &input[3], 0 },
+		{ &input[3], 9 },
+		{ &input[12], 4 },
+	};
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_writev(&pipe, iov, ARRAY_SIZE(iov), K_NO_WAIT) == sizeof(input),
+		"Failed to write segments to pipe");
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_NO_WAIT) == sizeof(res),
+		"Failed to read from pipe");
+	zassert_true(memcmp(input, res, sizeof(input)) == 0,
+		"Unexpected data received from pipe");
+
+	/* Only the segments that fit are written */
+	zassert_true(k_pipe_write(&pipe, input, 4, K_NO_WAIT) == 4, "Failed to write to pipe");
+	zassert_true(k_pipe_writev(&pipe, iov, ARRAY_SIZE(iov), K_NO_WAIT) ==
+		sizeof(input) - 4, "Partial segmented write should return bytes written");
+}
+
+static void thread_write_claim(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *data;
+	int rc;
+
+	rc = k_pipe_write_claim((struct k_pipe *)arg1, &data, DUMMY_DATA_SIZE, K_MSEC(1000));
+	zassert_true(rc > 0, "Failed to claim space in pipe");
+	memset(data, 0x55, rc);
+	zassert_ok(k_pipe_write_finish((struct k_pipe *)arg1, rc), "Failed to finish write claim");
+}
+
+ZTEST(k_pipe_claim, test_read_wakes_on_write_finish)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t res[DUMMY_DATA_SIZE];
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write_claim, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+	zassert_true(k_pipe_read(&pipe, res, sizeof(res), K_MSEC(1000)) == sizeof(res),
+		"Reader should be woken by a finished write claim");
+	k_thread_join(tid, K_FOREVER);
+}
+
+static void thread_read_claim(void *arg1, void *arg2, void *arg3)
+{
+	const uint8_t *data;
+	int rc;
+
+	rc = k_pipe_read_claim((struct k_pipe *)arg1, &data, DUMMY_DATA_SIZE, K_MSEC(1000));
+	zassert_true(rc > 0, "Failed to claim data in pipe");
+	zassert_ok(k_pipe_read_finish((struct k_pipe *)arg1, rc), "Failed to finish read claim");
+}
+
+ZTEST(k_pipe_claim, test_claims_wake_each_other)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE] = {};
+	uint8_t *data;
+
+	/* A read claim waits for data written directly by a pending writer */
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read_claim, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	zassert_true(tid, "k_thread_create failed");
+	k_sleep(K_MSEC(100));
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to write to pipe");
+	k_thread_join(tid, K_FOREVER);
+
+	/* A write claim on a full pipe waits for a read claim to be finished */
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to fill pipe");
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read_claim, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+	zassert_true(k_pipe_write_claim(&pipe, &data, sizeof(input), K_MSEC(1000)) > 0,
+		"Write claim should be woken by a finished read claim");
+	zassert_ok(k_pipe_write_finish(&pipe, 0), "Failed to release write claim");
+	k_thread_join(tid, K_FOREVER);
+}
+
+static int pended_rc;
+
+static void thread_write(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t input[4] = {};
+
+	pended_rc = k_pipe_write((struct k_pipe *)arg1, input, sizeof(input), K_MSEC(1000));
+}
+
+static void thread_read(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t res[4];
+
+	pended_rc = k_pipe_read((struct k_pipe *)arg1, res, sizeof(res), K_MSEC(1000));
+}
+
+ZTEST(k_pipe_claim, test_claim_while_pended)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE] = {};
+	uint8_t *wdata;
+	const uint8_t *rdata;
+
+	/* The woken thread must not run before the claim is taken */
+	Z_TEST_SKIP_IFDEF(CONFIG_SMP);
+
+	/* A writer pended on a full pipe finds a write claim when it wakes up */
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to fill pipe");
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_write, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	zassert_true(tid, "k_thread_create failed");
+	k_sleep(K_MSEC(100));
+	zassert_true(k_pipe_read_claim(&pipe, &rdata, 4, K_NO_WAIT) == 4,
+		"Failed to claim data in pipe");
+	zassert_ok(k_pipe_read_finish(&pipe, 4), "Failed to finish read claim");
+	zassert_true(k_pipe_write_claim(&pipe, &wdata, 4, K_NO_WAIT) == 4,
+		"Failed to claim space in pipe");
+	k_thread_join(tid, K_FOREVER);
+	zassert_true(pended_rc == -EBUSY, "Pended writer should fail on a write claim");
+	zassert_ok(k_pipe_write_finish(&pipe, 4), "Write claim should not have been disturbed");
+
+	/* A reader pended on an empty pipe finds a read claim when it wakes up */
+	k_pipe_reset(&pipe);
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_read, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	zassert_true(tid, "k_thread_create failed");
+	k_sleep(K_MSEC(100));
+	zassert_true(k_pipe_write_claim(&pipe, &wdata, 4, K_NO_WAIT) == 4,
+		"Failed to claim space in pipe");
+	zassert_ok(k_pipe_write_finish(&pipe, 4), "Failed to finish write claim");
+	zassert_true(k_pipe_read_claim(&pipe, &rdata, 4, K_NO_WAIT) == 4,
+		"Failed to claim data in pipe");
+	k_thread_join(tid, K_FOREVER);
+	zassert_true(pended_rc == -EBUSY, "Pended reader should fail on a read claim");
+	zassert_ok(k_pipe_read_finish(&pipe, 4), "Read claim should not have been disturbed");
+}
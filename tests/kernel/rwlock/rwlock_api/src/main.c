@@ -0,0 +1,268 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_READERS  3
+#define PRIO_HIGH    K_HIGHEST_APPLICATION_THREAD_PRIO
+
+K_RWLOCK_DEFINE(krwlock);
+static struct k_rwlock rwlock;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_READERS + 1, STACK_SIZE);
+static struct k_thread threads[NUM_READERS + 1];
+
+static atomic_t readers_in;
+static atomic_t writer_done;
+
+static void check_basic(struct k_rwlock *prwlock)
+{
+	/* Readers share the lock, and keep writers out */
+	zassert_equal(k_rwlock_read_lock(prwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_read_lock(prwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_write_lock(prwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_write_unlock(prwlock), -EPERM);
+	zassert_equal(k_rwlock_read_unlock(prwlock), 0);
+	zassert_equal(k_rwlock_write_lock(prwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_read_unlock(prwlock), 0);
+	zassert_equal(k_rwlock_read_unlock(prwlock), -EINVAL);
+
+	/* A writer keeps everybody else out */
+	zassert_equal(k_rwlock_write_lock(prwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_read_lock(prwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_write_lock(prwlock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_read_unlock(prwlock), -EINVAL);
+	zassert_equal(k_rwlock_write_unlock(prwlock), 0);
+	zassert_equal(k_rwlock_write_unlock(prwlock), -EPERM);
+
+	/* And the lock is free again */
+	zassert_equal(k_rwlock_write_lock(prwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_write_unlock(prwlock), 0);
+}
+
+/**
+ * @brief Test lock and unlock without contention
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST_USER(rwlock, test_rwlock_basic)
+{
+	check_basic(&krwlock);
+}
+
+/**
+ * @brief Test a reader-writer lock initialized at runtime
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock, test_rwlock_init)
+{
+	zassert_equal(k_rwlock_init(&rwlock), 0);
+	check_basic(&rwlock);
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	k_timeout_t timeout = SYS_TIMEOUT_MS(POINTER_TO_INT(p2));
+
+	ARG_UNUSED(p3);
+
+	if (k_rwlock_read_lock(p1, timeout) == 0) {
+		atomic_inc(&readers_in);
+	}
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	k_timeout_t timeout = SYS_TIMEOUT_MS(POINTER_TO_INT(p2));
+
+	ARG_UNUSED(p3);
+
+	if (k_rwlock_write_lock(p1, timeout) == 0) {
+		atomic_set(&writer_done, 1);
+		zassert_equal(k_rwlock_write_unlock(p1), 0);
+	} else {
+		atomic_set(&writer_done, -1);
+	}
+}
+
+static void spawn(int i, k_thread_entry_t entry, int timeout_ms)
+{
+	k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+			&rwlock, INT_TO_POINTER(timeout_ms), NULL,
+			PRIO_HIGH, 0, K_NO_WAIT);
+
+	/* The ztest thread is cooperative: let the new thread run until it
+	 * gets the lock, gives up or pends on it.
+	 */
+	k_yield();
+}
+
+static void join_all(int num)
+{
+	for (int i = 0; i < num; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+}
+
+/**
+ * @brief Test that several threads hold a read lock at the same time
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock_1cpu, test_rwlock_concurrent_readers)
+{
+	k_rwlock_init(&rwlock);
+	atomic_set(&readers_in, 0);
+
+	for (int i = 0; i < NUM_READERS; i++) {
+		spawn(i, reader_entry, 0);
+	}
+	join_all(NUM_READERS);
+
+	zassert_equal(atomic_get(&readers_in), NUM_READERS);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+
+	for (int i = 0; i < NUM_READERS; i++) {
+		zassert_equal(k_rwlock_read_unlock(&rwlock), 0);
+	}
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0);
+}
+
+/**
+ * @brief Test that a waiting writer keeps new readers out
+ *
+ * The writer gets the lock as soon as the last reader releases it.
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock_1cpu, test_rwlock_writer_preference)
+{
+	k_rwlock_init(&rwlock);
+	atomic_set(&readers_in, 0);
+	atomic_set(&writer_done, 0);
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0);
+
+	/* The writer pends behind us */
+	spawn(0, writer_entry, SYS_FOREVER_MS);
+	zassert_equal(atomic_get(&writer_done), 0);
+
+	/* New readers may not overtake it */
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	spawn(1, reader_entry, 0);
+	k_thread_join(&threads[1], K_FOREVER);
+	zassert_equal(atomic_get(&readers_in), 0);
+
+	/* Releasing the read lock hands it to the writer */
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0);
+	k_thread_join(&threads[0], K_FOREVER);
+	zassert_equal(atomic_get(&writer_done), 1);
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0);
+}
+
+/**
+ * @brief Test that unlocking a write lock lets all waiting readers in
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock_1cpu, test_rwlock_wake_readers)
+{
+	k_rwlock_init(&rwlock);
+	atomic_set(&readers_in, 0);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0);
+
+	for (int i = 0; i < NUM_READERS; i++) {
+		spawn(i, reader_entry, SYS_FOREVER_MS);
+	}
+	zassert_equal(atomic_get(&readers_in), 0);
+
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0);
+	join_all(NUM_READERS);
+	zassert_equal(atomic_get(&readers_in), NUM_READERS);
+
+	for (int i = 0; i < NUM_READERS; i++) {
+		zassert_equal(k_rwlock_read_unlock(&rwlock), 0);
+	}
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL);
+}
+
+/**
+ * @brief Test that readers blocked by a writer that times out get in
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock_1cpu, test_rwlock_writer_timeout)
+{
+	k_rwlock_init(&rwlock);
+	atomic_set(&readers_in, 0);
+	atomic_set(&writer_done, 0);
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), 0);
+
+	/* A writer waits a while, and a reader queues up behind it */
+	spawn(0, writer_entry, 50);
+	spawn(1, reader_entry, SYS_FOREVER_MS);
+	zassert_equal(atomic_get(&readers_in), 0);
+
+	/* When the writer gives up, the reader goes ahead */
+	join_all(2);
+	zassert_equal(atomic_get(&writer_done), -1);
+	zassert_equal(atomic_get(&readers_in), 1);
+
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0);
+	zassert_equal(k_rwlock_read_unlock(&rwlock), 0);
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0);
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_RWLOCK
+/**
+ * @brief Test the contention statistics
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock_1cpu, test_rwlock_stats)
+{
+	struct k_rwlock_stats stats;
+
+	k_rwlock_init(&rwlock);
+
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), 0);
+	spawn(0, reader_entry, 10);
+	spawn(1, writer_entry, 10);
+	join_all(2);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), 0);
+
+	zassert_equal(k_obj_core_stats_raw(K_OBJ_CORE(&rwlock), &stats,
+					   sizeof(stats)), 0);
+	zassert_equal(stats.read_blocked, 1);
+	zassert_equal(stats.write_blocked, 1);
+
+	zassert_equal(k_obj_core_stats_reset(K_OBJ_CORE(&rwlock)), 0);
+	zassert_equal(k_obj_core_stats_raw(K_OBJ_CORE(&rwlock), &stats,
+					   sizeof(stats)), 0);
+	zassert_equal(stats.read_blocked, 0);
+	zassert_equal(stats.write_blocked, 0);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_RWLOCK */
+
+static void *rwlock_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &krwlock);
+#endif
+	return NULL;
+}
+
+ZTEST_SUITE(rwlock, NULL, rwlock_setup, NULL, NULL, NULL);
+ZTEST_SUITE(rwlock_1cpu, NULL, NULL, ztest_simple_1cpu_before,
+	    ztest_simple_1cpu_after, NULL);
@@ -881,6 +881,92 @@ ZTEST(semaphore, test_sem_multiple_threads_wait)
 	}
 }
 
+/**
+ * @brief Test giving a semaphore several times in one call
+ * @details
+ * - With no waiters, the count grows by the number of gives, capped at
+ *   the semaphore's limit.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_give_many()
+ */
+ZTEST_USER(semaphore, test_sem_give_many_count)
+{
+	k_sem_reset(&simple_sem);
+
+	k_sem_give_many(&simple_sem, 0U);
+	expect_k_sem_count_get_nomsg(&simple_sem, 0U);
+
+	k_sem_give_many(&simple_sem, 3U);
+	expect_k_sem_count_get_nomsg(&simple_sem, 3U);
+
+	k_sem_give_many(&simple_sem, SEM_MAX_VAL);
+	expect_k_sem_count_get_nomsg(&simple_sem, SEM_MAX_VAL);
+
+	k_sem_give_many(&simple_sem, UINT_MAX);
+	expect_k_sem_count_get_nomsg(&simple_sem, SEM_MAX_VAL);
+
+	k_sem_reset(&simple_sem);
+}
+
+/**
+ * @brief Test waking several waiting threads with one give
+ * @details
+ * - Pend TOTAL_THREADS_WAITING threads on a semaphore.
+ * - Give it fewer times than there are waiters and check that exactly
+ *   that many threads get it.
+ * - Give it more times than the remaining waiters and check that they
+ *   all get it and the surplus ends up in the count.
+ * @ingroup kernel_semaphore_tests
+ * @see k_sem_give_many()
+ */
+ZTEST(semaphore, test_sem_give_many_wake)
+{
+	const unsigned int first = TOTAL_THREADS_WAITING - 2;
+	const unsigned int surplus = 3U;
+
+	k_sem_reset(&simple_sem);
+	k_sem_reset(&multiple_thread_sem);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_create(&multiple_tid[i],
+				multiple_stack[i], STACK_SIZE,
+				sem_multiple_threads_wait_helper,
+				NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1),
+				K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	/* giving time for the other threads to pend */
+	k_sleep(K_MSEC(500));
+
+	k_sem_give_many(&multiple_thread_sem, first);
+	k_sleep(K_MSEC(500));
+
+	for (unsigned int i = 0; i < first; i++) {
+		expect_k_sem_take_nomsg(&simple_sem, K_NO_WAIT, 0);
+	}
+	expect_k_sem_take(&simple_sem, K_NO_WAIT, -EBUSY,
+			  "Too many threads got multiple_thread_sem: %d != %d");
+	expect_k_sem_count_get_nomsg(&multiple_thread_sem, 0U);
+
+	k_sem_give_many(&multiple_thread_sem,
+			TOTAL_THREADS_WAITING - first + surplus);
+	k_sleep(K_MSEC(500));
+
+	for (unsigned int i = first; i < TOTAL_THREADS_WAITING; i++) {
+		expect_k_sem_take(&simple_sem, K_FOREVER, 0,
+			"Some of the threads did not get multiple_thread_sem: %d != %d");
+	}
+	expect_k_sem_count_get_nomsg(&simple_sem, 0U);
+	expect_k_sem_count_get_nomsg(&multiple_thread_sem, surplus);
+
+	for (int i = 0; i < TOTAL_THREADS_WAITING; i++) {
+		k_thread_join(&multiple_tid[i], K_FOREVER);
+	}
+
+	k_sem_reset(&multiple_thread_sem);
+}
+
 /**
  * @brief Test semaphore timeout period
  * @ingroup kernel_semaphore_tests
@@ -1285,6 +1285,166 @@ ZTEST(smp, test_smp_affinity)
 }
 #endif
 
+#if defined(CONFIG_SCHED_WORK_STEALING) && defined(CONFIG_SCHED_CPU_MASK)
+#define STEAL_PRIO K_PRIO_PREEMPT(1)
+
+static struct k_thread steal_thread[3];
+static K_THREAD_STACK_ARRAY_DEFINE(steal_stack, 3, STACK_SIZE);
+static struct k_sem steal_sem[2];
+static volatile int steal_order[2];
+static volatile int steal_count;
+static volatile bool steal_release;
+
+static void steal_waiter_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	int id = POINTER_TO_INT(p1);
+
+	k_sem_take(&steal_sem[id], K_FOREVER);
+	steal_order[steal_count++] = id;
+}
+
+static void steal_spinner_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!steal_release) {
+		arch_spin_relax();
+	}
+}
+
+static void steal_control_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Let the spinners take over every other CPU */
+	k_busy_wait(DELAY_US);
+
+	/* Thread 0 is queued on CPU 1 first, thread 1 on CPU 0 after it */
+	k_sem_give(&steal_sem[0]);
+	k_sem_give(&steal_sem[1]);
+
+	/* Only CPU 0 is free to pick them */
+	k_sleep(K_MSEC(100));
+
+	steal_release = true;
+}
+
+/**
+ * @brief Test equal priority ordering across per-CPU run queues
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Make two threads of equal priority runnable, the first on
+ * the run queue of CPU 1 and the second on the one of CPU 0, while
+ * every CPU but CPU 0 is kept busy. Check that CPU 0 runs the thread
+ * queued first, even though the other one is queued locally.
+ */
+ZTEST(smp, test_work_stealing_fifo)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	steal_count = 0;
+	steal_release = false;
+
+	/* Have each waiter run once on its CPU, so that it is queued
+	 * there when woken up, then let it run anywhere.
+	 */
+	for (int i = 0; i < 2; i++) {
+		k_sem_init(&steal_sem[i], 0, 1);
+		k_thread_create(&steal_thread[i], steal_stack[i], STACK_SIZE,
+				steal_waiter_entry, INT_TO_POINTER(i), NULL, NULL,
+				STEAL_PRIO, 0, K_FOREVER);
+		k_thread_cpu_pin(&steal_thread[i], 1 - i);
+		k_thread_start(&steal_thread[i]);
+	}
+
+	k_sleep(K_MSEC(10));
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(k_thread_cpu_mask_enable_all(&steal_thread[i]));
+	}
+
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				steal_spinner_entry, NULL, NULL, NULL,
+				K_PRIO_COOP(2), 0, K_FOREVER);
+		k_thread_cpu_pin(&tthread[i], i);
+		k_thread_start(&tthread[i]);
+	}
+
+	k_thread_create(&steal_thread[2], steal_stack[2], STACK_SIZE,
+			steal_control_entry, NULL, NULL, NULL,
+			K_PRIO_COOP(1), 0, K_FOREVER);
+	k_thread_cpu_pin(&steal_thread[2], 0);
+	k_thread_start(&steal_thread[2]);
+
+	k_thread_join(&steal_thread[2], K_FOREVER);
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+	for (int i = 0; i < 2; i++) {
+		k_thread_join(&steal_thread[i], K_FOREVER);
+	}
+
+	zassert_equal(steal_count, 2, "waiters did not run");
+	zassert_equal(steal_order[0], 0, "thread queued later on CPU 0 ran first");
+}
+#endif
+
+#define TIMEOUT_ROUNDS 20
+
+static void timeout_sleep_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	int thread_num = POINTER_TO_INT(p1);
+
+	for (int i = 0; i < TIMEOUT_ROUNDS; i++) {
+		/* Stagger the deadlines so the earliest one moves between CPUs */
+		k_ticks_t ticks = 1 + ((thread_num + i) % 4);
+		int64_t start = k_uptime_ticks();
+
+		k_sleep(K_TICKS(ticks));
+
+		zassert_true(k_uptime_ticks() - start >= ticks,
+			     "thread %d woke up early", thread_num);
+	}
+
+	tinfo[thread_num].executed = 1;
+}
+
+/**
+ * @brief Test concurrent timeouts armed from all CPUs
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Spawn one thread per CPU, each sleeping repeatedly with
+ * staggered durations, so that timeouts are added to and expire from
+ * the timeout queue(s) of every CPU concurrently. Check that no thread
+ * wakes up early and that no wakeup is lost.
+ */
+ZTEST(smp, test_smp_timeouts)
+{
+	unsigned int num_threads = arch_num_cpus();
+
+	spawn_threads(K_PRIO_COOP(10), num_threads, EQUAL_PRIORITY,
+		      &timeout_sleep_entry, !THREAD_DELAY);
+
+	for (int i = 0; i < num_threads; i++) {
+		zassert_ok(k_thread_join(tinfo[i].tid, K_MSEC(TIMEOUT)),
+			   "thread %d did not finish sleeping", i);
+		zassert_true(tinfo[i].executed == 1, "thread %d did not finish", i);
+	}
+
+	cleanup_resources();
+}
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -0,0 +1,185 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define SLACK_TICKS 16
+#define SLACK       K_TICKS(SLACK_TICKS)
+#define NUM_EXPIRY  3
+
+static struct k_timer timer_a;
+static struct k_timer timer_b;
+
+static int64_t expiry_ticks[NUM_EXPIRY];
+static int num_expiry;
+
+static struct k_work_delayable dwork_a;
+static struct k_work_delayable dwork_b;
+static K_SEM_DEFINE(work_sem, 0, 2);
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static void record_expiry(struct k_timer *timer)
+{
+	/* Uptime reflects the tick of the expiring timeout here */
+	int64_t *tick = k_timer_user_data_get(timer);
+
+	*tick = k_uptime_ticks();
+
+	if ((timer == &timer_a) && (num_expiry < NUM_EXPIRY)) {
+		expiry_ticks[num_expiry++] = *tick;
+	}
+}
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_sem_give(&work_sem);
+}
+
+/* Sleep until the start of a slack period, so that deadlines a few ticks
+ * apart fall within the same period.
+ */
+static int64_t align_to_slack(void)
+{
+	int64_t start = ROUND_UP(k_uptime_ticks() + 1, SLACK_TICKS);
+
+	k_sleep(K_TIMEOUT_ABS_TICKS(start));
+
+	return k_uptime_ticks();
+}
+
+static void slack_before(void *fixture)
+{
+	static int64_t tick_a;
+	static int64_t tick_b;
+
+	ARG_UNUSED(fixture);
+
+	k_timer_init(&timer_a, record_expiry, NULL);
+	k_timer_init(&timer_b, record_expiry, NULL);
+	k_timer_user_data_set(&timer_a, &tick_a);
+	k_timer_user_data_set(&timer_b, &tick_b);
+	num_expiry = 0;
+
+	k_work_init_delayable(&dwork_a, work_handler);
+	k_work_init_delayable(&dwork_b, work_handler);
+	k_sem_reset(&work_sem);
+}
+
+static void slack_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_timer_stop(&timer_a);
+	k_timer_stop(&timer_b);
+	(void)k_work_cancel_delayable_sync(&dwork_a, &work_sync);
+	(void)k_work_cancel_delayable_sync(&dwork_b, &work_sync);
+}
+
+/* A timer with slack expires on a multiple of the slack, no earlier
+ * than its duration.
+ */
+ZTEST(timer_slack, test_timer_deferred)
+{
+	int64_t *tick = k_timer_user_data_get(&timer_a);
+
+	k_timer_slack_set(&timer_a, SLACK);
+
+	for (int i = 1; i < SLACK_TICKS; i += 5) {
+		int64_t start = k_uptime_ticks();
+
+		k_timer_start(&timer_a, K_TICKS(i), K_NO_WAIT);
+		zassert_equal(k_timer_status_sync(&timer_a), 1);
+
+		zassert_equal(*tick % SLACK_TICKS, 0, "expired at %lld", *tick);
+		zassert_true(*tick >= start + i, "expired early at %lld", *tick);
+		zassert_true(*tick < start + i + 1 + SLACK_TICKS, "expired late at %lld", *tick);
+	}
+}
+
+/* Timers with different durations but the same slack expire together. */
+ZTEST(timer_slack, test_timers_coalesced)
+{
+	int64_t *tick_a = k_timer_user_data_get(&timer_a);
+	int64_t *tick_b = k_timer_user_data_get(&timer_b);
+
+	k_timer_slack_set(&timer_a, SLACK);
+	k_timer_slack_set(&timer_b, SLACK);
+
+	align_to_slack();
+	k_timer_start(&timer_a, K_TICKS(2), K_NO_WAIT);
+	k_timer_start(&timer_b, K_TICKS(SLACK_TICKS / 2), K_NO_WAIT);
+
+	zassert_equal(k_timer_status_sync(&timer_a), 1);
+	zassert_equal(k_timer_status_sync(&timer_b), 1);
+	zassert_equal(*tick_a, *tick_b, "expired at %lld and %lld", *tick_a, *tick_b);
+}
+
+/* A periodic timer whose period is a multiple of the slack stays aligned. */
+ZTEST(timer_slack, test_periodic)
+{
+	k_timer_slack_set(&timer_a, SLACK);
+	k_timer_start(&timer_a, K_TICKS(1), K_TICKS(2 * SLACK_TICKS));
+
+	k_sleep(K_TICKS((NUM_EXPIRY + 1) * 2 * SLACK_TICKS));
+	k_timer_stop(&timer_a);
+
+	zassert_equal(num_expiry, NUM_EXPIRY);
+	for (int i = 0; i < NUM_EXPIRY; i++) {
+		zassert_equal(expiry_ticks[i] % SLACK_TICKS, 0,
+			      "expiry %d at %lld", i, expiry_ticks[i]);
+	}
+	for (int i = 1; i < NUM_EXPIRY; i++) {
+		zassert_equal(expiry_ticks[i] - expiry_ticks[i - 1], 2 * SLACK_TICKS);
+	}
+}
+
+/* Without slack, the expiry is not deferred. */
+ZTEST(timer_slack, test_no_slack)
+{
+	int64_t *tick = k_timer_user_data_get(&timer_a);
+	int64_t start;
+
+	k_timer_slack_set(&timer_a, SLACK);
+	k_timer_slack_set(&timer_a, K_NO_WAIT);
+
+	start = align_to_slack();
+	k_timer_start(&timer_a, K_TICKS(2), K_NO_WAIT);
+	zassert_equal(k_timer_status_sync(&timer_a), 1);
+
+	zassert_true(*tick < start + SLACK_TICKS / 2, "expired late at %lld", *tick);
+}
+
+/* Delayable work items with the same slack are submitted together. */
+ZTEST(timer_slack, test_work_coalesced)
+{
+	k_ticks_t expires_a;
+	k_ticks_t expires_b;
+
+	k_work_delayable_slack_set(&dwork_a, SLACK);
+	k_work_delayable_slack_set(&dwork_b, SLACK);
+
+	align_to_slack();
+	zassert_equal(k_work_schedule(&dwork_a, K_TICKS(2)), 1);
+	zassert_equal(k_work_schedule(&dwork_b, K_TICKS(SLACK_TICKS / 2)), 1);
+
+	expires_a = k_work_delayable_expires_get(&dwork_a);
+	expires_b = k_work_delayable_expires_get(&dwork_b);
+	zassert_equal(expires_a, expires_b, "expire at %lld and %lld",
+		      (long long)expires_a, (long long)expires_b);
+	zassert_equal(expires_a % SLACK_TICKS, 0);
+
+	zassert_ok(k_sem_take(&work_sem, K_TICKS(2 * SLACK_TICKS)));
+	zassert_ok(k_sem_take(&work_sem, K_TICKS(2 * SLACK_TICKS)));
+}
+
+ZTEST_SUITE(timer_slack, NULL, NULL, slack_before, slack_after, NULL);
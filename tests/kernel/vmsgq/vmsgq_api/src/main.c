@@ -0,0 +1,200 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE   (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BUF_SIZE     64
+#define NUM_MSGS     8
+
+K_VMSGQ_DEFINE(kvmsgq, BUF_SIZE);
+static struct k_vmsgq vmsgq;
+static uint32_t __aligned(4) vmsgq_buf[BUF_SIZE / 4];
+
+static K_THREAD_STACK_DEFINE(stack, STACK_SIZE);
+static struct k_thread thread;
+
+static const char *const msgs[] = { "", "a", "ab", "abc", "abcd", "abcde" };
+
+static void check_put_get(struct k_vmsgq *q)
+{
+	char data[BUF_SIZE];
+
+	/* Messages of every length come out as they went in */
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		zassert_equal(k_vmsgq_put(q, msgs[i], strlen(msgs[i]), K_NO_WAIT), 0);
+	}
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		memset(data, 0, sizeof(data));
+		zassert_equal(k_vmsgq_get(q, data, sizeof(data), K_NO_WAIT), strlen(msgs[i]));
+		zassert_str_equal(data, msgs[i]);
+	}
+	zassert_equal(k_vmsgq_get(q, data, sizeof(data), K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_vmsgq_free_space_get(q), BUF_SIZE);
+
+	/* A message too long for the receive buffer stays in the queue */
+	zassert_equal(k_vmsgq_put(q, "abcdef", 6, K_NO_WAIT), 0);
+	zassert_equal(k_vmsgq_get(q, data, 5, K_NO_WAIT), -EMSGSIZE);
+	zassert_equal(k_vmsgq_get(q, data, 6, K_NO_WAIT), 6);
+	zassert_mem_equal(data, "abcdef", 6);
+
+	/* Messages that can never fit are rejected */
+	zassert_equal(k_vmsgq_put(q, data, BUF_SIZE, K_NO_WAIT), -EMSGSIZE);
+
+	/* A full queue times out */
+	zassert_equal(k_vmsgq_put(q, data, BUF_SIZE - 4, K_NO_WAIT), 0);
+	zassert_equal(k_vmsgq_free_space_get(q), 0);
+	zassert_equal(k_vmsgq_put(q, data, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_vmsgq_put(q, data, 1, K_MSEC(10)), -EAGAIN);
+	zassert_equal(k_vmsgq_get(q, data, 0, K_NO_WAIT), -EMSGSIZE);
+}
+
+/**
+ * @brief Test sending and receiving messages by copy
+ *
+ * @ingroup kernel_vmsgq_tests
+ */
+ZTEST_USER(vmsgq, test_vmsgq_put_get)
+{
+	char data[BUF_SIZE];
+
+	check_put_get(&kvmsgq);
+
+	/* Leave the queue empty for the next run */
+	zassert_equal(k_vmsgq_get(&kvmsgq, data, sizeof(data), K_NO_WAIT), BUF_SIZE - 4);
+}
+
+/**
+ * @brief Test a variable-size message queue initialized at runtime
+ *
+ * @ingroup kernel_vmsgq_tests
+ */
+ZTEST(vmsgq, test_vmsgq_init)
+{
+	k_vmsgq_init(&vmsgq, vmsgq_buf, sizeof(vmsgq_buf));
+	check_put_get(&vmsgq);
+}
+
+/**
+ * @brief Test writing and reading messages in place
+ *
+ * @ingroup kernel_vmsgq_tests
+ */
+ZTEST(vmsgq, test_vmsgq_alloc_claim)
+{
+	void *msg[3];
+	void *claimed;
+	size_t len;
+
+	k_vmsgq_init(&vmsgq, vmsgq_buf, sizeof(vmsgq_buf));
+
+	/* Messages are received in allocation order, once committed */
+	zassert_equal(k_vmsgq_alloc(&vmsgq, 5, &msg[0], K_NO_WAIT), 0);
+	zassert_equal(k_vmsgq_alloc(&vmsgq, 9, &msg[1], K_NO_WAIT), 0);
+	zassert_true(IS_ALIGNED(msg[1], 4));
+	memcpy(msg[1], "123456789", 9);
+	k_vmsgq_commit(&vmsgq, msg[1]);
+	zassert_equal(k_vmsgq_claim(&vmsgq, &claimed, &len, K_NO_WAIT), -ENOMSG);
+
+	memcpy(msg[0], "12345", 5);
+	k_vmsgq_commit(&vmsgq, msg[0]);
+	zassert_equal(k_vmsgq_claim(&vmsgq, &claimed, &len, K_NO_WAIT), 0);
+	zassert_equal(claimed, msg[0]);
+	zassert_equal(len, 5);
+	zassert_equal(k_vmsgq_claim(&vmsgq, &claimed, &len, K_NO_WAIT), 0);
+	zassert_equal(claimed, msg[1]);
+	zassert_equal(len, 9);
+	zassert_mem_equal(claimed, "123456789", 9);
+
+	/* Space is only reused once every older message is freed */
+	k_vmsgq_free(&vmsgq, msg[1]);
+	zassert_equal(k_vmsgq_free_space_get(&vmsgq), BUF_SIZE - 12 - 16);
+	k_vmsgq_free(&vmsgq, msg[0]);
+	zassert_equal(k_vmsgq_free_space_get(&vmsgq), BUF_SIZE);
+
+	/* A message that does not fit before the end wraps around */
+	zassert_equal(k_vmsgq_alloc(&vmsgq, 36, &msg[0], K_NO_WAIT), 0);
+	zassert_equal(k_vmsgq_alloc(&vmsgq, 8, &msg[1], K_NO_WAIT), 0);
+	k_vmsgq_commit(&vmsgq, msg[0]);
+	k_vmsgq_commit(&vmsgq, msg[1]);
+	zassert_equal(k_vmsgq_claim(&vmsgq, &claimed, &len, K_NO_WAIT), 0);
+	k_vmsgq_free(&vmsgq, claimed);
+	zassert_equal(k_vmsgq_alloc(&vmsgq, 32, &msg[2], K_NO_WAIT), 0);
+	zassert_equal(msg[2], vmsgq_buf + 1);
+	k_vmsgq_commit(&vmsgq, msg[2]);
+
+	zassert_equal(k_vmsgq_claim(&vmsgq, &claimed, &len, K_NO_WAIT), 0);
+	zassert_equal(claimed, msg[1]);
+	k_vmsgq_free(&vmsgq, claimed);
+	zassert_equal(k_vmsgq_claim(&vmsgq, &claimed, &len, K_NO_WAIT), 0);
+	zassert_equal(claimed, msg[2]);
+	zassert_equal(len, 32);
+	k_vmsgq_free(&vmsgq, claimed);
+	zassert_equal(k_vmsgq_free_space_get(&vmsgq), BUF_SIZE);
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_vmsgq *q = p1;
+	uint8_t data[NUM_MSGS];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		memset(data, i, i + 1);
+		zassert_equal(k_vmsgq_put(q, data, i + 1, K_FOREVER), 0);
+	}
+}
+
+/**
+ * @brief Test that producers and consumers wait for each other
+ *
+ * @ingroup kernel_vmsgq_tests
+ */
+ZTEST(vmsgq, test_vmsgq_wait)
+{
+	uint8_t data[NUM_MSGS];
+	void *msg;
+
+	/* Room for a single message at a time */
+	k_vmsgq_init(&vmsgq, vmsgq_buf, 4 + NUM_MSGS);
+
+	k_thread_create(&thread, stack, STACK_SIZE, producer_entry, &vmsgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	for (int i = 0; i < NUM_MSGS; i++) {
+		memset(data, 0xff, sizeof(data));
+		zassert_equal(k_vmsgq_get(&vmsgq, data, sizeof(data), K_FOREVER), i + 1);
+		for (int j = 0; j <= i; j++) {
+			zassert_equal(data[j], i);
+		}
+	}
+
+	k_thread_join(&thread, K_FOREVER);
+
+	/* A waiting producer gets space as soon as it is freed */
+	zassert_equal(k_vmsgq_alloc(&vmsgq, NUM_MSGS, &msg, K_NO_WAIT), 0);
+	k_vmsgq_commit(&vmsgq, msg);
+	k_thread_create(&thread, stack, STACK_SIZE, producer_entry, &vmsgq, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	zassert_equal(k_vmsgq_get(&vmsgq, data, sizeof(data), K_NO_WAIT), NUM_MSGS);
+	for (int i = 0; i < NUM_MSGS; i++) {
+		zassert_equal(k_vmsgq_get(&vmsgq, data, sizeof(data), K_FOREVER), i + 1);
+	}
+	k_thread_join(&thread, K_FOREVER);
+}
+
+static void *vmsgq_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &kvmsgq);
+#endif
+	return NULL;
+}
+
+ZTEST_SUITE(vmsgq, NULL, vmsgq_setup, NULL, NULL, NULL);
@@ -0,0 +1,236 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 3
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+#define RELEASE_DELAY K_MSEC(50)
+#define START_TIMEOUT K_MSEC(1000)
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_thread workers[NUM_WORKERS];
+static struct k_work_q work_q;
+static bool work_q_started;
+
+/* Work item whose handler blocks until it is released. */
+struct test_item {
+	struct k_work work;
+	struct k_sem release;
+};
+
+static struct test_item items[NUM_WORKERS];
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+/* Given by a handler once it starts running. */
+static K_SEM_DEFINE(started_sem, 0, 2 * NUM_WORKERS);
+
+static atomic_t running;
+static atomic_t max_running;
+static atomic_t runs;
+static atomic_t released;
+
+static void blocking_handler(struct k_work *work)
+{
+	struct test_item *item = CONTAINER_OF(work, struct test_item, work);
+	atomic_val_t now = atomic_inc(&running) + 1;
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&max_running);
+	} while ((now > max) && !atomic_cas(&max_running, max, now));
+
+	k_sem_give(&started_sem);
+	k_sem_take(&item->release, K_FOREVER);
+
+	atomic_inc(&runs);
+	atomic_dec(&running);
+}
+
+static void release_all(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	atomic_set(&released, 1);
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&items[i].release);
+	}
+}
+
+static K_TIMER_DEFINE(release_timer, release_all, NULL);
+
+static void wait_started(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&started_sem, START_TIMEOUT),
+			   "work item %d did not start", i);
+	}
+}
+
+static void workers_before(void *fixture)
+{
+	struct k_work_queue_config cfg = {
+		.name = "workers",
+		.pin_workers = IS_ENABLED(CONFIG_TEST_PIN_WORKERS),
+	};
+
+	ARG_UNUSED(fixture);
+
+	atomic_clear(&running);
+	atomic_clear(&max_running);
+	atomic_clear(&runs);
+	atomic_clear(&released);
+	k_sem_reset(&started_sem);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&items[i].work, blocking_handler);
+		k_sem_init(&items[i].release, 0, 2);
+	}
+
+	k_work_queue_init(&work_q);
+	k_work_queue_start_workers(&work_q, workers, &worker_stacks[0][0],
+				   NUM_WORKERS, STACK_SIZE, WORKER_PRIORITY, &cfg);
+	work_q_started = true;
+}
+
+static void stop_workers(void)
+{
+	zassert_true(k_work_queue_drain(&work_q, true) >= 0);
+	zassert_ok(k_work_queue_stop(&work_q, K_FOREVER));
+
+	/* Every worker has exited once the queue is stopped */
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_thread_join(&workers[i], START_TIMEOUT),
+			   "worker %d did not exit", i);
+	}
+
+	work_q_started = false;
+}
+
+static void workers_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_timer_stop(&release_timer);
+	if (work_q_started) {
+		release_all(NULL);
+		stop_workers();
+	}
+}
+
+/* Items submitted together run concurrently on all workers. */
+ZTEST(workq_workers, test_concurrent)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_work_submit_to_queue(&work_q, &items[i].work), 1);
+	}
+
+	wait_started(NUM_WORKERS);
+	zassert_equal(atomic_get(&max_running), NUM_WORKERS);
+
+	release_all(NULL);
+	zassert_true(k_work_queue_drain(&work_q, false) >= 0);
+	zassert_equal(atomic_get(&runs), NUM_WORKERS);
+}
+
+/* An item resubmitted while running is not picked by another worker. */
+ZTEST(workq_workers, test_no_reentrancy)
+{
+	struct k_work *work = &items[0].work;
+
+	zassert_equal(k_work_submit_to_queue(&work_q, work), 1);
+	wait_started(1);
+
+	zassert_equal(k_work_submit_to_queue(&work_q, work), 2);
+	zassert_equal(k_work_busy_get(work), K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Give the idle workers a chance to pick it */
+	k_sleep(RELEASE_DELAY);
+	zassert_equal(atomic_get(&running), 1);
+
+	k_sem_give(&items[0].release);
+	wait_started(1);
+	k_sem_give(&items[0].release);
+
+	zassert_true(k_work_flush(work, &work_sync));
+	zassert_equal(k_work_busy_get(work), 0);
+	zassert_equal(atomic_get(&runs), 2);
+	zassert_equal(atomic_get(&max_running), 1);
+}
+
+/* Flushing a running item waits for its handler even when other workers
+ * are idle.
+ */
+ZTEST(workq_workers, test_flush_running)
+{
+	struct k_work *work = &items[0].work;
+
+	zassert_equal(k_work_submit_to_queue(&work_q, work), 1);
+	wait_started(1);
+
+	k_timer_start(&release_timer, RELEASE_DELAY, K_NO_WAIT);
+	zassert_true(k_work_flush(work, &work_sync));
+
+	zassert_true(atomic_get(&released));
+	zassert_equal(k_work_busy_get(work), 0);
+	zassert_equal(atomic_get(&runs), 1);
+}
+
+/* Cancelling a running item waits for its handler and leaves the items
+ * queued behind it to the other workers.
+ */
+ZTEST(workq_workers, test_cancel_running)
+{
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0].work), 1);
+	wait_started(1);
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[1].work), 1);
+	wait_started(1);
+
+	k_timer_start(&release_timer, RELEASE_DELAY, K_NO_WAIT);
+	zassert_true(k_work_cancel_sync(&items[0].work, &work_sync));
+
+	zassert_true(atomic_get(&released));
+	zassert_equal(k_work_busy_get(&items[0].work), 0);
+
+	zassert_true(k_work_flush(&items[1].work, &work_sync));
+	zassert_equal(atomic_get(&runs), 2);
+}
+
+/* Draining waits until no worker is running an item. */
+ZTEST(workq_workers, test_drain)
+{
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		zassert_equal(k_work_submit_to_queue(&work_q, &items[i].work), 1);
+	}
+	wait_started(NUM_WORKERS);
+
+	k_timer_start(&release_timer, RELEASE_DELAY, K_NO_WAIT);
+	zassert_equal(k_work_queue_drain(&work_q, true), 1);
+
+	zassert_true(atomic_get(&released));
+	zassert_equal(atomic_get(&runs), NUM_WORKERS);
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0].work), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&work_q));
+}
+
+/* Stopping the queue stops every worker. */
+ZTEST(workq_workers, test_stop)
+{
+	zassert_equal(k_work_queue_thread_get(&work_q), &workers[0]);
+	zassert_equal(k_work_queue_stop(&work_q, K_FOREVER), -EBUSY);
+
+	stop_workers();
+
+	zassert_equal(k_work_queue_stop(&work_q, K_FOREVER), -EALREADY);
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0].work), -ENODEV);
+}
+
+ZTEST_SUITE(workq_workers, NULL, NULL, workers_before, workers_after, NULL);
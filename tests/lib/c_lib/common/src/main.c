@@ -533,6 +533,76 @@ ZTEST(libc_common, test_memchr)
 	zassert_is_null(memchr(str, '\0', strlen(str)), "memchr scope error");
 }
 
+/**
+ * @brief Test memory and string functions around word boundaries
+ *
+ * Runs every combination of buffer alignment and length up to a few words,
+ * so that both the byte-wise head and tail and the word-wise middle of
+ * optimized implementations are covered.
+ *
+ * @see memcpy(), memset(), memcmp(), memchr(), strlen().
+ */
+ZTEST(libc_common, test_mem_str_alignment)
+{
+	static unsigned char src[64 + 16];
+	static unsigned char dst[64 + 16];
+	unsigned char *s, *d;
+
+	for (int i = 0; i < sizeof(src); i++) {
+		/* keep clear of the sign bit, minimal libc memcmp() compares chars */
+		src[i] = 1 + (i * 7) % 127;
+	}
+
+	for (size_t d_off = 0; d_off < 8; d_off++) {
+		for (size_t s_off = 0; s_off < 8; s_off++) {
+			for (size_t len = 0; len <= 64; len++) {
+				s = src + s_off;
+				d = dst + d_off;
+
+				memset(dst, 0xa5, sizeof(dst));
+				zassert_equal(memcpy(d, s, len), d, "memcpy error");
+				for (size_t i = 0; i < sizeof(dst); i++) {
+					unsigned char expect = (i >= d_off && i < d_off + len) ?
+							       src[s_off + i - d_off] : 0xa5;
+
+					zassert_equal(dst[i], expect,
+						      "memcpy %zu bytes from +%zu to +%zu failed",
+						      len, s_off, d_off);
+				}
+				zassert_equal(memcmp(d, s, len), 0, "memcmp equal failed");
+
+				if (len > 0) {
+					d[len - 1] = 0;
+					zassert_true(memcmp(d, s, len) < 0,
+						     "memcmp last byte failed");
+					zassert_true(memcmp(s, d, len) > 0,
+						     "memcmp last byte failed");
+					zassert_equal(strlen((char *)d), len - 1,
+						      "strlen of %zu bytes at +%zu failed",
+						      len - 1, d_off);
+					d[len - 1] = 0x80;
+					zassert_equal(memchr(d, 0x80, len), &d[len - 1],
+						      "memchr of %zu bytes at +%zu failed",
+						      len, d_off);
+					zassert_is_null(memchr(d, 0x80, len - 1),
+							"memchr beyond count failed");
+				}
+
+				memset(dst, 0, sizeof(dst));
+				zassert_equal(memset(d, s_off + 1, len), d, "memset error");
+				for (size_t i = 0; i < sizeof(dst); i++) {
+					unsigned char expect = (i >= d_off && i < d_off + len) ?
+							       s_off + 1 : 0;
+
+					zassert_equal(dst[i], expect,
+						      "memset %zu bytes at +%zu failed",
+						      len, d_off);
+				}
+			}
+		}
+	}
+}
+
 /**
  * @brief Test memcpy operation
  *
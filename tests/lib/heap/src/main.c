@@ -42,9 +42,15 @@
 #define SMALL_HEAP_SZ MIN(BIG_HEAP_SZ, 2048)
 
 /* With enabling SYS_HEAP_RUNTIME_STATS, the size of struct z_heap
- * will increase 16 bytes on 64 bit CPU.
+ * will increase 16 bytes on 64 bit CPU.  With SYS_HEAP_TLSF the bucket
+ * array grows with the heap size, these values are for the default
+ * of 8 second level lists.
  */
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+#if defined(CONFIG_SYS_HEAP_TLSF) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+#define SOLO_FREE_HEADER_HEAP_SZ (160)
+#elif defined(CONFIG_SYS_HEAP_TLSF)
+#define SOLO_FREE_HEADER_HEAP_SZ (104)
+#elif defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
 #define SOLO_FREE_HEADER_HEAP_SZ (80)
 #else
 #define SOLO_FREE_HEADER_HEAP_SZ (64)
@@ -160,6 +166,25 @@ static void log_result(size_t sz, struct z_heap_stress_result *r)
 		 r->total_frees, avg, (int) sz, avg_pct);
 }
 
+static void *rawalloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void rawfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+static void log_cycles(struct z_heap_stress_result *r)
+{
+	TC_PRINT("alloc cycles: avg %u, max %u, free cycles: avg %u, max %u\n",
+		 (uint32_t)(r->accumulated_alloc_cycles / MAX(r->total_allocs, 1U)),
+		 r->max_alloc_cycles,
+		 (uint32_t)(r->accumulated_free_cycles / MAX(r->total_frees, 1U)),
+		 r->max_free_cycles);
+}
+
 /* Do a heavy test over a small heap, with many iterations that need
  * to reuse memory repeatedly.  Target 50% fill, as that setting tends
  * to prevent runaway fragmentation and most allocations continue to
@@ -238,6 +263,33 @@ ZTEST(lib_heap, test_big_heap)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+/* Measure the allocation and free times in a heavily fragmented heap,
+ * without the validation done by testalloc() and testfree() getting
+ * in the way.  Run this with and without CONFIG_SYS_HEAP_TLSF to
+ * compare the bucket search strategies.
+ */
+ZTEST(lib_heap, test_alloc_cycles)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	size_t heap_sz = IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY) ?
+			 SMALL_HEAP_SZ : BIG_HEAP_SZ;
+
+	TC_PRINT("Timing %s bucket search in a %d byte heap\n",
+		 IS_ENABLED(CONFIG_SYS_HEAP_TLSF) ? "two-level" : "bounded",
+		 (int) heap_sz);
+
+	sys_heap_init(&heap, heapmem, heap_sz);
+	sys_heap_stress(rawalloc, rawfree, &heap,
+			heap_sz, ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			100, &result);
+	zassert_true(sys_heap_validate(&heap), "");
+
+	log_result(heap_sz, &result);
+	log_cycles(&result);
+}
+
 /* Test a heap with a solo free header.  A solo free header can exist
  * only on a heap with 64 bit CPU (or chunk_header_bytes() == 8).
  * With 64 bytes heap and 1 byte allocation on a big heap, we get:
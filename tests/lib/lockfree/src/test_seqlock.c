@@ -0,0 +1,131 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/seqlock.h>
+
+static SYS_SEQLOCK_DEFINE(seqlock);
+
+/*
+ * @brief Check the reader side against single writes
+ *
+ * @see sys_seqlock_read_begin(), sys_seqlock_read_retry()
+ *
+ * @ingroup tests
+ */
+ZTEST(seqlock, test_read_retry)
+{
+	unsigned int seq;
+
+	sys_seqlock_init(&seqlock);
+
+	seq = sys_seqlock_read_begin(&seqlock);
+	zassert_equal(seq & 1U, 0, "Sequence should be even when idle");
+	zassert_false(sys_seqlock_read_retry(&seqlock, seq),
+		      "Read without a write should not retry");
+
+	sys_seqlock_write_begin(&seqlock);
+	zassert_true(sys_seqlock_read_retry(&seqlock, seq),
+		     "Read overlapping a write should retry");
+	sys_seqlock_write_end(&seqlock);
+	zassert_true(sys_seqlock_read_retry(&seqlock, seq),
+		     "Read before a completed write should retry");
+
+	seq = sys_seqlock_read_begin(&seqlock);
+	zassert_equal(seq & 1U, 0, "Sequence should be even after a write");
+	zassert_false(sys_seqlock_read_retry(&seqlock, seq),
+		      "Read after a write should not retry");
+}
+
+#define SEQLOCK_ITERATIONS 100000
+#define SEQLOCK_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define SEQLOCK_THREADS_NUM 4
+
+static struct k_thread seqlock_thread[SEQLOCK_THREADS_NUM];
+static K_THREAD_STACK_ARRAY_DEFINE(seqlock_stack, SEQLOCK_THREADS_NUM, SEQLOCK_STACK_SIZE);
+
+/* Written as a pair, readers must never see one without the other */
+static struct k_spinlock writer_lock;
+static uint64_t shared_value;
+static uint64_t shared_check;
+
+static void seqlock_writer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint64_t i = 1; i <= SEQLOCK_ITERATIONS; i++) {
+		K_SPINLOCK(&writer_lock) {
+			sys_seqlock_write_begin(&seqlock);
+			shared_value = i;
+			shared_check = ~i;
+			sys_seqlock_write_end(&seqlock);
+		}
+
+		if ((i % 64) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static void seqlock_reader(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	uint64_t value, check, last = 0;
+	unsigned int seq;
+
+	for (int i = 0; i < SEQLOCK_ITERATIONS; i++) {
+		do {
+			seq = sys_seqlock_read_begin(&seqlock);
+			value = shared_value;
+			check = shared_check;
+		} while (sys_seqlock_read_retry(&seqlock, seq));
+
+		zassert_equal(check, ~value, "Torn read of %llx / %llx", value, check);
+		zassert_true(value >= last, "Value went backwards");
+		last = value;
+
+		if ((i % 64) == 0) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test that readers always see consistent data
+ *
+ * This can and should be validated on SMP machines where readers run
+ * in parallel with the writer.
+ */
+ZTEST(seqlock, test_seqlock_threaded)
+{
+	sys_seqlock_init(&seqlock);
+	shared_value = 0;
+	shared_check = ~0ULL;
+
+	k_thread_create(&seqlock_thread[0], seqlock_stack[0], SEQLOCK_STACK_SIZE,
+			seqlock_writer, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(5), K_INHERIT_PERMS, K_NO_WAIT);
+
+	for (int i = 1; i < SEQLOCK_THREADS_NUM; i++) {
+		k_thread_create(&seqlock_thread[i], seqlock_stack[i], SEQLOCK_STACK_SIZE,
+				seqlock_reader, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(5), K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < SEQLOCK_THREADS_NUM; i++) {
+		k_thread_join(&seqlock_thread[i], K_FOREVER);
+	}
+
+	zassert_equal(shared_value, SEQLOCK_ITERATIONS);
+}
+
+ZTEST_SUITE(seqlock, NULL, NULL, NULL, NULL, NULL);
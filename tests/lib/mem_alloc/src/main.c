@@ -24,6 +24,8 @@
 #include <errno.h>
 #include <time.h>
 #include <stdint.h>
+#include <limits.h>
+#include <zephyr/sys/libc-hooks.h>
 
 /*
  * Don't complain about ridiculous alloc size requests
@@ -370,6 +372,46 @@ ZTEST(c_lib_dynamic_memalloc, test_memalloc_max)
 }
 #endif
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+/**
+ * @brief Test the per-CPU malloc caches
+ *
+ * A freed small block is handed out again from the cache, and blocks
+ * held by the caches are given back to the heap before malloc() fails.
+ */
+ZTEST(c_lib_dynamic_memalloc, test_malloc_cache)
+{
+	struct malloc_class_stats before, after;
+	void *ptr, *big;
+
+	zassert_equal(malloc_runtime_class_stats_get(0, NULL), -EINVAL);
+	zassert_equal(malloc_runtime_class_stats_get(UINT_MAX, &before), -EINVAL);
+
+	/* Prime the cache of the smallest class */
+	ptr = malloc(1);
+	zassert_not_null(ptr, "malloc failed, errno: %d", errno);
+	free(ptr);
+
+	zassert_equal(malloc_runtime_class_stats_get(0, &before), 0);
+	zassert_true(before.cached_blocks > 0, "freed block not cached");
+
+	k_sched_lock();
+	ptr = malloc(before.block_size);
+	zassert_not_null(ptr, "malloc failed, errno: %d", errno);
+	zassert_equal(malloc_runtime_class_stats_get(0, &after), 0);
+	k_sched_unlock();
+
+	zassert_equal(after.hits, before.hits + 1, "allocation not served from cache");
+	zassert_equal(after.cached_blocks, before.cached_blocks - 1);
+	free(ptr);
+
+	/* Cached blocks must not make a large allocation fail */
+	big = malloc(CONFIG_COMMON_LIBC_MALLOC_ARENA_SIZE / 2);
+	zassert_not_null(big, "malloc failed, errno: %d", errno);
+	free(big);
+}
+#endif /* CONFIG_COMMON_LIBC_MALLOC_CACHE */
+
 /**
  * @}
  */
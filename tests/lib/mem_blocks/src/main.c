@@ -21,6 +21,10 @@ SYS_MEM_BLOCKS_DEFINE_STATIC_WITH_EXT_BUF(mem_block_02,
 					  BLK_SZ, NUM_BLOCKS,
 					  mem_block_02_buf);
 
+/* Spans several words of the allocation bitmap */
+#define NUM_BLOCKS_LARGE 100
+SYS_MEM_BLOCKS_DEFINE_STATIC(mem_block_03, 16, NUM_BLOCKS_LARGE, 4);
+
 static sys_multi_mem_blocks_t alloc_group;
 
 static ZTEST_DMEM volatile int expected_reason = -1;
@@ -631,6 +635,73 @@ ZTEST(lib_mem_block, test_multi_mem_block_alloc_free)
 		      "sys_multi_mem_blocks_free failed (%d)", ret);
 }
 
+static void *block_at(sys_mem_blocks_t *mem_block, size_t idx)
+{
+	return mem_block->buffer + (idx << mem_block->info.blk_sz_shift);
+}
+
+ZTEST(lib_mem_block, test_mem_block_alloc_free_large)
+{
+	int ret;
+	void *ptr[3];
+	void *blocks[NUM_BLOCKS_LARGE];
+
+	/* Contiguous runs are allocated first fit, across bitmap words */
+	ret = sys_mem_blocks_alloc_contiguous(&mem_block_03, 20, &ptr[0]);
+	zassert_equal(ret, 0, "sys_mem_blocks_alloc_contiguous failed (%d)", ret);
+	zassert_equal(ptr[0], block_at(&mem_block_03, 0), "wrong block");
+
+	ret = sys_mem_blocks_alloc_contiguous(&mem_block_03, 20, &ptr[1]);
+	zassert_equal(ret, 0, "sys_mem_blocks_alloc_contiguous failed (%d)", ret);
+	zassert_equal(ptr[1], block_at(&mem_block_03, 20), "wrong block");
+
+	ret = sys_mem_blocks_alloc_contiguous(&mem_block_03, 50, &ptr[2]);
+	zassert_equal(ret, 0, "sys_mem_blocks_alloc_contiguous failed (%d)", ret);
+	zassert_equal(ptr[2], block_at(&mem_block_03, 40), "wrong block");
+
+	ret = sys_mem_blocks_alloc_contiguous(&mem_block_03, 11, &blocks[0]);
+	zassert_equal(ret, -ENOMEM,
+		      "sys_mem_blocks_alloc_contiguous should fail with -ENOMEM but not");
+
+	/* Scattered blocks fill the remaining holes in address order */
+	ret = sys_mem_blocks_free_contiguous(&mem_block_03, ptr[1], 20);
+	zassert_equal(ret, 0, "sys_mem_blocks_free_contiguous failed (%d)", ret);
+
+	ret = sys_mem_blocks_alloc(&mem_block_03, 31, blocks);
+	zassert_equal(ret, -ENOMEM,
+		      "sys_mem_blocks_alloc should fail with -ENOMEM but not");
+	zassert_true(sys_mem_blocks_is_region_free(&mem_block_03, ptr[1], 20),
+		     "failed allocation leaked blocks");
+
+	ret = sys_mem_blocks_alloc(&mem_block_03, 30, blocks);
+	zassert_equal(ret, 0, "sys_mem_blocks_alloc failed (%d)", ret);
+
+	for (int i = 0; i < 30; i++) {
+		size_t idx = (i < 20) ? 20 + i : 90 + (i - 20);
+
+		zassert_equal(blocks[i], block_at(&mem_block_03, idx),
+			      "wrong block %d", i);
+	}
+
+	ret = sys_mem_blocks_free(&mem_block_03, 30, blocks);
+	zassert_equal(ret, 0, "sys_mem_blocks_free failed (%d)", ret);
+
+	ret = sys_mem_blocks_free_contiguous(&mem_block_03, ptr[0], 20);
+	zassert_equal(ret, 0, "sys_mem_blocks_free_contiguous failed (%d)", ret);
+
+	ret = sys_mem_blocks_free_contiguous(&mem_block_03, ptr[2], 50);
+	zassert_equal(ret, 0, "sys_mem_blocks_free_contiguous failed (%d)", ret);
+
+	ret = sys_mem_blocks_free_contiguous(&mem_block_03, ptr[2], 50);
+	zassert_equal(ret, -EFAULT,
+		      "sys_mem_blocks_free_contiguous should fail with -EFAULT but not");
+
+	zassert_true(sys_mem_blocks_is_region_free(&mem_block_03,
+						   block_at(&mem_block_03, 0),
+						   NUM_BLOCKS_LARGE),
+		     "blocks left allocated");
+}
+
 ZTEST(lib_mem_block, test_mem_block_invalid_params_panic_1)
 {
 	void *blocks[2] = {0};
@@ -2452,6 +2452,57 @@ ZTEST(net_socket_tcp, test_so_keepalive_opt)
 	test_context_cleanup();
 }
 
+static void check_tcp_congestion(int sock, const char *expected)
+{
+	char name[16];
+	net_socklen_t optlen = sizeof(name);
+	int ret;
+
+	ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, expected, "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(expected) + 1, "getsockopt got invalid size");
+}
+
+ZTEST(net_socket_tcp, test_tcp_congestion_opt)
+{
+	static const char * const names[] = { "cubic", "bbr", "newreno" };
+	struct net_sockaddr_in bind_addr4;
+	char name[16];
+	net_socklen_t optlen;
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	check_tcp_congestion(sock, CONFIG_NET_TCP_CC_DEFAULT);
+
+	/* The name is accepted with and without the terminating NUL */
+	for (int i = 0; i < ARRAY_SIZE(names); i++) {
+		ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+				       names[i], strlen(names[i]) + (i % 2));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		check_tcp_congestion(sock, names[i]);
+	}
+
+	ret = zsock_setsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION,
+			       "vegas", strlen("vegas"));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt set invalid errno (%d)", errno);
+	check_tcp_congestion(sock, "newreno");
+
+	/* A short buffer gets a truncated name */
+	optlen = 4;
+	ret = zsock_getsockopt(sock, NET_IPPROTO_TCP, ZSOCK_TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, "new", "getsockopt got invalid value");
+	zassert_equal(optlen, 4, "getsockopt got invalid size");
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 static void test_prepare_keepalive_socks(int *c_sock, int *s_sock, int *new_sock)
 {
 	struct net_sockaddr_in c_saddr, s_saddr;
@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include <zephyr/tc_util.h>
 
 #include <zephyr/misc/lorem_ipsum.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/dummy.h>
 #include <zephyr/net/net_pkt.h>
@@ -116,6 +117,7 @@ static enum test_case_no {
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
 	TEST_SERVER_FIN_ACK_AFTER_DATA = 21,
+	TEST_RAW_PEER = 22,
 } test_case_no;
 
 static enum test_state t_state;
@@ -143,6 +145,9 @@ static void handle_client_fin_ack_with_data_test(net_sa_family_t af, struct tcph
 static void handle_client_seq_validation_test(net_sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
 static void handle_server_fin_ack_after_data_test(net_sa_family_t af, struct tcphdr *th);
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+static void handle_raw_peer(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -238,6 +243,10 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options carried by all the segments of the peer in TEST_RAW_PEER */
+static uint8_t peer_opts[40];
+static uint8_t peer_opts_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -248,11 +257,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == TEST_RAW_PEER) {
+		opts = peer_opts;
+		opts_len = peer_opts_len;
 	}
 
 	/* Allocate buffer */
@@ -287,11 +301,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = net_htons(NET_IPV6_MTU);
@@ -306,9 +316,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(net_sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0U) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -496,6 +506,11 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_FIN_ACK_AFTER_DATA:
 		handle_server_fin_ack_after_data_test(net_pkt_family(pkt), &th);
 		break;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+	case TEST_RAW_PEER:
+		handle_raw_peer(pkt, &th);
+		break;
+#endif
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -3207,4 +3222,760 @@ ZTEST(net_tcp, test_server_fin_ack_after_data)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
-ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
+#if defined(CONFIG_NET_TCP_TIMESTAMPS) || defined(CONFIG_NET_TCP_SACK)
+/* In TEST_RAW_PEER, the test case itself plays the peer: the segments sent
+ * by the stack are queued for the test case to check them, and the replies
+ * carry the options put in peer_opts.
+ */
+#define RAW_PKT_COUNT 8
+#define RAW_PEER_MSS 100U
+#define RAW_PEER_TSVAL 1000U
+
+struct raw_pkt {
+	struct tcphdr th;
+	uint8_t opts[40];
+	uint8_t opts_len;
+	uint16_t data_len;
+};
+
+static struct raw_pkt raw_pkts[RAW_PKT_COUNT];
+static unsigned int raw_pkts_in;
+static unsigned int raw_pkts_out;
+static K_SEM_DEFINE(raw_pkt_sem, 0, RAW_PKT_COUNT);
+
+/* Port of the connection on the side of the stack */
+static uint16_t raw_port;
+static uint32_t peer_tsval;
+
+static void handle_raw_peer(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t tcp_len = th->th_off * 4U;
+	struct raw_pkt *raw;
+
+	if (k_sem_count_get(&raw_pkt_sem) == RAW_PKT_COUNT) {
+		zassert_true(false, "Too many segments left unchecked");
+		return;
+	}
+
+	raw = &raw_pkts[raw_pkts_in++ % RAW_PKT_COUNT];
+	raw->th = *th;
+	raw->opts_len = tcp_len - sizeof(struct tcphdr);
+	raw->data_len = net_pkt_get_len(pkt) - ip_len - tcp_len;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len + sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, raw->opts, raw->opts_len) < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	k_sem_give(&raw_pkt_sem);
+}
+
+static void raw_reset(void)
+{
+	k_sem_reset(&raw_pkt_sem);
+	raw_pkts_in = 0U;
+	raw_pkts_out = 0U;
+}
+
+/* Wait for the next segment sent by the stack */
+static struct raw_pkt *raw_expect(int line)
+{
+	if (k_sem_take(&raw_pkt_sem, K_MSEC(200)) != 0) {
+		zassert_true(false, "No segment sent (line %d)", line);
+	}
+
+	return &raw_pkts[raw_pkts_out++ % RAW_PKT_COUNT];
+}
+
+static void raw_expect_none(k_timeout_t timeout, int line)
+{
+	if (k_sem_take(&raw_pkt_sem, timeout) == 0) {
+		zassert_true(false, "Unexpected segment sent (line %d)", line);
+	}
+}
+
+static const uint8_t *raw_opt_find(struct raw_pkt *raw, uint8_t kind)
+{
+	uint8_t i = 0U;
+
+	while (i < raw->opts_len && raw->opts[i] != NET_TCP_END_OPT) {
+		if (raw->opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1U >= raw->opts_len || raw->opts[i + 1U] < 2U) {
+			break;
+		}
+
+		if (raw->opts[i] == kind) {
+			return &raw->opts[i];
+		}
+
+		i += raw->opts[i + 1U];
+	}
+
+	return NULL;
+}
+
+static bool raw_ts_get(struct raw_pkt *raw, uint32_t *tsval, uint32_t *tsecr)
+{
+	const uint8_t *opt = raw_opt_find(raw, NET_TCP_TIMESTAMP_OPT);
+
+	if (opt == NULL || opt[1] != NET_TCP_TIMESTAMP_SIZE) {
+		return false;
+	}
+
+	*tsval = sys_get_be32(&opt[2]);
+	*tsecr = sys_get_be32(&opt[6]);
+
+	return true;
+}
+
+static void peer_opts_clear(void)
+{
+	peer_opts_len = 0U;
+}
+
+static void peer_opt_add(const uint8_t *opt, size_t len)
+{
+	zassert_true(peer_opts_len + len <= sizeof(peer_opts), "Too many options");
+
+	memcpy(&peer_opts[peer_opts_len], opt, len);
+	peer_opts_len += len;
+}
+
+static void peer_opt_ts(uint32_t tsval, uint32_t tsecr)
+{
+	uint8_t opt[NET_TCP_TIMESTAMP_OPTS_SIZE] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_TIMESTAMP_OPT, NET_TCP_TIMESTAMP_SIZE,
+	};
+
+	sys_put_be32(tsval, &opt[4]);
+	sys_put_be32(tsecr, &opt[8]);
+	peer_opt_add(opt, sizeof(opt));
+}
+
+/* Send a segment of the peer to the stack, with the options in peer_opts */
+static void raw_send(uint8_t flags, const uint8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tester_prepare_tcp_pkt(NET_AF_INET, net_htons(PEER_PORT), raw_port,
+				     flags, data, len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	seq += len;
+}
+
+/* Options of a SYN of the peer, tsecr is only sent in a SYN ACK */
+static void peer_opts_syn(bool ts, bool sack_perm, uint32_t tsecr)
+{
+	static const uint8_t mss_opt[] = {
+		NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, 0U, RAW_PEER_MSS
+	};
+	static const uint8_t sack_perm_opt[] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE
+	};
+
+	peer_opts_clear();
+	peer_opt_add(mss_opt, sizeof(mss_opt));
+	if (sack_perm) {
+		peer_opt_add(sack_perm_opt, sizeof(sack_perm_opt));
+	}
+	if (ts) {
+		peer_tsval = RAW_PEER_TSVAL;
+		peer_opt_ts(peer_tsval, tsecr);
+	}
+}
+
+/* Connect to the peer played by the test case, which answers after
+ * delay_ms with a SYN ACK carrying the timestamps and the SACK-permitted
+ * options if requested. The SYN and the final ACK of the stack are
+ * returned in syn and syn_ack_ack.
+ */
+static struct net_context *raw_connect(bool ts, bool sack_perm, uint32_t delay_ms,
+				       struct raw_pkt *syn, struct raw_pkt *syn_ack_ack)
+{
+	struct net_context *ctx;
+	uint32_t tsval, tsecr;
+	int ret;
+
+	test_case_no = TEST_RAW_PEER;
+	raw_reset();
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, &ctx);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct net_sockaddr *)&peer_addr_s,
+				  sizeof(struct net_sockaddr_in), NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, -EINPROGRESS, "Failed to connect to peer (%d)", ret);
+
+	*syn = *raw_expect(__LINE__);
+	test_verify_flags(&syn->th, SYN);
+
+	k_msleep(delay_ms);
+
+	raw_port = syn->th.th_sport;
+	seq = 0U;
+	ack = net_ntohl(syn->th.th_seq) + 1U;
+
+	peer_opts_syn(ts, sack_perm, raw_ts_get(syn, &tsval, &tsecr) ? tsval : 0U);
+	raw_send(SYN | ACK, NULL, 0U);
+	seq++;
+
+	*syn_ack_ack = *raw_expect(__LINE__);
+	test_verify_flags(&syn_ack_ack->th, ACK);
+
+	peer_opts_clear();
+
+	return ctx;
+}
+
+/* Accept a connection from the peer played by the test case, which sends
+ * a SYN carrying the timestamps and the SACK-permitted options if
+ * requested. The SYN ACK of the stack is returned in syn_ack and the
+ * listening context in listener.
+ */
+static struct net_context *raw_accept(bool ts, bool sack_perm, struct raw_pkt *syn_ack,
+				      struct net_context **listener)
+{
+	uint32_t tsval, tsecr;
+	int ret;
+
+	test_case_no = TEST_RAW_PEER;
+	raw_reset();
+	k_sem_reset(&test_sem);
+
+	ret = net_context_get(NET_AF_INET, NET_SOCK_STREAM, NET_IPPROTO_TCP, listener);
+	zassert_ok(ret, "Failed to get net_context");
+
+	net_context_ref(*listener);
+
+	ret = net_context_bind(*listener, (struct net_sockaddr *)&my_addr_s,
+			       sizeof(struct net_sockaddr_in));
+	zassert_ok(ret, "Failed to bind net_context");
+
+	ret = net_context_listen(*listener, 1);
+	zassert_ok(ret, "Failed to listen on net_context");
+
+	ret = net_context_accept(*listener, test_tcp_accept_cb, K_NO_WAIT, NULL);
+	zassert_ok(ret, "Failed to set accept on net_context");
+
+	raw_port = my_addr_s.sin_port;
+	seq = 0U;
+	ack = 0U;
+
+	peer_opts_syn(ts, sack_perm, 0U);
+	raw_send(SYN, NULL, 0U);
+	seq++;
+
+	*syn_ack = *raw_expect(__LINE__);
+	test_verify_flags(&syn_ack->th, SYN | ACK);
+
+	ack = net_ntohl(syn_ack->th.th_seq) + 1U;
+
+	peer_opts_clear();
+	if (ts && raw_ts_get(syn_ack, &tsval, &tsecr)) {
+		peer_opt_ts(++peer_tsval, tsval);
+	}
+
+	raw_send(ACK, NULL, 0U);
+
+	/* test_tcp_accept_cb will release the semaphore after successful
+	 * connection.
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	peer_opts_clear();
+
+	return accepted_ctx;
+}
+
+/* Abort a connection to the peer played by the test case */
+static void raw_close(struct net_context *ctx)
+{
+	peer_opts_clear();
+	raw_send(RST, NULL, 0U);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+
+	/* Let other threads run (so the TCP context is actually freed) */
+	k_msleep(10);
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS || CONFIG_NET_TCP_SACK */
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+#define TS_TEST_RTT_MS 30
+#define TS_TEST_RTT_ROUNDS 16
+
+/* Test case scenario
+ *   expect SYN with the timestamps option and a zero TSecr,
+ *   send SYN ACK with the option echoing the TSval of the SYN,
+ *   expect ACK echoing the TSval of the SYN ACK.
+ *   Then again without the option in the SYN ACK,
+ *   expect ACK without the option.
+ */
+ZTEST(net_tcp_options, test_ts_negotiation_client)
+{
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+	uint32_t tsval, tsecr;
+
+	ctx = raw_connect(true, false, 0U, &syn, &syn_ack_ack);
+
+	zassert_true(raw_ts_get(&syn, &tsval, &tsecr), "No timestamps option in SYN");
+	zassert_equal(tsecr, 0U, "TSecr set in SYN");
+	zassert_true(raw_ts_get(&syn_ack_ack, &tsval, &tsecr),
+		     "No timestamps option in ACK");
+	zassert_equal(tsecr, RAW_PEER_TSVAL, "TSval of SYN ACK not echoed");
+	zassert_true(((struct tcp *)ctx->tcp)->ts_ok, "Timestamps not negotiated");
+
+	raw_close(ctx);
+
+	ctx = raw_connect(false, false, 0U, &syn, &syn_ack_ack);
+
+	zassert_true(raw_ts_get(&syn, &tsval, &tsecr), "No timestamps option in SYN");
+	zassert_false(raw_ts_get(&syn_ack_ack, &tsval, &tsecr),
+		      "Timestamps option sent without negotiation");
+	zassert_false(((struct tcp *)ctx->tcp)->ts_ok, "Timestamps negotiated");
+
+	raw_close(ctx);
+}
+
+/* Test case scenario
+ *   send SYN with the timestamps option,
+ *   expect SYN ACK with the option echoing the TSval of the SYN,
+ *   send ACK, connection is accepted with timestamps enabled.
+ *   Then again without the option in the SYN,
+ *   expect SYN ACK without the option.
+ */
+ZTEST(net_tcp_options, test_ts_negotiation_server)
+{
+	struct net_context *ctx, *listener;
+	struct raw_pkt syn_ack;
+	uint32_t tsval, tsecr;
+
+	ctx = raw_accept(true, false, &syn_ack, &listener);
+
+	zassert_true(raw_ts_get(&syn_ack, &tsval, &tsecr), "No timestamps option in SYN ACK");
+	zassert_equal(tsecr, RAW_PEER_TSVAL, "TSval of SYN not echoed");
+	zassert_true(((struct tcp *)ctx->tcp)->ts_ok, "Timestamps not negotiated");
+
+	raw_close(ctx);
+	net_context_put(listener);
+
+	ctx = raw_accept(false, false, &syn_ack, &listener);
+
+	zassert_false(raw_ts_get(&syn_ack, &tsval, &tsecr),
+		      "Timestamps option sent without negotiation");
+	zassert_false(((struct tcp *)ctx->tcp)->ts_ok, "Timestamps negotiated");
+
+	raw_close(ctx);
+	net_context_put(listener);
+}
+
+/* Test case scenario
+ *   connect with timestamps,
+ *   send data with a TSval older than the one of the SYN ACK,
+ *   expect ACK not acknowledging the data (PAWS drop),
+ *   send RST with the same old TSval, it is not dropped by PAWS.
+ */
+ZTEST(net_tcp_options, test_ts_paws)
+{
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+	struct raw_pkt *raw;
+	struct tcp *conn;
+	uint32_t tsval, tsecr;
+	uint32_t rcv_nxt;
+	uint8_t data = 0x41; /* "A" */
+	int paws_drop;
+
+	ctx = raw_connect(true, false, 0U, &syn, &syn_ack_ack);
+	conn = ctx->tcp;
+	rcv_nxt = conn->ack;
+	zassert_true(raw_ts_get(&syn_ack_ack, &tsval, &tsecr),
+		     "No timestamps option in ACK");
+
+	paws_drop = GET_STAT(net_iface, tcp.paws_drop);
+
+	peer_opt_ts(RAW_PEER_TSVAL - 10U, tsval);
+	raw_send(PSH | ACK, &data, 1U);
+
+	raw = raw_expect(__LINE__);
+	test_verify_flags(&raw->th, ACK);
+	zassert_equal(net_ntohl(raw->th.th_ack), rcv_nxt, "Old duplicate acknowledged");
+	zassert_equal(conn->ack, rcv_nxt, "Old duplicate accepted");
+	zassert_equal(GET_STAT(net_iface, tcp.paws_drop), paws_drop + 1,
+		      "Old duplicate not dropped by PAWS");
+
+	/* The dropped segment is not in sequence space */
+	seq--;
+
+	peer_opts_clear();
+	peer_opt_ts(RAW_PEER_TSVAL - 10U, tsval);
+	raw_send(RST, NULL, 0U);
+
+	raw_expect_none(K_MSEC(50), __LINE__);
+	zassert_equal(GET_STAT(net_iface, tcp.paws_drop), paws_drop + 1,
+		      "RST dropped by PAWS");
+
+	net_context_put(ctx);
+
+	/* Let other threads run (so the TCP context is actually freed) */
+	k_msleep(10);
+}
+
+/* Test case scenario
+ *   connect with timestamps, the SYN ACK being sent after TS_TEST_RTT_MS,
+ *   repeatedly send data and acknowledge it after TS_TEST_RTT_MS,
+ *   echoing its TSval,
+ *   expect the smoothed RTT and the RTO to settle near TS_TEST_RTT_MS.
+ */
+ZTEST(net_tcp_options, test_ts_rto)
+{
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+	struct raw_pkt *raw;
+	struct tcp *conn;
+	uint32_t tsval, tsecr;
+	uint8_t data = 0x41; /* "A" */
+	int ret;
+
+	ctx = raw_connect(true, false, TS_TEST_RTT_MS, &syn, &syn_ack_ack);
+	conn = ctx->tcp;
+
+	for (int i = 0; i < TS_TEST_RTT_ROUNDS; i++) {
+		raw_reset();
+
+		ret = net_context_send(ctx, &data, 1, NULL, K_NO_WAIT, NULL);
+		zassert_equal(ret, 1, "Failed to send data to peer (%d)", ret);
+
+		raw = raw_expect(__LINE__);
+		test_verify_flags(&raw->th, PSH | ACK);
+		zassert_true(raw_ts_get(raw, &tsval, &tsecr), "No timestamps option in data");
+
+		k_msleep(TS_TEST_RTT_MS);
+
+		/* Drop any retransmission made meanwhile, the RTT sample
+		 * comes from the echoed TSval of the first transmission.
+		 */
+		raw_reset();
+
+		ack++;
+		peer_opts_clear();
+		peer_opt_ts(++peer_tsval, tsval);
+		raw_send(ACK, NULL, 0U);
+
+		/* Let the receiving thread run */
+		k_msleep(10);
+	}
+
+	zassert_between_inclusive(conn->srtt >> 3, TS_TEST_RTT_MS, 2 * TS_TEST_RTT_MS,
+				  "Smoothed RTT %u ms not settled", conn->srtt >> 3);
+	zassert_between_inclusive(conn->rto, TS_TEST_RTT_MS, 3 * TS_TEST_RTT_MS,
+				  "RTO %u ms not settled", conn->rto);
+
+	raw_close(ctx);
+}
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
+#if defined(CONFIG_NET_TCP_SACK)
+#define SACK_TEST_RTT_MS 60
+
+static void peer_opt_sack(const uint32_t *edges, uint8_t count)
+{
+	uint8_t opt[2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_OPT,
+		2U + count / 2U * NET_TCP_SACK_BLOCK_SIZE,
+	};
+
+	for (uint8_t i = 0U; i < count; i++) {
+		sys_put_be32(edges[i], &opt[4 + i * sizeof(uint32_t)]);
+	}
+
+	peer_opt_add(opt, 4U + count * sizeof(uint32_t));
+}
+
+/* Send len bytes of data over the connection to the peer played by the test
+ * case, which acknowledges them all at once.
+ */
+static void raw_send_acked(struct net_context *ctx, size_t len)
+{
+	size_t sent = 0U;
+	int ret;
+
+	ret = net_context_send(ctx, lorem_ipsum, len, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, len, "Failed to send data to peer (%d)", ret);
+
+	while (sent < len) {
+		struct raw_pkt *raw = raw_expect(__LINE__);
+
+		zassert_equal(net_ntohl(raw->th.th_seq), ack + sent, "Unexpected segment");
+		sent += raw->data_len;
+	}
+
+	ack += len;
+	raw_send(ACK, NULL, 0U);
+
+	/* Let the receiving thread run */
+	k_msleep(10);
+}
+
+/* Test case scenario
+ *   expect SYN with the SACK-permitted option,
+ *   send SYN ACK with the option,
+ *   expect ACK without the option, SACK is enabled.
+ *   Then again without the option in the SYN ACK, SACK is disabled.
+ */
+ZTEST(net_tcp_options, test_sack_negotiation_client)
+{
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+
+	ctx = raw_connect(false, true, 0U, &syn, &syn_ack_ack);
+
+	zassert_not_null(raw_opt_find(&syn, NET_TCP_SACK_PERM_OPT),
+			 "No SACK-permitted option in SYN");
+	zassert_is_null(raw_opt_find(&syn_ack_ack, NET_TCP_SACK_PERM_OPT),
+			"SACK-permitted option in ACK");
+	zassert_true(((struct tcp *)ctx->tcp)->sack_ok, "SACK not negotiated");
+
+	raw_close(ctx);
+
+	ctx = raw_connect(false, false, 0U, &syn, &syn_ack_ack);
+
+	zassert_not_null(raw_opt_find(&syn, NET_TCP_SACK_PERM_OPT),
+			 "No SACK-permitted option in SYN");
+	zassert_false(((struct tcp *)ctx->tcp)->sack_ok, "SACK negotiated");
+
+	raw_close(ctx);
+}
+
+/* Test case scenario
+ *   send SYN with the SACK-permitted option,
+ *   expect SYN ACK with the option,
+ *   send ACK, connection is accepted with SACK enabled.
+ *   Then again without the option in the SYN,
+ *   expect SYN ACK without the option.
+ */
+ZTEST(net_tcp_options, test_sack_negotiation_server)
+{
+	struct net_context *ctx, *listener;
+	struct raw_pkt syn_ack;
+
+	ctx = raw_accept(false, true, &syn_ack, &listener);
+
+	zassert_not_null(raw_opt_find(&syn_ack, NET_TCP_SACK_PERM_OPT),
+			 "No SACK-permitted option in SYN ACK");
+	zassert_true(((struct tcp *)ctx->tcp)->sack_ok, "SACK not negotiated");
+
+	raw_close(ctx);
+	net_context_put(listener);
+
+	ctx = raw_accept(false, false, &syn_ack, &listener);
+
+	zassert_is_null(raw_opt_find(&syn_ack, NET_TCP_SACK_PERM_OPT),
+			"SACK-permitted option sent without negotiation");
+	zassert_false(((struct tcp *)ctx->tcp)->sack_ok, "SACK negotiated");
+
+	raw_close(ctx);
+	net_context_put(listener);
+}
+
+/* Test case scenario
+ *   send ACK with the longest SACK option, it is accepted,
+ *   send ACK with a SACK option holding half a block, expect RST,
+ *   send ACK with a SACK option longer than the option space, expect RST.
+ */
+ZTEST(net_tcp_options, test_sack_parse)
+{
+	static const uint8_t half_block[] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_OPT, 6U,
+		0U, 0U, 0U, 0U,
+	};
+	static const uint8_t over_long[] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT, NET_TCP_SACK_OPT,
+		2U + NET_TCP_SACK_MAX_BLOCKS * NET_TCP_SACK_BLOCK_SIZE,
+		0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U,
+	};
+	uint32_t edges[2 * NET_TCP_SACK_MAX_BLOCKS];
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+	struct raw_pkt *raw;
+
+	ctx = raw_connect(false, true, 0U, &syn, &syn_ack_ack);
+
+	for (size_t i = 0; i < ARRAY_SIZE(edges); i++) {
+		edges[i] = ack + 100U * i;
+	}
+
+	peer_opt_sack(edges, ARRAY_SIZE(edges));
+	raw_send(ACK, NULL, 0U);
+
+	raw_expect_none(K_MSEC(50), __LINE__);
+	zassert_equal(((struct tcp *)ctx->tcp)->state, TCP_ESTABLISHED,
+		      "Valid SACK option rejected");
+
+	peer_opts_clear();
+	peer_opt_add(half_block, sizeof(half_block));
+	raw_send(ACK, NULL, 0U);
+
+	raw = raw_expect(__LINE__);
+	test_verify_flags(&raw->th, RST);
+
+	net_context_put(ctx);
+	k_msleep(10);
+
+	ctx = raw_connect(false, true, 0U, &syn, &syn_ack_ack);
+
+	peer_opt_add(over_long, sizeof(over_long));
+	raw_send(ACK, NULL, 0U);
+
+	raw = raw_expect(__LINE__);
+	test_verify_flags(&raw->th, RST);
+
+	net_context_put(ctx);
+	k_msleep(10);
+}
+
+/* Test case scenario
+ *   send data beyond a hole,
+ *   expect ACK with a SACK block reporting the queued data,
+ *   send the missing data,
+ *   expect ACK for all the data without SACK block.
+ */
+ZTEST(net_tcp_options, test_sack_ooo_block)
+{
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+	struct raw_pkt *raw;
+	const uint8_t *opt;
+	uint32_t rcv_nxt;
+
+	ctx = raw_connect(false, true, 0U, &syn, &syn_ack_ack);
+	rcv_nxt = seq;
+
+	seq += 10U;
+	raw_send(PSH | ACK, lorem_ipsum + 10, 10U);
+
+	raw = raw_expect(__LINE__);
+	test_verify_flags(&raw->th, ACK);
+	zassert_equal(net_ntohl(raw->th.th_ack), rcv_nxt, "Data beyond hole acknowledged");
+
+	opt = raw_opt_find(raw, NET_TCP_SACK_OPT);
+	zassert_not_null(opt, "No SACK option in ACK");
+	zassert_equal(opt[1], 2U + NET_TCP_SACK_BLOCK_SIZE, "Not one SACK block");
+	zassert_equal(sys_get_be32(&opt[2]), rcv_nxt + 10U, "Wrong left edge");
+	zassert_equal(sys_get_be32(&opt[6]), rcv_nxt + 20U, "Wrong right edge");
+
+	seq = rcv_nxt;
+	raw_send(PSH | ACK, lorem_ipsum, 10U);
+
+	raw = raw_expect(__LINE__);
+	test_verify_flags(&raw->th, ACK);
+	zassert_equal(net_ntohl(raw->th.th_ack), rcv_nxt + 20U, "Hole not filled");
+	zassert_is_null(raw_opt_find(raw, NET_TCP_SACK_OPT), "SACK option without hole");
+
+	seq = rcv_nxt + 20U;
+	raw_close(ctx);
+}
+
+/* Test case scenario
+ *   grow the congestion window to three segments,
+ *   send three segments,
+ *   send ACK for the segments before the first one with a SACK block
+ *   covering the last two,
+ *   expect the first segment to be retransmitted before the RTO.
+ */
+ZTEST(net_tcp_options, test_sack_retransmit)
+{
+	struct net_context *ctx;
+	struct raw_pkt syn, syn_ack_ack;
+	struct raw_pkt *raw;
+	struct tcp *conn;
+	uint32_t edges[2];
+	uint32_t start, snd_una;
+	int rto_expired;
+	int ret;
+
+	/* The handshake RTT keeps the RTO well above the loss detection */
+	ctx = raw_connect(false, true, SACK_TEST_RTT_MS, &syn, &syn_ack_ack);
+	conn = ctx->tcp;
+
+	raw_send_acked(ctx, RAW_PEER_MSS);
+	raw_send_acked(ctx, 2 * RAW_PEER_MSS);
+
+	raw_reset();
+	snd_una = ack;
+	rto_expired = GET_STAT(net_iface, tcp.rto_expired);
+
+	ret = net_context_send(ctx, lorem_ipsum, 3 * RAW_PEER_MSS, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, 3 * RAW_PEER_MSS, "Failed to send data to peer (%d)", ret);
+
+	for (int i = 0; i < 3; i++) {
+		raw = raw_expect(__LINE__);
+		zassert_equal(net_ntohl(raw->th.th_seq), snd_una + i * RAW_PEER_MSS,
+			      "Unexpected segment");
+	}
+
+	edges[0] = snd_una + RAW_PEER_MSS;
+	edges[1] = snd_una + 3 * RAW_PEER_MSS;
+	peer_opt_sack(edges, ARRAY_SIZE(edges));
+
+	start = k_uptime_get_32();
+	raw_send(ACK, NULL, 0U);
+
+	/* Skip the loss probe resending the last segment if any */
+	do {
+		raw = raw_expect(__LINE__);
+	} while (net_ntohl(raw->th.th_seq) != snd_una);
+
+	zassert_equal(raw->data_len, RAW_PEER_MSS, "Wrong retransmission length");
+	zassert_true(k_uptime_get_32() - start < conn->rto, "Retransmission not before RTO");
+	zassert_equal(GET_STAT(net_iface, tcp.rto_expired), rto_expired,
+		      "Retransmission by RTO");
+
+	ack = snd_una + 3 * RAW_PEER_MSS;
+	peer_opts_clear();
+	raw_send(ACK, NULL, 0U);
+
+	raw_close(ctx);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+static bool net_tcp_predicate(const void *global_state)
+{
+	ARG_UNUSED(global_state);
+
+	/* The options change the segments the state machines above expect */
+	return !IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && !IS_ENABLED(CONFIG_NET_TCP_SACK);
+}
+
+static bool net_tcp_options_predicate(const void *global_state)
+{
+	ARG_UNUSED(global_state);
+
+	return !net_tcp_predicate(global_state);
+}
+
+ZTEST_SUITE(net_tcp, net_tcp_predicate, presetup, NULL, NULL, NULL);
+ZTEST_SUITE(net_tcp_options, net_tcp_options_predicate, presetup, NULL, NULL, NULL);